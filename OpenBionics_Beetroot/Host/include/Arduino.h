@@ -0,0 +1,207 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	Arduino.h (host stand-in)
+*
+*/
+
+// Minimal stand-in for the Arduino SAMD core, so that the Beetroot modules can be compiled and run on a
+// Linux host. All timing is driven by the virtual clock in HostClock.h, which only advances when the
+// firmware waits (delay(), delayMicroseconds(), __WFI()) or when the host runner charges a loop cost.
+
+#ifndef HOST_ARDUINO_H_
+#define HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+
+#ifndef ARDUINO
+#define ARDUINO				10801
+#endif
+#define F_CPU				48000000L
+
+///////////////////////////////////// TYPES ///////////////////////////////////////
+typedef uint8_t byte;
+typedef bool boolean;
+
+///////////////////////////////////// CONSTANTS ///////////////////////////////////////
+#define HIGH				0x1
+#define LOW					0x0
+
+#define INPUT				0x0
+#define OUTPUT				0x1
+#define INPUT_PULLUP		0x2
+
+#define DEC					10
+#define HEX					16
+#define OCT					8
+#define BIN					2
+
+#ifndef PI
+#define PI					3.1415926535897932384626433832795
+#endif
+
+#define SERIAL_BUFFER_SIZE	64		// SAMD core RX buffer size, used by I2C_EEPROM chunking
+
+// analogue pins (Chestnut variant numbering)
+#define A0					14
+#define A1					15
+#define A2					16
+#define A3					17
+#define A4					18
+#define A5					19
+#define A6					20
+#define A7					21
+#define A8					22
+#define A9					23
+#define A10					24
+#define A11					25
+#define NUM_HOST_PINS		32
+
+///////////////////////////////////// MACROS ///////////////////////////////////////
+#define constrain(amt,low,high)	((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+#define PROGMEM
+#define PSTR(s)					(s)
+#define pgm_read_byte(addr)		(*(const uint8_t *)(addr))
+#define pgm_read_word(addr)		(*(const uint16_t *)(addr))
+
+///////////////////////////////////// CORTEX-M0+ INTRINSICS ///////////////////////////////////////
+void __WFI(void);					// sleep until the next interrupt (advances the virtual clock to the next 1ms tick)
+inline void __DSB(void) {}
+inline void __ISB(void) {}
+inline void __DMB(void) {}
+
+///////////////////////////////////// TIME ///////////////////////////////////////
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+///////////////////////////////////// INTERRUPTS ///////////////////////////////////////
+void noInterrupts(void);
+void interrupts(void);
+
+///////////////////////////////////// IO ///////////////////////////////////////
+void pinMode(uint32_t pin, uint32_t mode);
+void digitalWrite(uint32_t pin, uint32_t val);
+int digitalRead(uint32_t pin);
+int analogRead(uint32_t pin);
+void analogReadResolution(int res);
+void analogWrite(uint32_t pin, uint32_t val);
+
+///////////////////////////////////// MATHS ///////////////////////////////////////
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+///////////////////////////////////// CHARACTERS & STRINGS ///////////////////////////////////////
+inline bool isDigit(int c) { return (c >= '0') && (c <= '9'); }
+inline bool isAlpha(int c) { return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')); }
+char *itoa(int value, char *str, int base);
+char *utoa(unsigned int value, char *str, int base);
+
+
+///////////////////////////////////// PRINT ///////////////////////////////////////
+class Print
+{
+	public:
+		virtual ~Print() {}
+
+		virtual size_t write(uint8_t c) = 0;
+		virtual size_t write(const uint8_t *buffer, size_t size);
+		size_t write(const char *str) { return (str ? write((const uint8_t *)str, strlen(str)) : 0); }
+		size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+
+		size_t print(const char str[]);
+		size_t print(char c);
+		size_t print(unsigned char n, int base = DEC);
+		size_t print(int n, int base = DEC);
+		size_t print(unsigned int n, int base = DEC);
+		size_t print(long n, int base = DEC);
+		size_t print(unsigned long n, int base = DEC);
+		size_t print(long long n, int base = DEC);
+		size_t print(unsigned long long n, int base = DEC);
+		size_t print(double n, int digits = 2);
+
+		template <class T> size_t println(T val) { size_t n = print(val); return n + println(); }
+		template <class T> size_t println(T val, int mod) { size_t n = print(val, mod); return n + println(); }
+		size_t println(void) { return write('\n'); }
+
+	private:
+		size_t printNumber(unsigned long long n, uint8_t base);
+		size_t printFloat(double n, uint8_t digits);
+};
+
+
+///////////////////////////////////// SERIAL ///////////////////////////////////////
+// SerialUSB stand-in. Received bytes are injected by the host runner, transmitted bytes go to stdout
+class HostSerial : public Print
+{
+	public:
+		HostSerial();
+
+		void begin(unsigned long baud);
+		void end(void);
+
+		int available(void);
+		int peek(void);
+		int read(void);
+		int availableForWrite(void);
+		void flush(void);
+
+		using Print::write;
+		size_t write(uint8_t c);
+		size_t write(const uint8_t *buffer, size_t size);
+
+		bool dtr(void);
+		operator bool() { return _connected; }
+
+		// HOST ONLY
+		void inject(const char *str);						// queue a string to be received by the firmware
+		void inject(const uint8_t *buffer, size_t size);	// queue raw bytes to be received by the firmware
+		void setEcho(bool en);								// enable/disable copying transmitted bytes to stdout
+		void setConnected(bool en);							// emulate the host opening/closing the port (DTR)
+		void setTxCapacity(int size);						// bytes that can be sent per 1ms USB frame (< 0 = unlimited)
+		void setStall(uint64_t start, uint64_t end);		// emulate the PC not reading the port from start until end (us)
+		bool txReady(int len);								// returns true if 'len' bytes can be written without waiting
+		unsigned long long txCount(void);					// total number of bytes transmitted by the firmware
+		unsigned long long txDropped(void);					// total number of bytes dropped, as the PC was not reading
+
+	private:
+		static const int RX_BUFF_SIZE = 4096;
+
+		uint8_t _rxBuff[RX_BUFF_SIZE];
+		int _rxHead;
+		int _rxTail;
+
+		bool _echo;
+		bool _connected;
+		int _txCapacity;
+		int _txFrameCount;
+		uint64_t _txFrame;
+		unsigned long long _txCount;
+		uint64_t _stallStart;
+		uint64_t _stallEnd;
+		bool _txTimedOut;
+		unsigned long long _txDropped;
+
+		bool stalled(void);
+};
+
+extern HostSerial SerialUSB;
+
+#endif // HOST_ARDUINO_H_
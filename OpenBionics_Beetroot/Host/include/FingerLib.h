@@ -0,0 +1,264 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	FingerLib.h (host stand-in)
+*
+*/
+
+// Stand-in for the parts of FingerLib used by Beetroot. The timers and the circular buffer are header-only
+// and run from the virtual clock, the Finger class is a simple motion model (see HostFingerLib.cpp)
+
+#ifndef HOST_FINGERLIB_H_
+#define HOST_FINGERLIB_H_
+
+#include <Arduino.h>
+
+///////////////////////////////////// FINGER CONSTANTS ///////////////////////////////////////
+#define MIN_FINGER_POS		50
+#define MAX_FINGER_POS		973
+#define MAX_FINGER_PWM		255
+#define OFF_FINGER_PWM		0
+
+#define CLOSE				0
+#define OPEN				1
+
+#define RIGHT				1		// hand types
+#define LEFT				2
+
+///////////////////////////////////// TIMER INTERRUPT ///////////////////////////////////////
+void _attachFuncToTimer(void(*fn)(void));		// attach a function to be called from the 1ms timer interrupt
+
+
+///////////////////////////////////// MS_NB_DELAY ///////////////////////////////////////
+// non-blocking millisecond delay
+class MS_NB_DELAY
+{
+	public:
+		MS_NB_DELAY() : _startTime(0), _interval(0), _running(false) {}
+
+		void start(long interval)
+		{
+			_interval = interval;
+			_startTime = millis();
+			_running = true;
+		}
+
+		bool started(void)
+		{
+			return _running;
+		}
+
+		bool finished(void)
+		{
+			if (_running && ((long)(millis() - _startTime) >= _interval))
+			{
+				_running = false;
+				return true;
+			}
+			return false;
+		}
+
+		// start the timer if it is not running and return true (and restart) once the interval has elapsed
+		bool timeElapsed(long interval)
+		{
+			if (!_running)
+			{
+				start(interval);
+				return false;
+			}
+
+			_interval = interval;
+			if ((long)(millis() - _startTime) >= _interval)
+			{
+				_startTime = millis();
+				return true;
+			}
+			return false;
+		}
+
+		long stop(void)
+		{
+			long elapsed = now();
+			_running = false;
+			return elapsed;
+		}
+
+		long now(void)
+		{
+			return (_running ? (long)(millis() - _startTime) : 0);
+		}
+
+	private:
+		unsigned long _startTime;
+		long _interval;
+		bool _running;
+};
+
+
+///////////////////////////////////// MS_NB_TIMER ///////////////////////////////////////
+// non-blocking millisecond stopwatch
+class MS_NB_TIMER
+{
+	public:
+		MS_NB_TIMER() : _startTime(0), _running(false) {}
+
+		void start(void)
+		{
+			_startTime = millis();
+			_running = true;
+		}
+
+		long stop(void)
+		{
+			long elapsed = now();
+			_running = false;
+			return elapsed;
+		}
+
+		bool started(void)
+		{
+			return _running;
+		}
+
+		bool timeElapsed(long interval)
+		{
+			return (_running && ((long)(millis() - _startTime) >= interval));
+		}
+
+		long now(void)
+		{
+			return (_running ? (long)(millis() - _startTime) : 0);
+		}
+
+	private:
+		unsigned long _startTime;
+		bool _running;
+};
+
+
+///////////////////////////////////// CIRCLE_BUFFER ///////////////////////////////////////
+template <class T>
+class CIRCLE_BUFFER
+{
+	public:
+		CIRCLE_BUFFER() : _buff(NULL), _size(0), _head(0), _count(0) {}
+		~CIRCLE_BUFFER() { free(_buff); }
+
+		void begin(int size)
+		{
+			free(_buff);
+			_buff = (T*)calloc(size, sizeof(T));
+			_size = (_buff ? size : 0);
+			_head = 0;
+			_count = 0;
+		}
+
+		void write(T val)
+		{
+			if (!_size)
+				return;
+
+			_buff[_head] = val;
+			_head = (_head + 1) % _size;
+			if (_count < _size)
+				_count++;
+		}
+
+		// read the oldest value
+		T read(void)
+		{
+			if (!_count)
+				return T();
+			return _buff[(_head + _size - _count) % _size];
+		}
+
+		T readMean(void)
+		{
+			double sum = 0;
+			for (int i = 0; i < _count; i++)
+				sum += _buff[i];
+			return (_count ? (T)(sum / _count) : T());
+		}
+
+		T readMin(void)
+		{
+			T val = (_count ? _buff[0] : T());
+			for (int i = 1; i < _count; i++)
+				if (_buff[i] < val)
+					val = _buff[i];
+			return val;
+		}
+
+		T readMax(void)
+		{
+			T val = (_count ? _buff[0] : T());
+			for (int i = 1; i < _count; i++)
+				if (_buff[i] > val)
+					val = _buff[i];
+			return val;
+		}
+
+	private:
+		T *_buff;
+		int _size;
+		int _head;
+		int _count;
+};
+
+
+///////////////////////////////////// FINGER ///////////////////////////////////////
+class Finger
+{
+	public:
+		Finger();
+
+		uint8_t attach(uint8_t dir0, uint8_t dir1, uint8_t posSns, uint8_t forceSns, bool inv);
+		bool attached(void);
+
+		void writePos(int pos);
+		int readPos(void);
+		int readTargetPos(void);
+		int readPosError(void);
+
+		void writeDir(int dir);
+		int readDir(void);
+		void open(void);
+		void close(void);
+		void open_close(void);
+
+		void writeSpeed(int speed);
+		int readSpeed(void);
+		int readTargetPWM(void);
+
+		void writeForce(float force, int dir = CLOSE);
+		float readForce(void);
+		void forceSenseEnable(bool en);
+
+		void motorEnable(bool en);
+		bool motorEnabled(void);
+
+		// HOST ONLY
+		void hostStep(void);				// advance the motion model by 1ms
+
+	private:
+		bool _attached;
+		bool _inv;
+		bool _motorEn;
+		bool _forceSnsEn;
+
+		float _pos;
+		int _targetPos;
+		int _dir;
+		int _speed;
+		float _force;
+};
+
+#endif // HOST_FINGERLIB_H_
@@ -0,0 +1,60 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	Wire.h (host stand-in)
+*
+*/
+
+// Stand-in for the Arduino Wire library. Transactions are routed by address to the device models in
+// HostWire.cpp (24AA08 EEPROM, LSM9DS1 IMU and the HANDle Nunchuck)
+
+#ifndef HOST_WIRE_H_
+#define HOST_WIRE_H_
+
+#include <Arduino.h>
+
+#define WIRE_BUFFER_SIZE	SERIAL_BUFFER_SIZE
+
+class TwoWire
+{
+	public:
+		TwoWire();
+
+		void begin(void);
+		void end(void);
+		void setClock(uint32_t freq);
+
+		void beginTransmission(uint8_t addr);
+		uint8_t endTransmission(bool stopBit = true);
+
+		uint8_t requestFrom(uint8_t addr, size_t quantity, bool stopBit = true);
+
+		size_t write(uint8_t data);
+		size_t write(const uint8_t *data, size_t quantity);
+
+		int available(void);
+		int read(void);
+		int peek(void);
+
+	private:
+		uint8_t _txAddr;
+		uint8_t _txBuff[WIRE_BUFFER_SIZE];
+		size_t _txLen;
+		bool _transmitting;
+
+		uint8_t _rxBuff[WIRE_BUFFER_SIZE];
+		size_t _rxLen;
+		size_t _rxIndex;
+};
+
+extern TwoWire Wire;
+
+#endif // HOST_WIRE_H_
@@ -0,0 +1,811 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	HostArduino.cpp
+*
+*/
+
+#include <Arduino.h>
+
+#include "HostHardware.h"
+
+#define HOST_MICROS_COST		1		// us. cost of reading the clock, so that busy-waits on micros() terminate
+#define HOST_ADC_READ_US		425		// us. duration of analogRead() on the stock SAMD core (DIV512 prescaler)
+#define HOST_USB_BYTES_PER_MS	1023	// bytes. USB full-speed bulk throughput per 1ms frame
+#define HOST_USB_TX_TIMEOUT_US	70000	// us. time the SAMD core waits for the PC to collect a packet (TX_TIMEOUT_MS)
+#define EMG_SIM_FIRST_PIN		A4		// SAMD21 ADC EMG channels are attached to A4 & A5
+#define EMG_SIM_NUM_PINS		2
+
+HostSerial SerialUSB;
+
+////////////////////////////// VIRTUAL CLOCK //////////////////////////////
+
+static uint64_t _now = 0;					// us
+static uint64_t _nextTick = 1000;			// us
+static uint64_t _numTicks = 0;
+static uint64_t _numDeferred = 0;
+static uint64_t _sleepTime = 0;				// us
+static uint32_t _pendingTicks = 0;
+static bool _irqEn = true;
+static bool _inTick = false;
+
+static void(*_tickFuncs[HOST_MAX_TICK_FUNCS])(void);
+static int _numTickFuncs = 0;
+
+static uint64_t _limit = 0;					// us, 0 = no limit
+static void(*_limitFunc)(void) = NULL;
+
+// run any pending ticks, unless interrupts are disabled or a tick is already running
+static void runTicks(void)
+{
+	if (!_irqEn || _inTick)
+		return;
+
+	_inTick = true;
+	while (_pendingTicks)
+	{
+		_pendingTicks--;
+		_numTicks++;
+
+		hostWatchdog_check();
+		hostFinger_stepAll();			// FingerLib timer ISR
+
+		for (int i = 0; i < _numTickFuncs; i++)
+		{
+			_tickFuncs[i]();
+		}
+	}
+	_inTick = false;
+}
+
+uint64_t hostClock_now(void)
+{
+	return _now;
+}
+
+void hostClock_advanceTo(uint64_t us)
+{
+	while (_nextTick <= us)
+	{
+		_now = _nextTick;
+		_nextTick += 1000;
+		_pendingTicks++;
+
+		if (!_irqEn || _inTick)
+			_numDeferred++;
+
+		runTicks();
+	}
+
+	if (us > _now)
+		_now = us;
+
+	// stop runs that never return to loop(), e.g. a halt after a fatal error
+	if (_limit && (_now > _limit) && _limitFunc)
+		_limitFunc();
+}
+
+void hostClock_advance(uint64_t us)
+{
+	hostClock_advanceTo(_now + us);
+}
+
+void hostClock_attachTick(void(*fn)(void))
+{
+	if (_numTickFuncs < HOST_MAX_TICK_FUNCS)
+		_tickFuncs[_numTickFuncs++] = fn;
+}
+
+void hostClock_setLimit(uint64_t us, void(*fn)(void))
+{
+	_limit = us;
+	_limitFunc = fn;
+}
+
+uint64_t hostClock_numTicks(void)
+{
+	return _numTicks;
+}
+
+uint64_t hostClock_numDeferredTicks(void)
+{
+	return _numDeferred;
+}
+
+uint64_t hostClock_sleepTime(void)
+{
+	return _sleepTime;
+}
+
+unsigned long millis(void)
+{
+	return (unsigned long)(_now / 1000);
+}
+
+unsigned long micros(void)
+{
+	hostClock_advance(HOST_MICROS_COST);
+	return (unsigned long)_now;
+}
+
+void delay(unsigned long ms)
+{
+	hostClock_advance((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+	hostClock_advance(us);
+}
+
+// sleep until the next interrupt (the 1ms tick is the only interrupt source), a pending tick wakes immediately
+void __WFI(void)
+{
+	uint64_t start = _now;
+
+	if (_pendingTicks)
+		return;
+
+	hostClock_advanceTo(_nextTick);
+	_sleepTime += _now - start;
+}
+
+void noInterrupts(void)
+{
+	_irqEn = false;
+}
+
+void interrupts(void)
+{
+	_irqEn = true;
+	runTicks();
+}
+
+
+////////////////////////////// PINS //////////////////////////////
+
+static uint8_t _pinLevel[NUM_HOST_PINS];
+static int _adcRes = 10;
+
+void pinMode(uint32_t pin, uint32_t mode)
+{
+	(void)pin;
+	(void)mode;
+}
+
+void digitalWrite(uint32_t pin, uint32_t val)
+{
+	if (pin < NUM_HOST_PINS)
+		_pinLevel[pin] = (val ? HIGH : LOW);
+}
+
+int digitalRead(uint32_t pin)
+{
+	return ((pin < NUM_HOST_PINS) ? _pinLevel[pin] : LOW);
+}
+
+int hostPin_level(uint32_t pin)
+{
+	return digitalRead(pin);
+}
+
+void analogWrite(uint32_t pin, uint32_t val)
+{
+	(void)pin;
+	(void)val;
+}
+
+
+////////////////////////////// ANALOGUE //////////////////////////////
+
+#define EMG_SIM_MAX_PULSES	8		// pulse trains of each channel
+
+typedef struct _EMGPulse
+{
+	uint32_t period;		// ms
+	uint32_t width;			// ms
+	int amplitude;			// ADC counts
+	uint32_t start;			// ms, the train is active from 'start' until 'end'
+	uint32_t end;			// ms, 0 for no end
+} EMGPulse;
+
+typedef struct _EMGSim
+{
+	EMGPulse pulse[EMG_SIM_MAX_PULSES];
+	int numPulses;
+	int level;				// ADC counts
+} EMGSim;
+
+static HostAnalogSource _analogSource = hostAnalog_defaultSource;
+static uint64_t _numReads = 0;
+static int _emgBaseline = 300;
+static int _emgNoise = 40;
+static EMGSim _emg[HOST_NUM_EMG_CHANNELS];
+static bool _emgRaw = false;
+static int _emgHum = 0;					// ADC counts, peak-to-peak
+static int _emgHumFreq = 50;			// Hz
+
+static uint32_t _noiseState = 0x1234567;
+
+// fixed sequence pseudo-random noise, so that every run is identical
+static uint32_t nextNoise(void)
+{
+	_noiseState = (_noiseState * 1103515245UL) + 12345UL;
+	return (_noiseState >> 8);
+}
+
+void hostAnalog_setSource(HostAnalogSource src)
+{
+	_analogSource = (src ? src : hostAnalog_defaultSource);
+}
+
+int hostEMG_channel(uint32_t pin)
+{
+	if ((pin >= EMG_SIM_FIRST_PIN) && (pin < (EMG_SIM_FIRST_PIN + EMG_SIM_NUM_PINS)))
+		return (int)(pin - EMG_SIM_FIRST_PIN);
+
+	if ((pin >= HOST_I2C_ADC_PIN(0)) && (pin < HOST_I2C_ADC_PIN(HOST_NUM_EMG_CHANNELS)))
+		return (int)(pin - HOST_I2C_ADC_PIN(0));
+
+	return -1;
+}
+
+int hostAnalog_defaultSource(uint32_t pin, uint64_t us)
+{
+	int ch = hostEMG_channel(pin);
+
+	// pins other than the EMG channels read mid-rail
+	if (ch < 0)
+		return 512;
+
+	uint32_t ms = (uint32_t)(us / 1000);
+	int val = _emgBaseline;
+	int contraction = _emg[ch].level;
+
+	for (int p = 0; p < _emg[ch].numPulses; p++)
+	{
+		const EMGPulse *pulse = &_emg[ch].pulse[p];
+
+		if ((ms < pulse->start) || (pulse->end && (ms >= pulse->end)))
+			continue;
+
+		if ((((ms - pulse->start) % pulse->period) < pulse->width))
+			contraction += pulse->amplitude;
+	}
+
+	if (_emgNoise)
+		val += (int)(nextNoise() % (uint32_t)_emgNoise) - (_emgNoise / 2);
+
+	if (_emgRaw)
+	{
+		// raw EMG is a zero mean burst around mid-rail, with a peak amplitude of the contraction level, plus mains hum
+		val += 512 - _emgBaseline;
+
+		if (contraction)
+			val += (int)(nextNoise() % (uint32_t)((2 * contraction) + 1)) - contraction;
+
+		if (_emgHum)
+			val += (int)((_emgHum / 2) * sin(2 * M_PI * _emgHumFreq * (double)us / 1000000.0));
+	}
+	else if (contraction)
+	{
+		// the rectified EMG envelope varies between 60% and 100% of the contraction level
+		val += (contraction * (60 + (int)(nextNoise() % 41))) / 100;
+	}
+
+	return constrain(val, 0, 1023);
+}
+
+void hostEMG_setNoise(int baseline, int amplitude)
+{
+	_emgBaseline = baseline;
+	_emgNoise = amplitude;
+}
+
+void hostEMG_setRaw(int hum, int hz)
+{
+	_emgRaw = true;
+	_emgHum = hum;
+	_emgHumFreq = hz;
+}
+
+void hostEMG_setPulse(int ch, uint32_t period_ms, uint32_t width_ms, int amplitude, uint32_t start_ms, uint32_t end_ms)
+{
+	if ((ch < 0) || (ch >= HOST_NUM_EMG_CHANNELS))
+		return;
+
+	// period = 0 removes every pulse train of the channel
+	if (!period_ms)
+	{
+		_emg[ch].numPulses = 0;
+		return;
+	}
+
+	if (_emg[ch].numPulses >= EMG_SIM_MAX_PULSES)
+		return;
+
+	EMGPulse *pulse = &_emg[ch].pulse[_emg[ch].numPulses++];
+
+	pulse->period = period_ms;
+	pulse->width = width_ms;
+	pulse->amplitude = amplitude;
+	pulse->start = start_ms;
+	pulse->end = end_ms;
+}
+
+void hostEMG_setLevel(int ch, int amplitude)
+{
+	if ((ch < 0) || (ch >= HOST_NUM_EMG_CHANNELS))
+		return;
+
+	_emg[ch].level = amplitude;
+}
+
+uint64_t hostAnalog_numReads(void)
+{
+	return _numReads;
+}
+
+void analogReadResolution(int res)
+{
+	_adcRes = res;
+}
+
+// read the analogue source (10 bit) at time 'us', without charging the analogRead() time
+int hostAnalog_sample(uint32_t pin, uint64_t us)
+{
+	return _analogSource(pin, us);
+}
+
+int analogRead(uint32_t pin)
+{
+	int val;
+
+	hostClock_advance(HOST_ADC_READ_US);
+	_numReads++;
+
+	val = _analogSource(pin, _now);
+
+	// the sources generate 10 bit values
+	if (_adcRes > 10)
+		val <<= (_adcRes - 10);
+	else if (_adcRes < 10)
+		val >>= (10 - _adcRes);
+
+	return val;
+}
+
+
+////////////////////////////// MATHS //////////////////////////////
+
+static uint32_t _randState = 1;
+
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+	if (in_max == in_min)
+		return out_min;
+
+	return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+void randomSeed(unsigned long seed)
+{
+	if (seed != 0)
+		_randState = seed;
+}
+
+long random(long howbig)
+{
+	if (howbig == 0)
+		return 0;
+
+	_randState = (_randState * 1103515245UL) + 12345UL;
+	return (long)((_randState >> 1) % (uint32_t)howbig);
+}
+
+long random(long howsmall, long howbig)
+{
+	if (howsmall >= howbig)
+		return howsmall;
+
+	return random(howbig - howsmall) + howsmall;
+}
+
+
+////////////////////////////// STRINGS //////////////////////////////
+
+static char *convertNumber(unsigned long value, char *str, int base, bool negative)
+{
+	char tmp[34];
+	int i = 0;
+	int j = 0;
+
+	if ((base < 2) || (base > 36))
+	{
+		str[0] = '\0';
+		return str;
+	}
+
+	do
+	{
+		int digit = value % base;
+		tmp[i++] = (digit < 10) ? ('0' + digit) : ('a' + digit - 10);
+		value /= base;
+	} while (value);
+
+	if (negative)
+		str[j++] = '-';
+
+	while (i)
+		str[j++] = tmp[--i];
+
+	str[j] = '\0';
+	return str;
+}
+
+char *itoa(int value, char *str, int base)
+{
+	if ((base == 10) && (value < 0))
+		return convertNumber((unsigned long)(-(long)value), str, base, true);
+
+	return convertNumber((unsigned int)value, str, base, false);
+}
+
+char *utoa(unsigned int value, char *str, int base)
+{
+	return convertNumber(value, str, base, false);
+}
+
+
+////////////////////////////// PRINT //////////////////////////////
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+	size_t n = 0;
+
+	while (size--)
+	{
+		n += write(*buffer++);
+	}
+	return n;
+}
+
+size_t Print::print(const char str[])
+{
+	return write(str);
+}
+
+size_t Print::print(char c)
+{
+	return write((uint8_t)c);
+}
+
+size_t Print::print(unsigned char n, int base)
+{
+	return print((unsigned long)n, base);
+}
+
+size_t Print::print(int n, int base)
+{
+	return print((long)n, base);
+}
+
+size_t Print::print(unsigned int n, int base)
+{
+	return print((unsigned long)n, base);
+}
+
+size_t Print::print(long n, int base)
+{
+	return print((long long)n, base);
+}
+
+size_t Print::print(unsigned long n, int base)
+{
+	return print((unsigned long long)n, base);
+}
+
+size_t Print::print(long long n, int base)
+{
+	if (base == 0)
+	{
+		return write((uint8_t)n);
+	}
+	else if ((base == 10) && (n < 0))
+	{
+		size_t t = print('-');
+		return printNumber((unsigned long long)(-n), 10) + t;
+	}
+	return printNumber((unsigned long long)n, base);
+}
+
+size_t Print::print(unsigned long long n, int base)
+{
+	if (base == 0)
+		return write((uint8_t)n);
+
+	return printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits)
+{
+	return printFloat(n, digits);
+}
+
+size_t Print::printNumber(unsigned long long n, uint8_t base)
+{
+	char buf[8 * sizeof(n) + 1];
+	char *str = &buf[sizeof(buf) - 1];
+
+	*str = '\0';
+
+	if (base < 2)
+		base = 10;
+
+	do
+	{
+		char c = n % base;
+		n /= base;
+
+		*--str = (c < 10) ? (c + '0') : (c + 'A' - 10);
+	} while (n);
+
+	return write(str);
+}
+
+// same output format as the Arduino core
+size_t Print::printFloat(double number, uint8_t digits)
+{
+	size_t n = 0;
+
+	if (isnan(number))
+		return print("nan");
+	if (isinf(number))
+		return print("inf");
+	if (number > 4294967040.0)
+		return print("ovf");
+	if (number < -4294967040.0)
+		return print("ovf");
+
+	if (number < 0.0)
+	{
+		n += print('-');
+		number = -number;
+	}
+
+	double rounding = 0.5;
+	for (uint8_t i = 0; i < digits; ++i)
+		rounding /= 10.0;
+
+	number += rounding;
+
+	unsigned long intPart = (unsigned long)number;
+	double remainder = number - (double)intPart;
+	n += print(intPart);
+
+	if (digits > 0)
+		n += print('.');
+
+	while (digits-- > 0)
+	{
+		remainder *= 10.0;
+		unsigned int toPrint = (unsigned int)remainder;
+		n += print(toPrint);
+		remainder -= toPrint;
+	}
+
+	return n;
+}
+
+
+////////////////////////////// SERIAL //////////////////////////////
+
+HostSerial::HostSerial()
+{
+	_rxHead = 0;
+	_rxTail = 0;
+	_echo = true;
+	_connected = true;
+	_txCapacity = HOST_USB_BYTES_PER_MS;
+	_txFrameCount = 0;
+	_txFrame = 0;
+	_txCount = 0;
+	_stallStart = 0;
+	_stallEnd = 0;
+	_txTimedOut = false;
+	_txDropped = 0;
+}
+
+void HostSerial::begin(unsigned long baud)
+{
+	(void)baud;
+}
+
+void HostSerial::end(void)
+{
+
+}
+
+int HostSerial::available(void)
+{
+	return (_rxHead - _rxTail + RX_BUFF_SIZE) % RX_BUFF_SIZE;
+}
+
+int HostSerial::peek(void)
+{
+	if (_rxHead == _rxTail)
+		return -1;
+
+	return _rxBuff[_rxTail];
+}
+
+int HostSerial::read(void)
+{
+	if (_rxHead == _rxTail)
+		return -1;
+
+	uint8_t c = _rxBuff[_rxTail];
+	_rxTail = (_rxTail + 1) % RX_BUFF_SIZE;
+	return c;
+}
+
+// the USB endpoint is emptied once per 1ms frame, so the space available is limited by how much has
+// been written since the last frame
+int HostSerial::availableForWrite(void)
+{
+	if (_txCapacity < 0)
+		return HOST_USB_BYTES_PER_MS;
+
+	uint64_t frame = hostClock_now() / 1000;
+
+	if (frame != _txFrame)
+	{
+		_txFrame = frame;
+		_txFrameCount = 0;
+	}
+
+	return (_txFrameCount < _txCapacity) ? (_txCapacity - _txFrameCount) : 0;
+}
+
+void HostSerial::flush(void)
+{
+	fflush(stdout);
+}
+
+size_t HostSerial::write(uint8_t c)
+{
+	return write(&c, 1);
+}
+
+// writes block until the next USB frame once the endpoint is full, as they do on the device. If the PC is not
+// reading, the core waits for the endpoint until it times out, then drops every write until the PC reads again
+size_t HostSerial::write(const uint8_t *buffer, size_t size)
+{
+	size_t n = 0;
+
+	if (!_connected)
+		return 0;
+
+	while (n < size)
+	{
+		if (stalled())
+		{
+			if (!_txTimedOut)
+			{
+				uint64_t timeout = hostClock_now() + HOST_USB_TX_TIMEOUT_US;
+
+				hostClock_advanceTo((_stallEnd < timeout) ? _stallEnd : timeout);
+				_txTimedOut = stalled();
+			}
+
+			if (_txTimedOut)
+			{
+				_txDropped += size - n;
+				return n;
+			}
+		}
+
+		_txTimedOut = false;
+
+		int space = availableForWrite();
+
+		if (space == 0)
+		{
+			hostClock_advanceTo((_txFrame + 1) * 1000);
+			continue;
+		}
+
+		int chunk = ((size - n) < (size_t)space) ? (int)(size - n) : space;
+
+		hostTrace_writeTx(buffer + n, chunk, _echo);		// separate any trace records from the text
+
+		_txFrameCount += chunk;
+		_txCount += chunk;
+		n += chunk;
+	}
+
+	return n;
+}
+
+bool HostSerial::dtr(void)
+{
+	return _connected;
+}
+
+void HostSerial::inject(const char *str)
+{
+	inject((const uint8_t *)str, strlen(str));
+}
+
+void HostSerial::inject(const uint8_t *buffer, size_t size)
+{
+	for (size_t i = 0; i < size; i++)
+	{
+		int next = (_rxHead + 1) % RX_BUFF_SIZE;
+
+		// drop bytes if the buffer is full, as the USB stack would NAK them
+		if (next == _rxTail)
+			break;
+
+		_rxBuff[_rxHead] = buffer[i];
+		_rxHead = next;
+	}
+}
+
+void HostSerial::setEcho(bool en)
+{
+	_echo = en;
+}
+
+void HostSerial::setConnected(bool en)
+{
+	_connected = en;
+}
+
+void HostSerial::setTxCapacity(int size)
+{
+	_txCapacity = size;
+}
+
+void HostSerial::setStall(uint64_t start, uint64_t end)
+{
+	_stallStart = start;
+	_stallEnd = end;
+}
+
+// the PC has collected the previous packet, and there is space for 'len' bytes within this frame
+bool HostSerial::txReady(int len)
+{
+	return (_connected && !stalled() && (availableForWrite() >= len));
+}
+
+unsigned long long HostSerial::txCount(void)
+{
+	return _txCount;
+}
+
+unsigned long long HostSerial::txDropped(void)
+{
+	return _txDropped;
+}
+
+bool HostSerial::stalled(void)
+{
+	uint64_t now = hostClock_now();
+
+	return ((now >= _stallStart) && (now < _stallEnd));
+}
+
+// replaces Utils_SAMD.cpp, SerialUSB is the only serial port of the host build
+bool serialTxReady(int len)
+{
+	return SerialUSB.txReady(len);
+}
@@ -0,0 +1,96 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	HostEMGADC.cpp
+*
+*/
+
+// Replaces EMGADC_SAMD.cpp (SAMD ADC registers). Each scan reads the analogue source at the time of the tick
+// that made it, which is called from the FingerLib timer interrupt after the fingers have been stepped
+
+#include <Arduino.h>
+
+#include "EMGADC.h"
+#include "HostHardware.h"
+
+static int _pins[EMG_ADC_MAX_CHANNELS];
+static uint8_t _hwRes = 10;					// bits, resolution of the simulated conversion result
+static uint64_t _numConversions = 0;
+
+uint64_t hostADC_numConversions(void)
+{
+	return _numConversions;
+}
+
+////////////////////////////// EMG_ADC //////////////////////////////
+
+bool EMG_ADC::begin(const int *pins, uint8_t numChannels, uint16_t rate, uint8_t res, uint8_t avg)
+{
+	uint8_t avgBits = 0;
+
+	if ((numChannels == 0) || (numChannels > EMG_ADC_MAX_CHANNELS) || (rate == 0) || (rate > 1000) || (1000 % rate) || (res > 12))
+		return false;
+
+	end();
+
+	while (((1 << (avgBits + 1)) <= avg) && (avgBits < 4))
+		avgBits++;
+
+	if (((uint16_t)numChannels * (1 << avgBits) * EMG_ADC_CONV_US) > EMG_ADC_MAX_SCAN_US)
+		return false;
+
+	for (uint8_t c = 0; c < numChannels; c++)
+	{
+		_pins[c] = pins[c];
+		_ain[c] = c;
+	}
+
+	_hwRes = (avgBits || (res > 10)) ? 12 : ((res > 8) ? 10 : 8);
+	_shift = (res < _hwRes) ? (_hwRes - res) : 0;
+
+	_numChannels = numChannels;
+	_rate = rate;
+	_fullTicks = 1000 / rate;
+	_ticksPerScan = _fullTicks;
+	_scansPerBlock = EMG_ADC_BLOCK_SIZE;
+	_idle = false;
+
+	_numComplete = 0;
+	_numRead = 0;
+	_numOverruns = 0;
+
+	_running = true;
+
+	return true;
+}
+
+void EMG_ADC::end(void)
+{
+	if (!_running)
+		return;
+
+	stop();
+
+	_running = false;
+}
+
+void EMG_ADC::convert(volatile uint16_t *dst)
+{
+	uint64_t t = hostClock_now();
+
+	for (uint8_t c = 0; c < _numChannels; c++)
+	{
+		int val = hostAnalog_sample(_pins[c], t);		// 10 bit
+
+		dst[c] = (uint16_t)((_hwRes >= 10) ? (val << (_hwRes - 10)) : (val >> (10 - _hwRes)));
+		_numConversions++;
+	}
+}
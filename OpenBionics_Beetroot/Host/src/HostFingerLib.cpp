@@ -0,0 +1,189 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	HostFingerLib.cpp
+*
+*/
+
+#include <Arduino.h>
+#include <FingerLib.h>
+
+#include "HostHardware.h"
+
+#define MAX_HOST_FINGERS		8
+#define FINGER_SIM_FULL_SPEED	1.2			// position counts per ms at MAX_FINGER_PWM (~0.8s full travel)
+
+static Finger *_fingers[MAX_HOST_FINGERS];
+static int _numFingers = 0;
+static void(*_timerFunc)(void) = NULL;
+
+// attach a function to be called from the 1ms timer interrupt (replaces any previously attached function)
+void _attachFuncToTimer(void(*fn)(void))
+{
+	_timerFunc = fn;
+}
+
+// FingerLib timer interrupt, advance every attached finger by 1ms then call the attached function
+void hostFinger_stepAll(void)
+{
+	for (int i = 0; i < _numFingers; i++)
+	{
+		_fingers[i]->hostStep();
+	}
+
+	if (_timerFunc)
+		_timerFunc();
+}
+
+
+////////////////////////////// Finger //////////////////////////////
+
+Finger::Finger()
+{
+	_attached = false;
+	_inv = false;
+	_motorEn = true;
+	_forceSnsEn = false;
+
+	_pos = MIN_FINGER_POS;
+	_targetPos = MIN_FINGER_POS;
+	_dir = OPEN;
+	_speed = MAX_FINGER_PWM;
+	_force = 0;
+}
+
+uint8_t Finger::attach(uint8_t dir0, uint8_t dir1, uint8_t posSns, uint8_t forceSns, bool inv)
+{
+	(void)dir0;
+	(void)dir1;
+	(void)posSns;
+	(void)forceSns;
+
+	if (!_attached && (_numFingers < MAX_HOST_FINGERS))
+	{
+		_fingers[_numFingers++] = this;
+		_attached = true;
+	}
+
+	_inv = inv;
+	return _attached;
+}
+
+bool Finger::attached(void)
+{
+	return _attached;
+}
+
+void Finger::writePos(int pos)
+{
+	_targetPos = constrain(pos, MIN_FINGER_POS, MAX_FINGER_POS);
+}
+
+int Finger::readPos(void)
+{
+	return (int)_pos;
+}
+
+int Finger::readTargetPos(void)
+{
+	return _targetPos;
+}
+
+int Finger::readPosError(void)
+{
+	return _targetPos - (int)_pos;
+}
+
+void Finger::writeDir(int dir)
+{
+	_dir = constrain(dir, CLOSE, OPEN);
+	writePos((_dir == OPEN) ? MIN_FINGER_POS : MAX_FINGER_POS);
+}
+
+int Finger::readDir(void)
+{
+	return _dir;
+}
+
+void Finger::open(void)
+{
+	writeDir(OPEN);
+}
+
+void Finger::close(void)
+{
+	writeDir(CLOSE);
+}
+
+void Finger::open_close(void)
+{
+	writeDir(!_dir);
+}
+
+void Finger::writeSpeed(int speed)
+{
+	_speed = constrain(speed, OFF_FINGER_PWM, MAX_FINGER_PWM);
+}
+
+int Finger::readSpeed(void)
+{
+	return _speed;
+}
+
+// PWM that the motor is currently being driven at
+int Finger::readTargetPWM(void)
+{
+	if (!_motorEn || ((int)_pos == _targetPos))
+		return 0;
+
+	return (_targetPos > (int)_pos) ? _speed : -_speed;
+}
+
+void Finger::writeForce(float force, int dir)
+{
+	_force = force;
+	writeDir(dir);
+}
+
+float Finger::readForce(void)
+{
+	return (_forceSnsEn ? _force : 0);
+}
+
+void Finger::forceSenseEnable(bool en)
+{
+	_forceSnsEn = en;
+}
+
+void Finger::motorEnable(bool en)
+{
+	_motorEn = en;
+}
+
+bool Finger::motorEnabled(void)
+{
+	return _motorEn;
+}
+
+// move towards the target position at a rate proportional to the speed
+void Finger::hostStep(void)
+{
+	if (!_motorEn)
+		return;
+
+	float step = (FINGER_SIM_FULL_SPEED * _speed) / MAX_FINGER_PWM;
+	float err = _targetPos - _pos;
+
+	if (fabs(err) <= step)
+		_pos = _targetPos;
+	else
+		_pos += (err > 0) ? step : -step;
+}
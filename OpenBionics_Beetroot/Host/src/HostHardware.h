@@ -0,0 +1,91 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	HostHardware.h
+*
+*/
+
+// Host-only control of the simulated hardware. None of this is visible to the firmware modules, which only
+// see the Arduino.h, Wire.h and FingerLib.h stand-ins
+
+#ifndef HOST_HARDWARE_H_
+#define HOST_HARDWARE_H_
+
+#include <Arduino.h>
+
+///////////////////////////////////// VIRTUAL CLOCK ///////////////////////////////////////
+// The virtual clock only moves forward when the firmware waits or when the runner charges time. Every
+// 1ms boundary that is crossed fires the timer 'interrupt', which is deferred while interrupts are disabled
+#define HOST_MAX_TICK_FUNCS		4
+
+uint64_t hostClock_now(void);						// current virtual time, in us
+void hostClock_advance(uint64_t us);				// move the virtual clock forward, firing any 1ms ticks that are crossed
+void hostClock_advanceTo(uint64_t us);				// move the virtual clock forward to an absolute time
+void hostClock_attachTick(void(*fn)(void));			// call fn() from every 1ms tick (in attach order)
+void hostClock_setLimit(uint64_t us, void(*fn)(void));	// call fn() (which must not return) once the virtual time passes 'us'
+uint64_t hostClock_numTicks(void);					// number of 1ms ticks that have fired
+uint64_t hostClock_numDeferredTicks(void);			// number of ticks that were delayed by noInterrupts()
+uint64_t hostClock_sleepTime(void);					// total time spent in __WFI(), in us
+
+///////////////////////////////////// PINS ///////////////////////////////////////
+int hostPin_level(uint32_t pin);					// last value passed to digitalWrite()
+
+///////////////////////////////////// ANALOGUE ///////////////////////////////////////
+// the analogue source is called for every analogRead(), after the pin has been mapped to a channel number
+typedef int(*HostAnalogSource)(uint32_t pin, uint64_t us);
+
+#define HOST_NUM_EMG_CHANNELS	8					// number of simulated EMG channels
+#define HOST_I2C_ADC_PIN(ch)	(128 + (ch))		// pin number passed to the analogue source for channel 'ch' of the I2C EMG ADC
+
+void hostAnalog_setSource(HostAnalogSource src);	// replace the default EMG/position generator (NULL restores it)
+int hostAnalog_defaultSource(uint32_t pin, uint64_t us);
+int hostEMG_channel(uint32_t pin);					// simulated EMG channel read by a pin (A4 & A5, or an I2C ADC channel), or -1
+void hostEMG_setNoise(int baseline, int amplitude);						// resting level and peak-to-peak noise of every EMG channel
+void hostEMG_setPulse(int ch, uint32_t period_ms, uint32_t width_ms, int amplitude, uint32_t start_ms = 0, uint32_t end_ms = 0);	// add a periodic contraction to an EMG channel, from start until end (0 = forever), period = 0 removes them
+void hostEMG_setLevel(int ch, int amplitude);							// constant contraction on an EMG channel, on top of any pulses
+void hostEMG_setRaw(int hum, int hz);									// simulate raw (unrectified) EMG with mains hum, instead of the envelope
+uint64_t hostAnalog_numReads(void);
+int hostAnalog_sample(uint32_t pin, uint64_t us);	// read the analogue source (10 bit) at time 'us', without charging the analogRead() time
+uint64_t hostADC_numConversions(void);				// number of conversions made by the simulated EMG ADC
+
+///////////////////////////////////// I2C DEVICES ///////////////////////////////////////
+bool hostEEPROM_attachFile(const char *path);		// load the EEPROM image from a file, and write back to it after every write
+void hostEEPROM_erase(void);						// set every EEPROM location to 0xFF
+uint8_t *hostEEPROM_data(void);						// direct access to the EEPROM image
+
+void hostIMU_setTemp(float temp);					// die temperature reported by the IMU, in 'C
+void hostIMU_setRegs(uint8_t addr, uint8_t reg, const uint8_t *data, size_t len);	// overwrite IMU registers, including the read only data registers
+void hostHANDle_set(int joyX, int joyY, bool btnZ, bool btnC);		// Nunchuck joystick (0 - 255, centre 128) and buttons
+void hostHANDle_setRaw(const uint8_t *data, size_t len);			// raw Nunchuck bytes
+void hostI2C_setClock(uint32_t freq);				// bus speed used to charge virtual time per I2C byte
+uint64_t hostI2C_numBytes(void);
+
+///////////////////////////////////// FINGERS ///////////////////////////////////////
+void hostFinger_stepAll(void);						// advance every attached finger by 1ms and call the attached timer function
+
+///////////////////////////////////// TRACE ///////////////////////////////////////
+// Record: trace records sent by the firmware are separated from the serial text and written to a file.
+// Replay: the inputs within a trace file are fed back through the simulated hardware, at the recorded times
+// relative to the start of the replay (the EMG inputs hold the most recent recorded sample)
+bool hostTrace_record(const char *path);			// write any trace records sent over serial to a file
+void hostTrace_writeTx(const uint8_t *data, size_t len, bool echo);	// pass serial output through the trace record filter
+bool hostTrace_replay(const char *path);			// load a trace file to replay
+void hostTrace_startReplay(void);					// start the replay from the current virtual time
+bool hostTrace_replaying(void);						// true if a replay has been started and not all records have been applied
+uint64_t hostTrace_numRecorded(void);
+int64_t hostTrace_recordStart(void);				// virtual time of the first record sent (us), -1 if none
+uint64_t hostTrace_numReplayed(void);
+
+///////////////////////////////////// WATCHDOG ///////////////////////////////////////
+bool hostWatchdog_bitten(void);						// true if the watchdog period has elapsed without a reset()
+void hostWatchdog_check(void);						// called from the timer tick
+
+#endif // HOST_HARDWARE_H_
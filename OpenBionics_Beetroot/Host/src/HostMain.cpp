@@ -0,0 +1,260 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	HostMain.cpp
+*
+*/
+
+// Host runner. Calls setup() once and then loop() until the requested amount of virtual time has passed,
+// charging a fixed cost per loop() on top of any time the firmware spends waiting. Serial commands can be
+// scheduled at virtual times, and the simulated EMG, Nunchuck and IMU can be configured from the command line
+
+#include <Arduino.h>
+
+#include <time.h>
+
+#include "HostHardware.h"
+
+#define MAX_HOST_CMDS		64
+
+void setup(void);
+void loop(void);
+
+typedef struct _HostCmd
+{
+	uint64_t time;			// us
+	const char *str;
+	bool sent;
+} HostCmd;
+
+static HostCmd _cmds[MAX_HOST_CMDS];
+static int _numCmds = 0;
+
+static uint64_t _numLoops = 0;
+static uint64_t _loopStart = 0;			// us
+static clock_t _wallStart;
+
+static void printUsage(const char *name)
+{
+	fprintf(stderr,
+		"usage: %s [options]\n"
+		"  --time <s>                       virtual time to run for (default 10)\n"
+		"  --loop-us <us>                   cost charged for each call to loop() (default 20)\n"
+		"  --cmd <ms>:<string>              send a serial command at a virtual time (newline appended)\n"
+		"  --quiet                          do not echo serial output to stdout\n"
+		"  --eeprom <file>                  load/store the EEPROM image in a file\n"
+		"  --emg-noise <base>:<p2p>         resting EMG level and noise (default 300:40)\n"
+		"  --emg-pulse <ch>:<per>:<w>:<amp>[:<start>:<end>]\n"
+		"                                   periodic contraction, period and width in ms, optionally only from start\n"
+		"                                   until end (ms), repeat to add more pulse trains to a channel\n"
+		"  --emg-level <ch>:<amp>           constant contraction\n"
+		"  --emg-raw <hum>:<Hz>             raw (unrectified) EMG around mid-rail, with mains hum (for USE_EMG_FILTER)\n"
+		"  --joy <x>:<y>                    Nunchuck joystick (0 - 255, centre 128)\n"
+		"  --temp <C>                       IMU die temperature\n"
+		"  --record <file>                  write the trace records sent by the firmware (A7) to a file\n"
+		"  --replay <file>                  replay the inputs within a trace file, starting after setup()\n"
+		"  --usb-stall <start>:<end>        the PC stops reading the serial port from start until end (ms)\n",
+		name);
+}
+
+static void sendCommands(void)
+{
+	for (int i = 0; i < _numCmds; i++)
+	{
+		if (!_cmds[i].sent && (hostClock_now() >= _cmds[i].time))
+		{
+			SerialUSB.inject(_cmds[i].str);
+			SerialUSB.inject("\n");
+			_cmds[i].sent = true;
+		}
+	}
+}
+
+static void printSummary(void)
+{
+	SerialUSB.flush();
+
+	double wall = (double)(clock() - _wallStart) / CLOCKS_PER_SEC;
+	double virt = hostClock_now() / 1e6;
+	double loopTime = (hostClock_now() - _loopStart) / 1e6;
+
+	fprintf(stderr, "\n[host] virtual time:   %.3f s\n", virt);
+	fprintf(stderr, "[host] wall time:      %.3f s (x%.0f real time)\n", wall, (wall > 0) ? (virt / wall) : 0.0);
+	fprintf(stderr, "[host] loops:          %llu (%.1f Hz, %.0f ns host CPU per loop)\n", (unsigned long long)_numLoops,
+		(loopTime > 0) ? (_numLoops / loopTime) : 0.0, _numLoops ? ((wall * 1e9) / _numLoops) : 0.0);
+	fprintf(stderr, "[host] ticks:          %llu (%llu deferred by noInterrupts())\n",
+		(unsigned long long)hostClock_numTicks(), (unsigned long long)hostClock_numDeferredTicks());
+	fprintf(stderr, "[host] sleep:          %.3f s\n", hostClock_sleepTime() / 1e6);
+	fprintf(stderr, "[host] analogRead:     %llu\n", (unsigned long long)hostAnalog_numReads());
+	fprintf(stderr, "[host] EMG ADC:        %llu conversions\n", (unsigned long long)hostADC_numConversions());
+	fprintf(stderr, "[host] I2C bytes:      %llu\n", (unsigned long long)hostI2C_numBytes());
+	fprintf(stderr, "[host] serial TX:      %llu bytes (%llu dropped)\n", SerialUSB.txCount(), SerialUSB.txDropped());
+	fprintf(stderr, "[host] trace:          %llu recorded, %llu replayed\n",
+		(unsigned long long)hostTrace_numRecorded(), (unsigned long long)hostTrace_numReplayed());
+	if (hostTrace_recordStart() >= 0)
+		fprintf(stderr, "[host] trace start:    %lld ms\n", (long long)(hostTrace_recordStart() / 1000));
+}
+
+// the firmware did not return to loop() before the end of the run (e.g. halted after a fatal error)
+static void limitReached(void)
+{
+	fprintf(stderr, "\n[host] run time exceeded without returning to loop()\n");
+	printSummary();
+	exit(3);
+}
+
+int main(int argc, char **argv)
+{
+	double runTime = 10.0;			// s
+	unsigned int loopCost = 20;		// us
+	bool quiet = false;
+	bool replay = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char *arg = argv[i];
+		const char *val = ((i + 1) < argc) ? argv[i + 1] : NULL;
+
+		if (!strcmp(arg, "--quiet"))
+		{
+			quiet = true;
+			continue;
+		}
+		else if (!strcmp(arg, "--help") || !val)
+		{
+			printUsage(argv[0]);
+			return (strcmp(arg, "--help") ? 1 : 0);
+		}
+
+		i++;
+
+		if (!strcmp(arg, "--time"))
+		{
+			runTime = atof(val);
+		}
+		else if (!strcmp(arg, "--loop-us"))
+		{
+			loopCost = atoi(val);
+		}
+		else if (!strcmp(arg, "--cmd"))
+		{
+			const char *sep = strchr(val, ':');
+
+			if (!sep || (_numCmds >= MAX_HOST_CMDS))
+			{
+				printUsage(argv[0]);
+				return 1;
+			}
+
+			_cmds[_numCmds].time = (uint64_t)atol(val) * 1000;
+			_cmds[_numCmds].str = sep + 1;
+			_cmds[_numCmds].sent = false;
+			_numCmds++;
+		}
+		else if (!strcmp(arg, "--eeprom"))
+		{
+			if (!hostEEPROM_attachFile(val))
+			{
+				fprintf(stderr, "unable to open EEPROM file %s\n", val);
+				return 1;
+			}
+		}
+		else if (!strcmp(arg, "--emg-noise"))
+		{
+			int base = 0, p2p = 0;
+			sscanf(val, "%d:%d", &base, &p2p);
+			hostEMG_setNoise(base, p2p);
+		}
+		else if (!strcmp(arg, "--emg-pulse"))
+		{
+			int ch = 0, amp = 0;
+			unsigned int per = 0, width = 0, start = 0, end = 0;
+			sscanf(val, "%d:%u:%u:%d:%u:%u", &ch, &per, &width, &amp, &start, &end);
+			hostEMG_setPulse(ch, per, width, amp, start, end);
+		}
+		else if (!strcmp(arg, "--emg-level"))
+		{
+			int ch = 0, amp = 0;
+			sscanf(val, "%d:%d", &ch, &amp);
+			hostEMG_setLevel(ch, amp);
+		}
+		else if (!strcmp(arg, "--emg-raw"))
+		{
+			int hum = 0, hz = 50;
+			sscanf(val, "%d:%d", &hum, &hz);
+			hostEMG_setRaw(hum, hz);
+		}
+		else if (!strcmp(arg, "--joy"))
+		{
+			int x = 128, y = 128;
+			sscanf(val, "%d:%d", &x, &y);
+			hostHANDle_set(x, y, false, false);
+		}
+		else if (!strcmp(arg, "--temp"))
+		{
+			hostIMU_setTemp(atof(val));
+		}
+		else if (!strcmp(arg, "--record"))
+		{
+			if (!hostTrace_record(val))
+			{
+				fprintf(stderr, "unable to open trace file %s\n", val);
+				return 1;
+			}
+		}
+		else if (!strcmp(arg, "--usb-stall"))
+		{
+			unsigned int start = 0, end = 0;
+			sscanf(val, "%u:%u", &start, &end);
+			SerialUSB.setStall((uint64_t)start * 1000, (uint64_t)end * 1000);
+		}
+		else if (!strcmp(arg, "--replay"))
+		{
+			if (!hostTrace_replay(val))
+			{
+				fprintf(stderr, "unable to open trace file %s\n", val);
+				return 1;
+			}
+			replay = true;
+		}
+		else
+		{
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	SerialUSB.setEcho(!quiet);
+
+	const uint64_t endTime = (uint64_t)(runTime * 1e6);
+
+	_wallStart = clock();
+	hostClock_setLimit(endTime + 1000000, limitReached);
+
+	setup();
+
+	if (replay)
+		hostTrace_startReplay();
+
+	_loopStart = hostClock_now();
+
+	while ((hostClock_now() < endTime) && !hostWatchdog_bitten())
+	{
+		sendCommands();
+		loop();
+		hostClock_advance(loopCost);
+		_numLoops++;
+	}
+
+	printSummary();
+
+	return (hostWatchdog_bitten() ? 2 : 0);
+}
@@ -0,0 +1,284 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	HostTrace.cpp
+*
+*/
+
+// Record and replay of the binary input traces described in Trace.h. A trace file is a stream of SLIP framed
+// records, any bytes outside of a frame are ignored, so a raw capture of the serial output of a hand can be
+// replayed directly
+
+#include <Arduino.h>
+
+#include "HostHardware.h"
+#include "Trace.h"
+
+typedef struct _HostTraceRecord
+{
+	uint64_t time;							// us, since the start of the trace
+	uint8_t type;							// TraceType
+	uint8_t len;							// size of payload
+	uint8_t data[TRACE_MAX_BODY_SIZE];		// payload
+} HostTraceRecord;
+
+// RECORD
+static FILE *_recordFile = NULL;
+static bool _txInFrame = false;
+static uint64_t _numRecorded = 0;
+static int64_t _recordStart = -1;			// us, virtual time of the first record, -1 if none
+
+// REPLAY
+static HostTraceRecord *_records = NULL;
+static size_t _numRecords = 0;
+static size_t _nextRecord = 0;
+static uint64_t _replayStart = 0;			// us
+static bool _replayStarted = false;
+
+static int _emgSample[HOST_NUM_EMG_CHANNELS];
+static bool _emgValid[HOST_NUM_EMG_CHANNELS];
+
+
+////////////////////////////// RECORD //////////////////////////////
+
+bool hostTrace_record(const char *path)
+{
+	_recordFile = fopen(path, "wb");
+
+	return (_recordFile != NULL);
+}
+
+void hostTrace_writeTx(const uint8_t *data, size_t len, bool echo)
+{
+	for (size_t i = 0; i < len; i++)
+	{
+		uint8_t c = data[i];
+
+		if (c == TRACE_END)
+		{
+			if (_txInFrame)
+				_numRecorded++;
+			else if (_recordStart < 0)
+				_recordStart = hostClock_now();
+
+			_txInFrame = !_txInFrame;
+		}
+
+		if ((c == TRACE_END) || _txInFrame)
+		{
+			if (_recordFile)
+				fputc(c, _recordFile);
+		}
+		else if (echo)
+		{
+			fputc(c, stdout);
+		}
+	}
+
+	if (_recordFile && !_txInFrame)
+		fflush(_recordFile);
+}
+
+uint64_t hostTrace_numRecorded(void)
+{
+	return _numRecorded;
+}
+
+int64_t hostTrace_recordStart(void)
+{
+	return _recordStart;
+}
+
+
+////////////////////////////// REPLAY //////////////////////////////
+
+static uint32_t readVarint(const uint8_t *data, size_t len, size_t *pos)
+{
+	uint32_t val = 0;
+	uint8_t shift = 0;
+
+	while ((*pos < len) && (shift < 32))
+	{
+		uint8_t b = data[(*pos)++];
+
+		val |= (uint32_t)(b & 0x7F) << shift;
+		shift += 7;
+
+		if (!(b & 0x80))
+			break;
+	}
+
+	return val;
+}
+
+// decode a record body and add it to the list of records
+static void addRecord(const uint8_t *body, size_t len, uint64_t *time)
+{
+	static size_t capacity = 0;
+	size_t pos = 1;
+
+	if ((len < 2) || (body[0] >= NUM_TRACE_TYPES))
+		return;
+
+	*time += readVarint(body, len, &pos);
+
+	if (_numRecords >= capacity)
+	{
+		capacity = capacity ? (capacity * 2) : 1024;
+		_records = (HostTraceRecord *)realloc(_records, capacity * sizeof(HostTraceRecord));
+	}
+
+	HostTraceRecord *rec = &_records[_numRecords++];
+
+	rec->time = *time;
+	rec->type = body[0];
+	rec->len = (uint8_t)(len - pos);
+	memcpy(rec->data, body + pos, rec->len);
+}
+
+bool hostTrace_replay(const char *path)
+{
+	FILE *file = fopen(path, "rb");
+
+	if (!file)
+		return false;
+
+	uint8_t body[TRACE_MAX_BODY_SIZE];
+	size_t len = 0;
+	bool inFrame = false;
+	bool esc = false;
+	uint64_t time = 0;
+	int c;
+
+	while ((c = fgetc(file)) != EOF)
+	{
+		if (c == TRACE_END)
+		{
+			if (inFrame)
+				addRecord(body, len, &time);
+
+			inFrame = !inFrame;
+			len = 0;
+			esc = false;
+		}
+		else if (inFrame)
+		{
+			if (esc)
+			{
+				c = (c == TRACE_ESC_END) ? TRACE_END : TRACE_ESC;
+				esc = false;
+			}
+			else if (c == TRACE_ESC)
+			{
+				esc = true;
+				continue;
+			}
+
+			if (len < sizeof(body))
+				body[len++] = (uint8_t)c;
+		}
+	}
+
+	fclose(file);
+
+	return true;
+}
+
+// apply a recorded input to the simulated hardware
+static void applyRecord(const HostTraceRecord *rec)
+{
+	switch (rec->type)
+	{
+	case TRACE_EMG:
+	{
+		size_t pos = 1;
+		uint8_t n = rec->len ? rec->data[0] : 0;
+
+		for (uint8_t ch = 0; ch < n; ch++)
+		{
+			int val = (int)readVarint(rec->data, rec->len, &pos);
+
+			if (ch < HOST_NUM_EMG_CHANNELS)
+			{
+				_emgSample[ch] = val;
+				_emgValid[ch] = true;
+			}
+		}
+		break;
+	}
+	case TRACE_HANDLE:
+		hostHANDle_setRaw(rec->data, rec->len);
+		break;
+	case TRACE_IMU:
+		if (rec->len >= 2)
+			hostIMU_setRegs(rec->data[0], rec->data[1], rec->data + 2, rec->len - 2);
+		break;
+	case TRACE_SERIAL:
+		SerialUSB.inject(rec->data, rec->len);
+		break;
+	default:
+		break;
+	}
+}
+
+// apply every record that is due at 'now' (us)
+static void updateTo(uint64_t now)
+{
+	if (!_replayStarted || (now < _replayStart))
+		return;
+
+	uint64_t time = now - _replayStart;
+
+	while ((_nextRecord < _numRecords) && (_records[_nextRecord].time <= time))
+	{
+		applyRecord(&_records[_nextRecord++]);
+	}
+}
+
+// apply every record that is due
+static void update(void)
+{
+	updateTo(hostClock_now());
+}
+
+// the EMG channels hold the most recent recorded sample, other pins use the default source
+static int replaySource(uint32_t pin, uint64_t us)
+{
+	int ch = hostEMG_channel(pin);
+
+	updateTo(us);		// the EMG ADC reads each scan at its sample time
+
+	if ((ch >= 0) && _emgValid[ch])
+		return _emgSample[ch];
+
+	return hostAnalog_defaultSource(pin, us);
+}
+
+void hostTrace_startReplay(void)
+{
+	_replayStart = hostClock_now();
+	_replayStarted = true;
+
+	hostAnalog_setSource(replaySource);
+	hostClock_attachTick(update);
+
+	update();
+}
+
+bool hostTrace_replaying(void)
+{
+	return (_replayStarted && (_nextRecord < _numRecords));
+}
+
+uint64_t hostTrace_numReplayed(void)
+{
+	return _nextRecord;
+}
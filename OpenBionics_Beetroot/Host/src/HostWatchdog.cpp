@@ -0,0 +1,103 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	HostWatchdog.cpp
+*
+*/
+
+// Replaces Watchdog.cpp (SAMD WDT registers). The watchdog is checked from the 1ms tick, and a bite is
+// reported to the host runner rather than resetting the process
+
+#include <Arduino.h>
+
+#include "Watchdog.h"
+#include "HostHardware.h"
+
+WDT_CLASS Watchdog;
+
+static uint64_t _period = 0;			// us, 0 = disabled
+static uint64_t _ewPeriod = 0;			// us, 0 = disabled
+static uint64_t _lastReset = 0;			// us
+static bool _ewFired = false;
+static bool _bitten = false;
+
+WDT_CLASS::WDT_CLASS()
+{
+	_init = false;
+	_EWcallbackFunc = nullptr;
+}
+
+// the SAMD watchdog supports periods of 8ms -> 16s in powers of 2
+int WDT_CLASS::begin(int maxPeriodMS)
+{
+	int period = 16384;
+
+	if (maxPeriodMS > 0)
+	{
+		while ((period > 8) && (period > maxPeriodMS))
+			period >>= 1;
+	}
+
+	_init = true;
+	_period = (uint64_t)period * 1000;
+	reset();
+
+	return period;
+}
+
+int WDT_CLASS::enInterrupt(bool en, int period, void(*f)(void))
+{
+	_EWcallbackFunc = f;
+	_ewPeriod = (en ? (uint64_t)period * 1000 : 0);
+
+	return period;
+}
+
+void WDT_CLASS::reset()
+{
+	_lastReset = hostClock_now();
+	_ewFired = false;
+}
+
+void WDT_CLASS::disable()
+{
+	_period = 0;
+	_ewPeriod = 0;
+}
+
+void WDT_CLASS::initialiseWDT(void)
+{
+	_init = true;
+}
+
+bool hostWatchdog_bitten(void)
+{
+	return _bitten;
+}
+
+void hostWatchdog_check(void)
+{
+	uint64_t elapsed = hostClock_now() - _lastReset;
+
+	if (_ewPeriod && !_ewFired && (elapsed >= _ewPeriod))
+	{
+		_ewFired = true;
+
+		if (Watchdog._EWcallbackFunc != nullptr)
+			Watchdog._EWcallbackFunc();
+	}
+
+	if (_period && !_bitten && (elapsed >= _period))
+	{
+		_bitten = true;
+		fprintf(stderr, "\n[host] watchdog reset at %.3fs (no reset() for %.3fs)\n", hostClock_now() / 1e6, elapsed / 1e6);
+	}
+}
@@ -0,0 +1,440 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	HostWire.cpp
+*
+*/
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#include "HostHardware.h"
+
+// DEVICE ADDRESSES
+#define EEPROM_SIM_ADDR			0x50	// 24AA08, occupies 0x50 -> 0x53 (block select)
+#define EEPROM_SIM_SIZE			1024
+#define EEPROM_SIM_PAGE_SIZE	16
+#define IMU_SIM_ADDR_XL_G		0x6B
+#define IMU_SIM_ADDR_M			0x1E
+#define HANDLE_SIM_ADDR			0x52
+#define ADC_SIM_ADDR			0x33	// MAX11615 EMG ADC
+#define ADC_SIM_MAX_CHANNELS	12
+#define JACK_SWITCH_PIN			10		// LOW = headphone jack connected to I2C
+
+// IMU REGISTERS
+#define IMU_SIM_WHO_AM_I		0x0F
+#define IMU_SIM_OUT_TEMP_L		0x15
+#define IMU_SIM_OUT_X_L_G		0x18
+#define IMU_SIM_STATUS_REG		0x27
+#define IMU_SIM_OUT_X_L_XL		0x28
+#define IMU_SIM_TEMP_SENS		16		// LSB/'C
+#define IMU_SIM_TEMP_ZERO		25		// 'C
+
+TwoWire Wire;
+
+////////////////////////////// DEVICE MODELS //////////////////////////////
+
+static uint32_t _i2cClock = 100000;
+static uint64_t _i2cBytes = 0;
+
+// EEPROM
+static uint8_t _eeprom[EEPROM_SIM_SIZE];
+static uint16_t _eepromPtr = 0;
+static bool _eepromInit = false;
+static FILE *_eepromFile = NULL;
+
+// IMU
+static uint8_t _imuXLG[256];
+static uint8_t _imuM[256];
+static uint8_t _imuPtrXLG = 0;
+static uint8_t _imuPtrM = 0;
+static bool _imuInit = false;
+
+// NUNCHUCK
+static uint8_t _handle[6] = { 128, 128, 128, 128, 180, 0xFF };
+
+// EMG ADC
+static uint8_t _adcNumChannels = 1;		// AIN0 to AIN(CS), from the configuration byte
+
+static void eepromInit(void)
+{
+	if (!_eepromInit)
+	{
+		memset(_eeprom, 0xFF, sizeof(_eeprom));
+		_eepromInit = true;
+	}
+}
+
+static void eepromSave(void)
+{
+	if (!_eepromFile)
+		return;
+
+	fseek(_eepromFile, 0, SEEK_SET);
+	fwrite(_eeprom, 1, sizeof(_eeprom), _eepromFile);
+	fflush(_eepromFile);
+}
+
+static void setReg16(uint8_t *regs, uint8_t reg, int16_t val)
+{
+	regs[reg] = (uint8_t)(val & 0xFF);
+	regs[reg + 1] = (uint8_t)((val >> 8) & 0xFF);
+}
+
+static void imuInit(void)
+{
+	if (_imuInit)
+		return;
+
+	_imuXLG[IMU_SIM_WHO_AM_I] = 0x68;
+	_imuXLG[IMU_SIM_STATUS_REG] = 0x07;				// accel, gyro & temp data available
+	setReg16(_imuXLG, IMU_SIM_OUT_X_L_XL + 4, 16393);	// 1g on the Z axis (0.061 mg/LSB)
+
+	_imuM[IMU_SIM_WHO_AM_I] = 0x3D;
+	_imuM[IMU_SIM_STATUS_REG] = 0x08;				// XYZ data available
+	setReg16(_imuM, IMU_SIM_OUT_X_L_XL, 1500);
+	setReg16(_imuM, IMU_SIM_OUT_X_L_XL + 2, -700);
+	setReg16(_imuM, IMU_SIM_OUT_X_L_XL + 4, 2500);
+
+	_imuInit = true;
+	hostIMU_setTemp(28.0);
+}
+
+// the Nunchuck is only reachable when the headphone jack is switched to I2C, otherwise 0x52 is EEPROM block 2
+static bool handleSelected(uint8_t addr)
+{
+	return ((addr == HANDLE_SIM_ADDR) && (hostPin_level(JACK_SWITCH_PIN) == LOW));
+}
+
+// the EMG ADC is also on the headphone jack
+static bool adcSelected(uint8_t addr)
+{
+	return ((addr == ADC_SIM_ADDR) && (hostPin_level(JACK_SWITCH_PIN) == LOW));
+}
+
+static bool devicePresent(uint8_t addr)
+{
+	if (handleSelected(addr) || adcSelected(addr))
+		return true;
+
+	if ((addr >= EEPROM_SIM_ADDR) && (addr < (EEPROM_SIM_ADDR + (EEPROM_SIM_SIZE / 256))))
+		return true;
+
+	return ((addr == IMU_SIM_ADDR_XL_G) || (addr == IMU_SIM_ADDR_M));
+}
+
+// write transaction, the first byte is the register/word address
+static void deviceWrite(uint8_t addr, const uint8_t *data, size_t len)
+{
+	if (!len)
+		return;
+
+	if (handleSelected(addr))
+	{
+		return;			// initialisation & conversion requests are accepted without any effect
+	}
+	else if (adcSelected(addr))
+	{
+		// setup bytes (REG = 1) are accepted without any effect, configuration bytes set the length of the scan
+		for (size_t i = 0; i < len; i++)
+		{
+			if (!(data[i] & 0x80))
+				_adcNumChannels = ((data[i] >> 1) & 0x0F) + 1;
+		}
+	}
+	else if ((addr >= EEPROM_SIM_ADDR) && (addr < (EEPROM_SIM_ADDR + (EEPROM_SIM_SIZE / 256))))
+	{
+		eepromInit();
+
+		uint16_t block = (addr - EEPROM_SIM_ADDR) * 256;
+		uint16_t loc = block + data[0];
+
+		_eepromPtr = loc;
+
+		// data is written within the addressed page, wrapping at the page boundary
+		for (size_t i = 1; i < len; i++)
+		{
+			uint16_t page = loc - (loc % EEPROM_SIM_PAGE_SIZE);
+			_eeprom[page + ((loc + i - 1) % EEPROM_SIM_PAGE_SIZE)] = data[i];
+		}
+
+		if (len > 1)
+			eepromSave();
+	}
+	else if ((addr == IMU_SIM_ADDR_XL_G) || (addr == IMU_SIM_ADDR_M))
+	{
+		imuInit();
+
+		uint8_t *regs = (addr == IMU_SIM_ADDR_M) ? _imuM : _imuXLG;
+		uint8_t *ptr = (addr == IMU_SIM_ADDR_M) ? &_imuPtrM : &_imuPtrXLG;
+
+		*ptr = data[0];
+
+		// status and data registers are read only
+		for (size_t i = 1; i < len; i++)
+		{
+			uint8_t reg = data[0] + (i - 1);
+
+			if ((reg >= IMU_SIM_OUT_TEMP_L) && (reg <= (IMU_SIM_OUT_X_L_XL + 5)))
+				continue;
+
+			regs[reg] = data[i];
+		}
+	}
+}
+
+// read transaction from the current register/word address
+static size_t deviceRead(uint8_t addr, uint8_t *data, size_t len)
+{
+	if (handleSelected(addr))
+	{
+		for (size_t i = 0; i < len; i++)
+			data[i] = _handle[i % 6];
+	}
+	else if (adcSelected(addr))
+	{
+		// each read converts the scan, every result is 1111 + 12 bits
+		uint64_t now = hostClock_now();
+		uint16_t val = 0;
+
+		for (size_t i = 0; i < len; i++)
+		{
+			if (!(i % 2))
+				val = (uint16_t)(hostAnalog_sample(HOST_I2C_ADC_PIN((i / 2) % _adcNumChannels), now) << 2);		// 10 bit to 12 bit
+
+			data[i] = (i % 2) ? (uint8_t)(val & 0xFF) : (uint8_t)(0xF0 | (val >> 8));
+		}
+	}
+	else if ((addr >= EEPROM_SIM_ADDR) && (addr < (EEPROM_SIM_ADDR + (EEPROM_SIM_SIZE / 256))))
+	{
+		eepromInit();
+
+		for (size_t i = 0; i < len; i++)
+		{
+			data[i] = _eeprom[_eepromPtr];
+			_eepromPtr = (_eepromPtr + 1) % EEPROM_SIM_SIZE;
+		}
+	}
+	else if ((addr == IMU_SIM_ADDR_XL_G) || (addr == IMU_SIM_ADDR_M))
+	{
+		imuInit();
+
+		uint8_t *regs = (addr == IMU_SIM_ADDR_M) ? _imuM : _imuXLG;
+		uint8_t *ptr = (addr == IMU_SIM_ADDR_M) ? &_imuPtrM : &_imuPtrXLG;
+
+		for (size_t i = 0; i < len; i++)
+			data[i] = regs[(*ptr)++];
+	}
+	else
+	{
+		return 0;
+	}
+
+	return len;
+}
+
+// charge the time taken to clock out the address byte and data bytes (9 clocks per byte)
+static void chargeBusTime(size_t numBytes)
+{
+	_i2cBytes += numBytes;
+	hostClock_advance(((uint64_t)numBytes * 9 * 1000000) / _i2cClock);
+}
+
+
+////////////////////////////// HOST CONTROL //////////////////////////////
+
+bool hostEEPROM_attachFile(const char *path)
+{
+	eepromInit();
+
+	_eepromFile = fopen(path, "r+b");
+
+	if (_eepromFile)
+	{
+		size_t n = fread(_eeprom, 1, sizeof(_eeprom), _eepromFile);
+		(void)n;
+	}
+	else
+	{
+		_eepromFile = fopen(path, "w+b");
+		eepromSave();
+	}
+
+	return (_eepromFile != NULL);
+}
+
+void hostEEPROM_erase(void)
+{
+	memset(_eeprom, 0xFF, sizeof(_eeprom));
+	_eepromInit = true;
+	eepromSave();
+}
+
+uint8_t *hostEEPROM_data(void)
+{
+	eepromInit();
+	return _eeprom;
+}
+
+void hostIMU_setTemp(float temp)
+{
+	imuInit();
+	setReg16(_imuXLG, IMU_SIM_OUT_TEMP_L, (int16_t)((temp - IMU_SIM_TEMP_ZERO) * IMU_SIM_TEMP_SENS));
+}
+
+void hostIMU_setRegs(uint8_t addr, uint8_t reg, const uint8_t *data, size_t len)
+{
+	imuInit();
+
+	uint8_t *regs = (addr == IMU_SIM_ADDR_M) ? _imuM : _imuXLG;
+
+	for (size_t i = 0; i < len; i++)
+		regs[(uint8_t)(reg + i)] = data[i];
+}
+
+void hostHANDle_setRaw(const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; (i < len) && (i < sizeof(_handle)); i++)
+		_handle[i] = data[i];
+}
+
+void hostHANDle_set(int joyX, int joyY, bool btnZ, bool btnC)
+{
+	_handle[0] = (uint8_t)constrain(joyX, 0, 255);
+	_handle[1] = (uint8_t)constrain(joyY, 0, 255);
+
+	// buttons are active low
+	_handle[5] = (_handle[5] & 0xFC) | (btnZ ? 0 : 0x01) | (btnC ? 0 : 0x02);
+}
+
+void hostI2C_setClock(uint32_t freq)
+{
+	if (freq)
+		_i2cClock = freq;
+}
+
+uint64_t hostI2C_numBytes(void)
+{
+	return _i2cBytes;
+}
+
+
+////////////////////////////// TwoWire //////////////////////////////
+
+TwoWire::TwoWire()
+{
+	_txAddr = 0;
+	_txLen = 0;
+	_transmitting = false;
+	_rxLen = 0;
+	_rxIndex = 0;
+}
+
+void TwoWire::begin(void)
+{
+
+}
+
+void TwoWire::end(void)
+{
+
+}
+
+void TwoWire::setClock(uint32_t freq)
+{
+	hostI2C_setClock(freq);
+}
+
+void TwoWire::beginTransmission(uint8_t addr)
+{
+	_txAddr = addr;
+	_txLen = 0;
+	_transmitting = true;
+}
+
+// returns 0 on success, 2 if the address was not acknowledged
+uint8_t TwoWire::endTransmission(bool stopBit)
+{
+	(void)stopBit;
+
+	if (!_transmitting)
+		return 4;
+
+	_transmitting = false;
+	chargeBusTime(1 + _txLen);
+
+	if (!devicePresent(_txAddr))
+		return 2;
+
+	deviceWrite(_txAddr, _txBuff, _txLen);
+	return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t addr, size_t quantity, bool stopBit)
+{
+	(void)stopBit;
+
+	if (quantity > WIRE_BUFFER_SIZE)
+		quantity = WIRE_BUFFER_SIZE;
+
+	_rxIndex = 0;
+	_rxLen = 0;
+
+	chargeBusTime(1);
+
+	if (!devicePresent(addr))
+		return 0;
+
+	_rxLen = deviceRead(addr, _rxBuff, quantity);
+	chargeBusTime(_rxLen);
+
+	return (uint8_t)_rxLen;
+}
+
+size_t TwoWire::write(uint8_t data)
+{
+	if (!_transmitting || (_txLen >= WIRE_BUFFER_SIZE))
+		return 0;
+
+	_txBuff[_txLen++] = data;
+	return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity)
+{
+	size_t n = 0;
+
+	for (size_t i = 0; i < quantity; i++)
+		n += write(data[i]);
+
+	return n;
+}
+
+int TwoWire::available(void)
+{
+	return (int)(_rxLen - _rxIndex);
+}
+
+int TwoWire::read(void)
+{
+	if (_rxIndex >= _rxLen)
+		return -1;
+
+	return _rxBuff[_rxIndex++];
+}
+
+int TwoWire::peek(void)
+{
+	if (_rxIndex >= _rxLen)
+		return -1;
+
+	return _rxBuff[_rxIndex];
+}
@@ -0,0 +1,652 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EMGBench.cpp
+*
+*/
+
+// Offline benchmark of the EMG detection, over a corpus of labelled recordings.
+// Each recording is a trace (A7, or --record from the host build) with a label file of the same name
+// (e.g. rest_1.bin & rest_1.labels), listing each intended contraction, one per line:
+//
+//		onset (ms from the start of the trace), channel, duration (ms), pulse | hold
+//
+// where a 'hold' is a contraction that is meant to change grip. Each recording is replayed through the firmware
+// (setup(), then EMG.run() every 1ms, so getSample(), analyseSignal() & control() are the real firmware code) in a
+// separate process, so every recording starts from the same state.
+//
+// A PEAK of the same channel from the onset of a labelled contraction until the tolerance after its end is a
+// detection, and the latency is measured from the onset to the sample that triggered the PEAK. Any other PEAK
+// (including a second PEAK within the same contraction) is a false positive, and a contraction without a PEAK is a
+// false negative. A PEAK before the onset is a false positive, as it was not caused by the contraction, and is also
+// counted as early if it is within the tolerance before the onset. A grip change within a 'hold' (from the onset)
+// is a detected HOLD, any other grip change is a HOLD misfire. The host CPU time of each EMG.run()
+// is measured, and divided by the number of samples. The results of each recording, and the total, are written
+// as CSV.
+//
+// e.g.	bin/emg_bench --dir corpus --thresh 246,226 --calibrated 1 > results.csv
+//
+// A labelled corpus of simulated contractions (mixed, weak & noisy) is generated by 'make corpus' (tools/gen_corpus.sh),
+// e.g. to compare the fixed threshold with the onset detector on both channels:
+//
+//		bin/emg_bench --dir corpus --hold 400				(1476 false positives, 17 early, 16.8ms mean latency)
+//		bin/emg_bench --dir corpus --hold 400 --onset 3		(0 false positives, 2.3ms mean latency)
+
+#include <Arduino.h>
+
+#include <dirent.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "HostHardware.h"
+
+#include "EMGControl.h"			// EMG
+#include "Grips.h"				// Grip
+#include "Initialisation.h"		// settings
+#include "Watchdog.h"			// Watchdog
+
+#define BENCH_MAX_FILES		256
+#define BENCH_MAX_LABELS	1024	// labels within each recording
+#define BENCH_TAIL_TIME		1000	// ms, run on after the last record, to detect a contraction at the end of a recording
+
+void setup(void);
+
+typedef struct _Label
+{
+	uint32_t onset;				// ms, from the start of the trace
+	uint32_t duration;			// ms
+	int ch;						// EMG channel
+	bool hold;					// the contraction is meant to change grip
+	bool detected;				// a PEAK has been matched to the contraction
+	bool held;					// a grip change has been matched to the contraction
+} Label;
+
+typedef struct _BenchResult
+{
+	bool valid;					// the recording was replayed
+	double duration;			// s, scored time (after the skip time)
+	uint32_t events;			// labelled contractions
+	uint32_t detected;			// contractions with a PEAK
+	uint32_t falsePos;			// PEAKs outside any contraction (including before its onset), or repeated within one
+	uint32_t earlyPos;			// false positives up to the tolerance before the onset of a contraction
+	uint32_t holds;				// labelled holds
+	uint32_t holdsDetected;		// holds with a grip change
+	uint32_t holdMisfires;		// grip changes outside any hold, or repeated within one
+	uint64_t samples;			// EMG samples (of every channel) replayed
+	uint64_t cpuTime;			// ns, host CPU time within EMG.run()
+	uint32_t numLatencies;		// number of latencies that follow the result
+} BenchResult;
+
+static const char *_files[BENCH_MAX_FILES];
+static int _numFiles = 0;
+
+static Label _labels[BENCH_MAX_LABELS];
+static int _numLabels = 0;
+
+static uint32_t _latency[BENCH_MAX_LABELS];		// us, of each detected contraction
+
+// options
+static EMGMode _mode = EMG_SIMPLE;
+static int _peakThresh[NUM_EMG_CHANNELS];	// -1 to keep the default
+static int _holdTime = -1;					// ms, -1 to keep the default
+static int _calibrated = -1;				// -1 to keep the default
+static int _onset = -1;						// bit per channel, -1 to keep the default
+static uint32_t _tolerance = 100;			// ms
+static uint32_t _skipTime = 1000;			// ms
+
+static void printUsage(const char *name)
+{
+	fprintf(stderr,
+		"usage: %s [options] --dir <dir> | <trace> [<trace> ...]\n"
+		"  --dir <dir>                      replay every trace (*.bin) within a directory that has a label file (*.labels)\n"
+		"  <trace>                          replay a trace, labelled by the file of the same name with a .labels extension\n"
+		"  --mode <1|2>                     EMG mode used for the replay, simple (M1) or proportional (M2) (default 1)\n"
+		"  --thresh <n>[,<n>...]            EMG peak threshold of each channel (U#, default from resetToDefaults())\n"
+		"  --hold <ms>                      muscle hold time (T#, default from resetToDefaults())\n"
+		"  --calibrated <0|1>               the thresholds follow any drift of the noise (E1)\n"
+		"  --onset <mask>                   bit per channel, the channel uses the adaptive onset detector (K#)\n"
+		"  --tol <ms>                       a PEAK up to this long after the end of a contraction is matched to the\n"
+		"                                   contraction (default 100), a PEAK before the onset is a false positive, counted\n"
+		"                                   as early if it is up to this long before the onset\n"
+		"  --skip <ms>                      ignore the start of each trace, while the noise floor settles (default 1000)\n"
+		"  --out <file>                     write the CSV to a file, rather than stdout\n",
+		name);
+}
+
+////////////////////////////// LABELS //////////////////////////////
+
+// read the label file of a trace, returns false if there is no label file
+static bool loadLabels(const char *trace)
+{
+	char path[1024];
+	const char *ext = strrchr(trace, '.');
+	size_t len = (ext && !strchr(ext, '/')) ? (size_t)(ext - trace) : strlen(trace);
+
+	snprintf(path, sizeof(path), "%.*s.labels", (int)len, trace);
+
+	FILE *file = fopen(path, "r");
+
+	if (!file)
+		return false;
+
+	char line[256];
+
+	_numLabels = 0;
+
+	while (fgets(line, sizeof(line), file) && (_numLabels < BENCH_MAX_LABELS))
+	{
+		unsigned int onset, duration;
+		int ch;
+		char kind[16];
+
+		if ((line[0] == '#') || (sscanf(line, "%u , %d , %u , %15s", &onset, &ch, &duration, kind) != 4))
+			continue;
+
+		if ((ch < 0) || (ch >= NUM_EMG_CHANNELS))
+		{
+			fprintf(stderr, "%s: channel %d is not valid (0 - %d)\n", path, ch, NUM_EMG_CHANNELS - 1);
+			continue;
+		}
+
+		Label *l = &_labels[_numLabels++];
+
+		l->onset = onset;
+		l->duration = duration;
+		l->ch = ch;
+		l->hold = !strcmp(kind, "hold");
+		l->detected = false;
+		l->held = false;
+	}
+
+	fclose(file);
+
+	return true;
+}
+
+// returns true if a time (ms) is within a labelled contraction, from the onset until the tolerance after the end
+static bool withinLabel(const Label *l, double t)
+{
+	return ((t >= (double)l->onset) && (t <= ((double)l->onset + l->duration + _tolerance)));
+}
+
+// returns true if a time (ms) is within the tolerance before the onset of a labelled contraction
+static bool beforeLabel(const Label *l, double t)
+{
+	return ((t < (double)l->onset) && (t >= ((double)l->onset - _tolerance)));
+}
+
+// match a PEAK of a channel at time t (ms) to a contraction
+static void scorePeak(int ch, double t, BenchResult *res)
+{
+	if (t < _skipTime)
+		return;
+
+	for (int i = 0; i < _numLabels; i++)
+	{
+		Label *l = &_labels[i];
+
+		if ((l->ch == ch) && !l->detected && withinLabel(l, t))
+		{
+			l->detected = true;
+			_latency[res->numLatencies++] = (uint32_t)((t - l->onset) * 1000);		// t >= onset
+			return;
+		}
+	}
+
+	// a PEAK before the onset is not caused by the contraction (e.g. noise), so it is a false positive,
+	// rather than a detection with a negative latency that would lower the mean
+	for (int i = 0; i < _numLabels; i++)
+	{
+		if ((_labels[i].ch == ch) && beforeLabel(&_labels[i], t))
+		{
+			res->earlyPos++;
+			break;
+		}
+	}
+
+	res->falsePos++;
+}
+
+// match a grip change at time t (ms) to a hold
+static void scoreGripChange(double t, BenchResult *res)
+{
+	if (t < _skipTime)
+		return;
+
+	for (int i = 0; i < _numLabels; i++)
+	{
+		Label *l = &_labels[i];
+
+		if (l->hold && !l->held && withinLabel(l, t))
+		{
+			l->held = true;
+			return;
+		}
+	}
+
+	res->holdMisfires++;
+}
+
+////////////////////////////// REPLAY //////////////////////////////
+
+static uint64_t cpuTime(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+	return ((uint64_t)ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+}
+
+// set the options that are given, on top of the settings loaded by setup()
+static void configure(void)
+{
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		if (_peakThresh[c] >= 0)
+			settings.emg.channel[c].peakThresh = _peakThresh[c];
+	}
+
+	if (_holdTime >= 0)
+		settings.emg.holdTime = _holdTime;
+
+	if (_calibrated >= 0)
+		settings.emg.calibrated = _calibrated;
+
+	if (_onset >= 0)
+	{
+		settings.emg.onset = _onset;
+
+		for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+		{
+			EMG.setDetector(c, (_onset & (1 << c)) ? EMG_DETECT_ONSET : EMG_DETECT_THRESHOLD);
+		}
+	}
+
+	EMG.updateThresholds();
+	EMG.setMode(_mode);
+}
+
+// replay a trace through the firmware, and score the PEAKs and grip changes against the labels
+static void replay(const char *trace, BenchResult *res)
+{
+	memset(res, 0, sizeof(BenchResult));
+
+	if (!hostTrace_replay(trace))
+		return;
+
+	SerialUSB.setEcho(false);
+
+	setup();
+	configure();
+
+	hostTrace_startReplay();
+
+	const uint64_t start = hostClock_now();		// us
+	uint32_t prevPeak[NUM_EMG_CHANNELS];
+	int prevGrip = Grip.getGrip();
+	uint64_t end = 0;
+
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		prevPeak[c] = EMG.getPeakTime(c);
+	}
+
+	// run the EMG task every 1ms, as while the muscles are active
+	while (!end || (hostClock_now() < end))
+	{
+		if (!end && !hostTrace_replaying())
+			end = hostClock_now() + (BENCH_TAIL_TIME * 1000ULL);
+
+		hostClock_advance(1000);
+		Watchdog.reset();
+
+		uint64_t t0 = cpuTime();
+		EMG.run();
+		res->cpuTime += cpuTime() - t0;
+
+		for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+		{
+			uint32_t peak = EMG.getPeakTime(c);
+
+			if (peak != prevPeak[c])
+			{
+				prevPeak[c] = peak;
+				scorePeak(c, (uint32_t)(peak - (uint32_t)start) / 1000.0, res);
+			}
+		}
+
+		int grip = Grip.getGrip();
+
+		if (grip != prevGrip)
+		{
+			prevGrip = grip;
+			scoreGripChange((hostClock_now() - start) / 1000.0, res);
+		}
+	}
+
+	uint64_t runTime = hostClock_now() - start;		// us
+
+	for (int i = 0; i < _numLabels; i++)
+	{
+		if (_labels[i].onset < _skipTime)
+			continue;
+
+		res->events++;
+		res->detected += _labels[i].detected;
+		res->holds += _labels[i].hold;
+		res->holdsDetected += _labels[i].held;
+	}
+
+	res->valid = true;
+	res->duration = (runTime > (_skipTime * 1000ULL)) ? ((runTime - (_skipTime * 1000ULL)) / 1e6) : 0;
+	res->samples = (runTime * EMG_SAMPLE_RATE) / 1000000;
+}
+
+// replay a trace in a child process, so that every trace starts from the same firmware state
+static bool runChild(const char *trace, BenchResult *res, uint32_t *latency)
+{
+	int fd[2];
+
+	if (pipe(fd) < 0)
+		return false;
+
+	fflush(NULL);
+
+	pid_t pid = fork();
+
+	if (pid < 0)
+		return false;
+
+	if (pid == 0)
+	{
+		close(fd[0]);
+
+		replay(trace, res);
+
+		bool ok = (write(fd[1], res, sizeof(BenchResult)) == sizeof(BenchResult)) &&
+			(write(fd[1], _latency, res->numLatencies * sizeof(uint32_t)) == (ssize_t)(res->numLatencies * sizeof(uint32_t)));
+
+		_exit(ok ? 0 : 1);
+	}
+
+	close(fd[1]);
+
+	bool ok = (read(fd[0], res, sizeof(BenchResult)) == sizeof(BenchResult)) && res->valid;
+
+	for (uint32_t n = 0; ok && (n < (res->numLatencies * sizeof(uint32_t))); )
+	{
+		ssize_t r = read(fd[0], (uint8_t *)latency + n, (res->numLatencies * sizeof(uint32_t)) - n);
+
+		if (r <= 0)
+			ok = false;
+		else
+			n += r;
+	}
+
+	close(fd[0]);
+	waitpid(pid, NULL, 0);
+
+	return ok;
+}
+
+////////////////////////////// RESULTS //////////////////////////////
+
+static int compareUint(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static int compareStr(const void *a, const void *b)
+{
+	return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+static void printHeader(FILE *out)
+{
+	fprintf(out, "recording,duration_s,events,detected,missed,false_pos,false_pos_early,fn_rate,fp_per_min,"
+		"latency_mean_ms,latency_p50_ms,latency_p95_ms,latency_max_ms,"
+		"holds,holds_detected,holds_missed,hold_misfires,samples,cpu_ns_per_sample\n");
+}
+
+static void printResult(FILE *out, const char *name, const BenchResult *res, uint32_t *latency)
+{
+	uint32_t n = res->numLatencies;
+	double mean = 0;
+
+	qsort(latency, n, sizeof(uint32_t), compareUint);
+
+	for (uint32_t i = 0; i < n; i++)
+	{
+		mean += latency[i];
+	}
+
+	if (n)
+		mean /= n;
+
+	fprintf(out, "%s,%.3f,%u,%u,%u,%u,%u,%.4f,%.3f,", name, res->duration, res->events, res->detected,
+		res->events - res->detected, res->falsePos, res->earlyPos, res->events ? ((double)(res->events - res->detected) / res->events) : 0.0,
+		(res->duration > 0) ? ((res->falsePos * 60.0) / res->duration) : 0.0);
+
+	if (n)
+	{
+		fprintf(out, "%.1f,%.1f,%.1f,%.1f,", mean / 1000.0, latency[((n - 1) * 50) / 100] / 1000.0,
+			latency[((n - 1) * 95) / 100] / 1000.0, latency[n - 1] / 1000.0);
+	}
+	else
+	{
+		fprintf(out, ",,,,");
+	}
+
+	fprintf(out, "%u,%u,%u,%u,%llu,%.1f\n", res->holds, res->holdsDetected, res->holds - res->holdsDetected,
+		res->holdMisfires, (unsigned long long)res->samples, res->samples ? ((double)res->cpuTime / res->samples) : 0.0);
+}
+
+// add every trace (*.bin) within a directory that has a label file
+static bool addDir(const char *dir)
+{
+	DIR *d = opendir(dir);
+
+	if (!d)
+		return false;
+
+	struct dirent *ent;
+	int first = _numFiles;
+
+	while ((ent = readdir(d)) && (_numFiles < BENCH_MAX_FILES))
+	{
+		size_t len = strlen(ent->d_name);
+
+		if ((len < 5) || strcmp(ent->d_name + len - 4, ".bin"))
+			continue;
+
+		char *path = (char *)malloc(strlen(dir) + len + 2);
+
+		sprintf(path, "%s/%s", dir, ent->d_name);
+		_files[_numFiles++] = path;
+	}
+
+	closedir(d);
+
+	qsort(&_files[first], _numFiles - first, sizeof(const char *), compareStr);
+
+	return true;
+}
+
+////////////////////////////// MAIN //////////////////////////////
+
+int main(int argc, char **argv)
+{
+	const char *outPath = NULL;
+
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		_peakThresh[c] = -1;
+	}
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char *arg = argv[i];
+		const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+		if (!strcmp(arg, "--help"))
+		{
+			printUsage(argv[0]);
+			return 0;
+		}
+		else if (arg[0] != '-')
+		{
+			if (_numFiles < BENCH_MAX_FILES)
+				_files[_numFiles++] = arg;
+			continue;
+		}
+		else if (!val)
+		{
+			printUsage(argv[0]);
+			return 1;
+		}
+
+		i++;
+
+		if (!strcmp(arg, "--dir"))
+		{
+			if (!addDir(val))
+			{
+				fprintf(stderr, "could not read %s\n", val);
+				return 1;
+			}
+		}
+		else if (!strcmp(arg, "--mode"))
+		{
+			_mode = (atoi(val) == 2) ? EMG_PROPORTIONAL : EMG_SIMPLE;
+		}
+		else if (!strcmp(arg, "--thresh"))
+		{
+			// a single threshold for every channel, or a comma separated threshold of each channel
+			const char *p = val;
+
+			for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+			{
+				char *end;
+
+				_peakThresh[c] = (int)strtol(p, &end, 10);
+
+				if (*end != ',')
+					break;
+				p = end + 1;
+			}
+
+			if (!strchr(val, ','))
+			{
+				for (int c = 1; c < NUM_EMG_CHANNELS; c++)
+				{
+					_peakThresh[c] = _peakThresh[0];
+				}
+			}
+		}
+		else if (!strcmp(arg, "--hold"))
+		{
+			_holdTime = atoi(val);
+		}
+		else if (!strcmp(arg, "--calibrated"))
+		{
+			_calibrated = (atoi(val) != 0);
+		}
+		else if (!strcmp(arg, "--onset"))
+		{
+			_onset = strtoul(val, NULL, 0);
+		}
+		else if (!strcmp(arg, "--tol"))
+		{
+			_tolerance = strtoul(val, NULL, 10);
+		}
+		else if (!strcmp(arg, "--skip"))
+		{
+			_skipTime = strtoul(val, NULL, 10);
+		}
+		else if (!strcmp(arg, "--out"))
+		{
+			outPath = val;
+		}
+		else
+		{
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (!_numFiles)
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	FILE *out = outPath ? fopen(outPath, "w") : stdout;
+
+	if (!out)
+	{
+		fprintf(stderr, "could not write %s\n", outPath);
+		return 1;
+	}
+
+	static uint32_t all[BENCH_MAX_FILES * BENCH_MAX_LABELS];		// us, latency of every detected contraction
+	BenchResult total;
+	int numFailed = 0;
+
+	memset(&total, 0, sizeof(total));
+	printHeader(out);
+
+	for (int f = 0; f < _numFiles; f++)
+	{
+		BenchResult res;
+
+		if (!loadLabels(_files[f]))
+		{
+			fprintf(stderr, "%s: no label file, skipped\n", _files[f]);
+			continue;
+		}
+
+		if (!runChild(_files[f], &res, &all[total.numLatencies]))
+		{
+			fprintf(stderr, "%s: replay failed\n", _files[f]);
+			numFailed++;
+			continue;
+		}
+
+		uint32_t latency[BENCH_MAX_LABELS];
+
+		memcpy(latency, &all[total.numLatencies], res.numLatencies * sizeof(uint32_t));
+		printResult(out, _files[f], &res, latency);
+
+		total.duration += res.duration;
+		total.events += res.events;
+		total.detected += res.detected;
+		total.falsePos += res.falsePos;
+		total.earlyPos += res.earlyPos;
+		total.holds += res.holds;
+		total.holdsDetected += res.holdsDetected;
+		total.holdMisfires += res.holdMisfires;
+		total.samples += res.samples;
+		total.cpuTime += res.cpuTime;
+		total.numLatencies += res.numLatencies;
+	}
+
+	printResult(out, "TOTAL", &total, all);
+
+	if (outPath)
+		fclose(out);
+
+	return numFailed ? 1 : 0;
+}
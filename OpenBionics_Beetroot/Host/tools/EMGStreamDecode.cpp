@@ -0,0 +1,261 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EMGStreamDecode.cpp
+*
+*/
+
+// Decodes the binary EMG stream (M4, see EMGStream.h) from a raw serial capture (or a host --record file) to CSV,
+// one line per frame:
+//
+//		seq, time_us, { sample, noise, peak, hold, active } x channels
+//
+// The number of frames lost (gaps in the sequence number) and the effective sample rate are reported on stderr.
+//
+// e.g.	bin/emg_decode capture.bin > emg.csv
+
+#include <Arduino.h>
+
+#include "EMGStream.h"			// stream format
+#include "Trace.h"				// SLIP framing
+
+#define DECODE_MAX_BODY_SIZE	EMG_STREAM_PACKET_SIZE		// max size of a batch body, after removing the escaping
+
+typedef struct _DecodeStats
+{
+	uint64_t numBatches;		// batches decoded
+	uint64_t numFrames;			// frames decoded
+	uint64_t numLost;			// frames missing from the sequence
+	uint64_t numBad;			// batches that do not match the firmware format
+	bool first;					// no frames have been decoded yet
+	uint16_t prevSeq;			// sequence number of the previous frame
+	uint32_t firstTime;			// us, time of the first frame
+	uint32_t prevTime;			// us, time of the previous frame
+	uint64_t duration;			// us, time from the first to the most recent frame
+} DecodeStats;
+
+static void printUsage(const char *name)
+{
+	fprintf(stderr,
+		"usage: %s [options] <capture>\n"
+		"  <capture>                        raw serial capture, or host --record file, of the EMG stream (M4)\n"
+		"  --out <file>                     write the CSV to a file, rather than stdout\n",
+		name);
+}
+
+static uint16_t readU16(const uint8_t *data)
+{
+	return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+static uint32_t readU32(const uint8_t *data)
+{
+	return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static void printHeader(FILE *out, int numChannels)
+{
+	fprintf(out, "seq,time_us");
+
+	for (int c = 0; c < numChannels; c++)
+	{
+		fprintf(out, ",sample%d,noise%d,peak%d,hold%d,active%d", c, c, c, c, c);
+	}
+
+	fprintf(out, "\n");
+}
+
+// decode the frames of a batch body, ignoring any other SLIP frames (trace records)
+static void decodeBatch(FILE *out, const uint8_t *body, size_t len, DecodeStats *stats)
+{
+	if ((len < EMG_STREAM_HEADER_SIZE) || (body[0] != EMG_STREAM_ID))
+		return;
+
+	int numChannels = body[1];
+	int numFrames = body[2];
+	size_t frameSize = 6 + (5 * numChannels);
+
+	if ((numChannels < 1) || (numChannels > EMG_MAX_CHANNELS) || (len != (EMG_STREAM_HEADER_SIZE + (numFrames * frameSize))))
+	{
+		stats->numBad++;
+		return;
+	}
+
+	if (stats->first)
+		printHeader(out, numChannels);
+
+	stats->numBatches++;
+
+	for (int f = 0; f < numFrames; f++)
+	{
+		const uint8_t *frame = body + EMG_STREAM_HEADER_SIZE + (f * frameSize);
+		uint16_t seq = readU16(frame);
+		uint32_t time = readU32(frame + 2);
+
+		if (stats->first)
+		{
+			stats->first = false;
+			stats->firstTime = time;
+		}
+		else
+		{
+			stats->numLost += (uint16_t)(seq - stats->prevSeq - 1);
+			stats->duration += (uint32_t)(time - stats->prevTime);		// wraps every ~71 minutes
+		}
+
+		stats->prevSeq = seq;
+		stats->prevTime = time;
+		stats->numFrames++;
+
+		fprintf(out, "%u,%u", seq, time);
+
+		for (int c = 0; c < numChannels; c++)
+		{
+			const uint8_t *ch = frame + 6 + (c * 5);
+			uint8_t flags = ch[4];
+
+			fprintf(out, ",%u,%u,%d,%d,%d", readU16(ch), readU16(ch + 2),
+				(flags & EMG_STREAM_PEAK) ? 1 : 0, (flags & EMG_STREAM_HOLD) ? 1 : 0, (flags & EMG_STREAM_ACTIVE) ? 1 : 0);
+		}
+
+		fprintf(out, "\n");
+	}
+}
+
+// separate the SLIP frames from the serial text, and decode each batch
+static bool decodeFile(FILE *out, const char *path, DecodeStats *stats)
+{
+	FILE *file = fopen(path, "rb");
+
+	if (!file)
+		return false;
+
+	uint8_t body[DECODE_MAX_BODY_SIZE + EMG_STREAM_FRAME_SIZE];
+	size_t len = 0;
+	bool inFrame = false;
+	bool esc = false;
+	bool overflow = false;
+	int c;
+
+	while ((c = fgetc(file)) != EOF)
+	{
+		if (c == TRACE_END)
+		{
+			if (inFrame && !overflow)
+				decodeBatch(out, body, len, stats);
+			else if (inFrame && (body[0] == EMG_STREAM_ID))
+				stats->numBad++;
+
+			inFrame = !inFrame;
+			len = 0;
+			esc = false;
+			overflow = false;
+		}
+		else if (inFrame)
+		{
+			if (esc)
+			{
+				c = (c == TRACE_ESC_END) ? TRACE_END : TRACE_ESC;
+				esc = false;
+			}
+			else if (c == TRACE_ESC)
+			{
+				esc = true;
+				continue;
+			}
+
+			if (len < sizeof(body))
+				body[len++] = (uint8_t)c;
+			else
+				overflow = true;
+		}
+	}
+
+	fclose(file);
+
+	return true;
+}
+
+////////////////////////////// MAIN //////////////////////////////
+
+int main(int argc, char **argv)
+{
+	const char *inPath = NULL;
+	const char *outPath = NULL;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char *arg = argv[i];
+
+		if (!strcmp(arg, "--help"))
+		{
+			printUsage(argv[0]);
+			return 0;
+		}
+		else if (!strcmp(arg, "--out") && (i + 1 < argc))
+		{
+			outPath = argv[++i];
+		}
+		else if ((arg[0] != '-') && !inPath)
+		{
+			inPath = arg;
+		}
+		else
+		{
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (!inPath)
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	FILE *out = outPath ? fopen(outPath, "w") : stdout;
+
+	if (!out)
+	{
+		fprintf(stderr, "could not write %s\n", outPath);
+		return 1;
+	}
+
+	DecodeStats stats;
+
+	memset(&stats, 0, sizeof(stats));
+	stats.first = true;
+
+	if (!decodeFile(out, inPath, &stats))
+	{
+		fprintf(stderr, "could not read %s\n", inPath);
+		return 1;
+	}
+
+	if (outPath)
+		fclose(out);
+
+	// the lost frames are included in the rate, as they were sampled but not received
+	double secs = stats.duration / 1000000.0;
+	uint64_t total = stats.numFrames + stats.numLost;
+
+	fprintf(stderr, "%llu frames in %llu batches, %llu lost (%.2f%%), %llu bad batches\n",
+		(unsigned long long)stats.numFrames, (unsigned long long)stats.numBatches, (unsigned long long)stats.numLost,
+		total ? ((100.0 * stats.numLost) / total) : 0.0, (unsigned long long)stats.numBad);
+
+	if (secs > 0)
+	{
+		fprintf(stderr, "%.3fs, %.1f frames/s received, %.1f frames/s sampled\n",
+			secs, (stats.numFrames - 1) / secs, (total - 1) / secs);
+	}
+
+	return (stats.numFrames > 0) ? 0 : 1;
+}
@@ -0,0 +1,310 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	GripBench.cpp
+*
+*/
+
+// Microbenchmark of Grip.run(), against a search based implementation that finds the keyframes of each finger
+// (default_Grips) either side of the grip position on every call, as run() did before the grips were compiled into segments.
+// The finger positions of both are first compared at every count value of every grip, then each is timed over every
+// count value of every grip, 'repeat' times, and the host CPU time per call (of all fingers) is printed.
+// The lookup of the finger positions (Grip.getFingerPos()) is timed on its own, then with the writes of the finger
+// positions & speeds through the trajectories (disabled) and FingerCache, which are the same for both and are most of
+// the time of a run() (the search based run() does the same other work as Grip.run()). The time of Grip.setGrip(),
+// which compiles the selected grip, and the RAM of a compiled grip are printed separately.
+// Grip blends (Grip.setBlend()) are checked to match the blend grip at full weight, then Grip.run() is timed with
+// each grip blended half way towards the next grip.
+//
+// e.g.	bin/grip_bench --repeat 20000
+
+#include <Arduino.h>
+
+#include <time.h>
+
+#include "Grips.h"				// Grip, default_Grips
+#include "LatencyTracer.h"		// Latency
+#include "Trajectory.h"			// Trajectory
+
+#define BENCH_DEFAULT_REPEAT	10000
+
+static uint64_t cpuTime(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+	return ((uint64_t)ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+}
+
+static volatile int sink;		// the sum of the looked up finger positions, so that the lookups are not optimised away
+
+// a search based finger position, as before the grips were compiled into segments, finding the keyframes either side
+// of the grip position on every call
+static int searchPos(int gNum, uint16_t pos, int fingerNum)
+{
+	const GripKey *key = default_Grips[gNum].key[fingerNum];
+	int k = 0;
+
+	// search for the keyframe at or below the grip position, that is not the last keyframe
+	while (((k + 2) < GRIP_MAX_KEYS) && (key[k + 2].pos != 0) && (pos > key[k + 1].count))
+	{
+		k++;
+	}
+
+	return map(pos, key[k].count, key[k + 1].count, key[k].pos, key[k + 1].pos);
+}
+
+// a search based run(), writing the search based position of each finger, with the same other work as Grip.run()
+static void searchRun(int gNum, uint16_t pos, uint16_t speed)
+{
+	bool moving = false;
+
+	for (int fingerNum = 0; fingerNum < NUM_FINGERS; fingerNum++)
+	{
+		Trajectory.writePos(fingerNum, searchPos(gNum, pos, fingerNum));
+		Trajectory.writeSpeed(fingerNum, speed);
+
+		moving |= Trajectory.moving(fingerNum);
+	}
+
+	if (!moving)
+		Latency.cancel();
+
+	Grip._dir = (pos > (GRIP_CLOSE / 2)) ? CLOSE : OPEN;
+}
+
+// compare the finger positions of Grip.run() and searchRun() at every count value of every grip, returns the number of differences
+static int compare(void)
+{
+	int numDiff = 0;
+
+	for (int gNum = 0; gNum < NUM_GRIPS; gNum++)
+	{
+		Grip.setGrip(gNum);
+
+		for (int pos = 0; pos <= GRIP_MAX_COUNT_VAL; pos++)
+		{
+			int expected[NUM_FINGERS];
+
+			searchRun(gNum, pos, MAX_FINGER_PWM);
+
+			for (int f = 0; f < NUM_FINGERS; f++)
+			{
+				expected[f] = finger[f].readTargetPos();
+			}
+
+			Grip.setPos(pos);
+			Grip.run();
+
+			for (int f = 0; f < NUM_FINGERS; f++)
+			{
+				if (finger[f].readTargetPos() != expected[f])
+				{
+					if (numDiff < 10)
+						printf("%s, count %d, F%d: %d (search %d)\n", Grip.getGripName(), pos, f, finger[f].readTargetPos(), expected[f]);
+					numDiff++;
+				}
+			}
+		}
+	}
+
+	return numDiff;
+}
+
+// compare the finger positions of each grip blended fully towards the next grip with those of the next grip, returns the number of differences
+static int compareBlend(void)
+{
+	int numDiff = 0;
+
+	for (int gNum = 0; gNum < NUM_GRIPS; gNum++)
+	{
+		int nextNum = (gNum + 1) % NUM_GRIPS;
+
+		for (int pos = 0; pos <= GRIP_MAX_COUNT_VAL; pos++)
+		{
+			int expected[NUM_FINGERS];
+
+			Grip.setGrip(nextNum);
+			Grip.setPos(pos);
+			Grip.run();
+
+			for (int f = 0; f < NUM_FINGERS; f++)
+			{
+				expected[f] = finger[f].readTargetPos();
+			}
+
+			Grip.setGrip(gNum);
+			Grip.setBlend(nextNum, GRIP_BLEND_MAX);
+			Grip.run();
+
+			for (int f = 0; f < NUM_FINGERS; f++)
+			{
+				if (finger[f].readTargetPos() != expected[f])
+				{
+					if (numDiff < 10)
+						printf("%s -> %s, count %d, F%d: %d (expected %d)\n", Grip.getGripName(gNum), Grip.getGripName(nextNum), pos, f, finger[f].readTargetPos(), expected[f]);
+					numDiff++;
+				}
+			}
+		}
+	}
+
+	return numDiff;
+}
+
+static void printUsage(const char *name)
+{
+	printf("Usage: %s [--repeat N]\n", name);
+	printf("  --repeat N     number of times every count value of every grip is run (default %d)\n", BENCH_DEFAULT_REPEAT);
+}
+
+////////////////////////////// MAIN //////////////////////////////
+
+int main(int argc, char **argv)
+{
+	long repeat = BENCH_DEFAULT_REPEAT;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--repeat") && ((i + 1) < argc))
+		{
+			repeat = atol(argv[++i]);
+		}
+		else
+		{
+			printUsage(argv[0]);
+			return !strcmp(argv[i], "--help") ? 0 : 1;
+		}
+	}
+
+	if (repeat < 1)
+		repeat = 1;
+
+	Grip.begin();
+
+	int numDiff = compare();
+	printf("%d grips, %d count values, %d differences\n", NUM_GRIPS, GRIP_MAX_COUNT_VAL + 1, numDiff);
+
+	int numBlendDiff = compareBlend();
+	printf("%d grip blends, %d count values, %d differences\n", NUM_GRIPS, GRIP_MAX_COUNT_VAL + 1, numBlendDiff);
+	numDiff += numBlendDiff;
+
+	double numCalls = (double)repeat * NUM_GRIPS * (GRIP_MAX_COUNT_VAL + 1);
+	int sum = 0;
+
+	// lookup of the finger positions only
+	uint64_t t0 = cpuTime();
+	for (long r = 0; r < repeat; r++)
+	{
+		for (int gNum = 0; gNum < NUM_GRIPS; gNum++)
+		{
+			for (int pos = 0; pos <= GRIP_MAX_COUNT_VAL; pos++)
+			{
+				for (int f = 0; f < NUM_FINGERS; f++)
+				{
+					sum += searchPos(gNum, pos, f);
+				}
+			}
+		}
+	}
+	uint64_t searchLookupTime = cpuTime() - t0;
+
+	// the grip is compiled when it is selected, and the blend grip is compiled by the first setBlend(), so neither is timed here
+	uint64_t tableLookupTime = 0;
+	uint64_t blendLookupTime = 0;
+
+	for (int gNum = 0; gNum < NUM_GRIPS; gNum++)
+	{
+		Grip.setGrip(gNum);
+
+		t0 = cpuTime();
+		for (long r = 0; r < repeat; r++)
+		{
+			for (int pos = 0; pos <= GRIP_MAX_COUNT_VAL; pos++)
+			{
+				Grip.setPos(pos);
+
+				for (int f = 0; f < NUM_FINGERS; f++)
+				{
+					sum += Grip.getFingerPos(f);
+				}
+			}
+		}
+		tableLookupTime += cpuTime() - t0;
+
+		// blended half way towards the next grip
+		Grip.setBlend((gNum + 1) % NUM_GRIPS, GRIP_BLEND_MAX / 2);
+
+		t0 = cpuTime();
+		for (long r = 0; r < repeat; r++)
+		{
+			for (int pos = 0; pos <= GRIP_MAX_COUNT_VAL; pos++)
+			{
+				Grip.setPos(pos);
+
+				for (int f = 0; f < NUM_FINGERS; f++)
+				{
+					sum += Grip.getFingerPos(f);
+				}
+			}
+		}
+		blendLookupTime += cpuTime() - t0;
+	}
+
+	sink = sum;
+
+	// lookup & writes of the finger positions
+	t0 = cpuTime();
+	for (long r = 0; r < repeat; r++)
+	{
+		for (int gNum = 0; gNum < NUM_GRIPS; gNum++)
+		{
+			for (int pos = 0; pos <= GRIP_MAX_COUNT_VAL; pos++)
+			{
+				searchRun(gNum, pos, MAX_FINGER_PWM);
+			}
+		}
+	}
+	uint64_t searchRunTime = cpuTime() - t0;
+
+	uint64_t tableRunTime = 0;
+	uint64_t selectTime = 0;
+
+	for (int gNum = 0; gNum < NUM_GRIPS; gNum++)
+	{
+		t0 = cpuTime();
+		for (long r = 0; r < repeat; r++)
+		{
+			Grip.setGrip(gNum);
+		}
+		selectTime += cpuTime() - t0;
+
+		t0 = cpuTime();
+		for (long r = 0; r < repeat; r++)
+		{
+			for (int pos = 0; pos <= GRIP_MAX_COUNT_VAL; pos++)
+			{
+				Grip.setPos(pos);
+				Grip.run();
+			}
+		}
+		tableRunTime += cpuTime() - t0;
+	}
+
+	printf("lookup                    search %6.1f, segments %6.1f, segments (blended) %6.1f ns/call\n",
+		searchLookupTime / numCalls, tableLookupTime / numCalls, blendLookupTime / numCalls);
+	printf("lookup & writes (run())   search %6.1f, segments %6.1f ns/call\n", searchRunTime / numCalls, tableRunTime / numCalls);
+	printf("setGrip (compile)         %.1f ns/call\n", selectTime / ((double)repeat * NUM_GRIPS));
+	printf("compiled grip RAM         %d bytes, x2 (current & blend grip)\n", (int)sizeof(GripType));
+
+	return numDiff ? 1 : 0;
+}
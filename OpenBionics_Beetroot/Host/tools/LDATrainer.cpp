@@ -0,0 +1,723 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	LDATrainer.cpp
+*
+*/
+
+// Trains the EMG grip classifier (EMGClassifier.h) from trace recordings (A7) of each gesture.
+// The raw EMG samples within each trace are passed through the same noise floor removal (or band-pass filter) and
+// EMG_FEATURES window as the firmware, so the classifier is trained on the features the hand will see. A linear
+// discriminant is then fitted to the features (standardised, with a pooled and regularised covariance), scaled to
+// integers, checked against the training data using the integer maths of EMG_CLASSIFIER::classify(), and written
+// out as serial commands to upload the model (B3).
+//
+// e.g.	bin/lda_train --class -1:rest.bin --class 0:fist.bin --class 3:point.bin > model.txt
+
+#include <Arduino.h>
+
+#include <math.h>
+
+#include "EMGClassifier.h"		// LDAModel
+#include "EMGControl.h"			// EMG settings
+#include "Grips.h"				// NUM_GRIPS
+#include "Trace.h"				// trace format
+
+#define LDA_MAX_FILES		32
+#define LDA_LINE_LEN		60		// max length of each upload line (less than SERIAL_BUFF_SIZE)
+#define LDA_WEIGHT_BITS		30		// largest weight/bias is scaled to 2^LDA_WEIGHT_BITS
+
+typedef struct _TraceFile
+{
+	int grip;					// grip number, or CLASSIFIER_REST
+	const char *path;
+} TraceFile;
+
+typedef struct _FeatureSet
+{
+	int cls;							// class number
+	int32_t x[CLASSIFIER_NUM_INPUTS];	// features of every channel
+} FeatureSet;
+
+static TraceFile _files[LDA_MAX_FILES];
+static int _numFiles = 0;
+
+static int _classGrip[CLASSIFIER_MAX_CLASSES];
+static int _numClasses = 0;
+
+static FeatureSet *_sets = NULL;
+static size_t _numSets = 0;
+
+// options
+static int _peakThresh[NUM_EMG_CHANNELS];	// U#, or calibrated (E1), of each channel
+static bool _calibrated = false;		// the thresholds follow any drift of the noise floor
+static uint32_t _skipTime = 1000;		// ms
+static double _ridge = 0.01;
+
+#if defined(USE_EMG_FILTER)
+static constexpr BiquadCoeffs emgFilterCoeffs[EMG_FILTER_STAGES] =
+{
+	biquadHighPass(EMG_SAMPLE_RATE, EMG_FILTER_HP_FREQ, BIQUAD_Q_BUTTERWORTH),
+	biquadNotch(EMG_SAMPLE_RATE, EMG_FILTER_NOTCH_FREQ, EMG_FILTER_NOTCH_Q),
+	biquadLowPass(EMG_SAMPLE_RATE, EMG_FILTER_LP_FREQ, BIQUAD_Q_BUTTERWORTH)
+};
+#endif
+
+// the signal chain of a single channel, as EMG_CONTROL::getSample() & extractFeatures()
+typedef struct _TrainChannel
+{
+	STATS_WINDOW <int, NOISE_BUFFER_BITS> noiseFloor;
+	int peakThresh;					// the setting, raised by any drift of the noise floor
+#if defined(USE_EMG_FILTER)
+	BIQUAD_CHAIN <EMG_FILTER_STAGES> filter;
+	STATS_WINDOW <int, EMG_ENVELOPE_BITS> envelope;
+#endif
+	EMG_FEATURES <EMG_FEATURE_WINDOW_BITS> features;
+} TrainChannel;
+
+static void printUsage(const char *name)
+{
+	fprintf(stderr,
+		"usage: %s [options] --class <grip>:<file> [--class <grip>:<file> ...]\n"
+		"  --class <grip>:<file>            trace (A7) of a gesture, grip number (G#) or -1 for rest\n"
+		"                                   (a grip can be given more than once, to train on several traces)\n"
+		"  --thresh <n>[,<n>...]            EMG peak threshold of each channel used while recording (E, default 600)\n"
+		"  --calibrated <0|1>               the thresholds were calibrated (E1), so follow any drift of the noise (default 0)\n"
+		"  --skip <ms>                      ignore the start of each trace, while the noise floor settles (default 1000)\n"
+		"  --ridge <r>                      regularisation added to the covariance (default 0.01)\n"
+		"  --out <file>                     write the upload commands to a file, rather than stdout\n",
+		name);
+}
+
+////////////////////////////// FEATURES //////////////////////////////
+
+static uint32_t readVarint(const uint8_t *data, size_t len, size_t *pos)
+{
+	uint32_t val = 0;
+	uint8_t shift = 0;
+
+	while ((*pos < len) && (shift < 32))
+	{
+		uint8_t b = data[(*pos)++];
+
+		val |= (uint32_t)(b & 0x7F) << shift;
+		shift += 7;
+
+		if (!(b & 0x80))
+			break;
+	}
+
+	return val;
+}
+
+static void addSet(int cls, TrainChannel *ch)
+{
+	static size_t capacity = 0;
+
+	if (_numSets >= capacity)
+	{
+		capacity = capacity ? (capacity * 2) : 1024;
+		_sets = (FeatureSet *)realloc(_sets, capacity * sizeof(FeatureSet));
+	}
+
+	FeatureSet *set = &_sets[_numSets++];
+
+	set->cls = cls;
+
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		memcpy(&set->x[c * NUM_EMG_FEATURES], ch[c].features.read(), NUM_EMG_FEATURES * sizeof(int32_t));
+	}
+}
+
+// run a TRACE_EMG record through the signal chain of each channel
+static void addSamples(int cls, TrainChannel *ch, const uint8_t *data, size_t len, bool keep)
+{
+	size_t pos = 1;
+	bool ready = false;
+
+	if (!len || (data[0] < NUM_EMG_CHANNELS))
+		return;
+
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		int level = (int)readVarint(data, len, &pos);
+		int filtered;
+
+#if defined(USE_EMG_FILTER)
+		filtered = ch[c].filter.run((int32_t)level << EMG_FILTER_SHIFT) >> EMG_FILTER_SHIFT;
+
+#if defined(EMG_ENVELOPE_RMS)
+		ch[c].envelope.write(filtered);
+		level = (int)sqrt((double)ch[c].envelope.readMeanSquare());
+#else
+		ch[c].envelope.write(abs(filtered));
+		level = ch[c].envelope.readMean();
+#endif
+#endif
+
+		// EMG_CONTROL::calcNoiseFloor()
+		if (level < (ch[c].noiseFloor.readMean() + (ch[c].peakThresh / 3)))
+			ch[c].noiseFloor.write(level);
+
+#if !defined(USE_EMG_FILTER)
+		filtered = level - ch[c].noiseFloor.readMean();
+#endif
+
+		if (ch[c].features.write(filtered))
+			ready = true;
+	}
+
+	if (!ready)
+		return;
+
+	// EMG_CONTROL::updateThresholds()
+	for (int c = 0; (c < NUM_EMG_CHANNELS) && _calibrated; c++)
+	{
+		int noise = EMG_DRIFT_SIGMAS * (int)sqrt((double)ch[c].noiseFloor.readVariance());
+
+		ch[c].peakThresh = (noise > _peakThresh[c]) ? noise : _peakThresh[c];
+	}
+
+	if (keep)
+		addSet(cls, ch);
+}
+
+// decode a trace file, and add the features of every EMG record to the class
+static bool loadTrace(int cls, const char *path)
+{
+	FILE *file = fopen(path, "rb");
+
+	if (!file)
+		return false;
+
+	TrainChannel *ch = new TrainChannel[NUM_EMG_CHANNELS];
+
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		for (int i = 0; i < NOISE_BUFFER_SIZE; i++)
+		{
+			ch[c].noiseFloor.write(BUFFER_DEFAULT_VAL);
+		}
+
+		ch[c].peakThresh = _peakThresh[c];
+
+		ch[c].features.begin(EMG_FEATURE_HOP, EMG_FEATURE_ZC_THRESH, EMG_FEATURE_SSC_THRESH);
+
+#if defined(USE_EMG_FILTER)
+		ch[c].filter.begin(emgFilterCoeffs);
+#endif
+	}
+
+	uint8_t body[TRACE_MAX_BODY_SIZE];
+	size_t len = 0;
+	bool inFrame = false;
+	bool esc = false;
+	uint64_t time = 0;
+	int c;
+
+	while ((c = fgetc(file)) != EOF)
+	{
+		if (c == TRACE_END)
+		{
+			if (inFrame && (len >= 2) && (body[0] < NUM_TRACE_TYPES))
+			{
+				size_t pos = 1;
+
+				time += readVarint(body, len, &pos);
+
+				if (body[0] == TRACE_EMG)
+					addSamples(cls, ch, body + pos, len - pos, (time >= ((uint64_t)_skipTime * 1000)));
+			}
+
+			inFrame = !inFrame;
+			len = 0;
+			esc = false;
+		}
+		else if (inFrame)
+		{
+			if (esc)
+			{
+				c = (c == TRACE_ESC_END) ? TRACE_END : TRACE_ESC;
+				esc = false;
+			}
+			else if (c == TRACE_ESC)
+			{
+				esc = true;
+				continue;
+			}
+
+			if (len < sizeof(body))
+				body[len++] = (uint8_t)c;
+		}
+	}
+
+	fclose(file);
+	delete[] ch;
+
+	return true;
+}
+
+////////////////////////////// TRAINING //////////////////////////////
+
+// solve A.x = b by Gaussian elimination with partial pivoting (A and b are overwritten)
+static bool solve(double A[][CLASSIFIER_NUM_INPUTS], double *b, double *x)
+{
+	const int n = CLASSIFIER_NUM_INPUTS;
+
+	for (int col = 0; col < n; col++)
+	{
+		int pivot = col;
+
+		for (int r = col + 1; r < n; r++)
+		{
+			if (fabs(A[r][col]) > fabs(A[pivot][col]))
+				pivot = r;
+		}
+
+		if (fabs(A[pivot][col]) < 1e-12)
+			return false;
+
+		if (pivot != col)
+		{
+			for (int k = 0; k < n; k++)
+			{
+				double t = A[col][k];
+				A[col][k] = A[pivot][k];
+				A[pivot][k] = t;
+			}
+			double t = b[col];
+			b[col] = b[pivot];
+			b[pivot] = t;
+		}
+
+		for (int r = col + 1; r < n; r++)
+		{
+			double f = A[r][col] / A[col][col];
+
+			for (int k = col; k < n; k++)
+			{
+				A[r][k] -= f * A[col][k];
+			}
+			b[r] -= f * b[col];
+		}
+	}
+
+	for (int r = n - 1; r >= 0; r--)
+	{
+		double sum = b[r];
+
+		for (int k = r + 1; k < n; k++)
+		{
+			sum -= A[r][k] * x[k];
+		}
+		x[r] = sum / A[r][r];
+	}
+
+	return true;
+}
+
+// fit the discriminant of each class, and scale it to integers
+static bool train(LDAModel *model)
+{
+	const int n = CLASSIFIER_NUM_INPUTS;
+	double mean[n] = { 0 };
+	double scale[n] = { 0 };
+	double classMean[CLASSIFIER_MAX_CLASSES][n] = { { 0 } };
+	size_t classCount[CLASSIFIER_MAX_CLASSES] = { 0 };
+	static double cov[n][n];
+
+	// standardise each feature, so that the ridge is the same for every feature
+	for (size_t s = 0; s < _numSets; s++)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			mean[i] += _sets[s].x[i];
+		}
+	}
+	for (int i = 0; i < n; i++)
+	{
+		mean[i] /= _numSets;
+	}
+	for (size_t s = 0; s < _numSets; s++)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			scale[i] += (_sets[s].x[i] - mean[i]) * (_sets[s].x[i] - mean[i]);
+		}
+	}
+	for (int i = 0; i < n; i++)
+	{
+		scale[i] = sqrt(scale[i] / _numSets);
+
+		if (scale[i] < 1e-9)
+			scale[i] = 1;		// constant feature
+	}
+
+	// class means & pooled covariance of the standardised features
+	for (size_t s = 0; s < _numSets; s++)
+	{
+		int k = _sets[s].cls;
+
+		classCount[k]++;
+
+		for (int i = 0; i < n; i++)
+		{
+			classMean[k][i] += (_sets[s].x[i] - mean[i]) / scale[i];
+		}
+	}
+	for (int k = 0; k < _numClasses; k++)
+	{
+		if (!classCount[k])
+		{
+			fprintf(stderr, "no features for grip %d, is the trace longer than --skip?\n", _classGrip[k]);
+			return false;
+		}
+
+		for (int i = 0; i < n; i++)
+		{
+			classMean[k][i] /= classCount[k];
+		}
+	}
+
+	memset(cov, 0, sizeof(cov));
+
+	for (size_t s = 0; s < _numSets; s++)
+	{
+		int k = _sets[s].cls;
+		double d[n];
+
+		for (int i = 0; i < n; i++)
+		{
+			d[i] = ((_sets[s].x[i] - mean[i]) / scale[i]) - classMean[k][i];
+		}
+
+		for (int i = 0; i < n; i++)
+		{
+			for (int j = 0; j < n; j++)
+			{
+				cov[i][j] += d[i] * d[j];
+			}
+		}
+	}
+	for (int i = 0; i < n; i++)
+	{
+		for (int j = 0; j < n; j++)
+		{
+			cov[i][j] /= ((_numSets > (size_t)_numClasses) ? (_numSets - _numClasses) : 1);
+		}
+		cov[i][i] += _ridge;
+	}
+
+	// w = inv(cov).mean, b = -0.5 x mean.w, then undo the standardisation
+	double weight[CLASSIFIER_MAX_CLASSES][n];
+	double bias[CLASSIFIER_MAX_CLASSES];
+	double largest = 0;
+
+	for (int k = 0; k < _numClasses; k++)
+	{
+		double A[n][n];
+		double b[n];
+		double w[n];
+
+		memcpy(A, cov, sizeof(A));
+		memcpy(b, classMean[k], sizeof(b));
+
+		if (!solve(A, b, w))
+		{
+			fprintf(stderr, "covariance is singular, try a larger --ridge\n");
+			return false;
+		}
+
+		bias[k] = 0;
+
+		for (int i = 0; i < n; i++)
+		{
+			bias[k] -= 0.5 * classMean[k][i] * w[i];
+		}
+
+		for (int i = 0; i < n; i++)
+		{
+			weight[k][i] = w[i] / scale[i];
+			bias[k] -= weight[k][i] * mean[i];
+
+			largest = fmax(largest, fabs(weight[k][i]));
+		}
+
+		largest = fmax(largest, fabs(bias[k]));
+	}
+
+	// scale so that the largest weight or bias is 2^LDA_WEIGHT_BITS
+	double gain = (largest > 0) ? (ldexp(1, LDA_WEIGHT_BITS) / largest) : 1;
+
+	memset(model, 0, sizeof(LDAModel));
+	model->init = CLASSIFIER_INIT_CODE;
+	model->numClasses = _numClasses;
+
+	for (int k = 0; k < _numClasses; k++)
+	{
+		model->grip[k] = _classGrip[k];
+		model->bias[k] = (int32_t)lround(bias[k] * gain);
+
+		for (int i = 0; i < n; i++)
+		{
+			model->weight[k][i] = (int32_t)lround(weight[k][i] * gain);
+		}
+	}
+
+	return true;
+}
+
+// classify the training features with the integer maths of EMG_CLASSIFIER::classify(), and print the confusion matrix
+static void test(LDAModel *model)
+{
+	size_t confusion[CLASSIFIER_MAX_CLASSES][CLASSIFIER_MAX_CLASSES] = { { 0 } };
+	size_t correct = 0;
+
+	for (size_t s = 0; s < _numSets; s++)
+	{
+		int best = 0;
+		int64_t bestScore = 0;
+
+		for (int k = 0; k < model->numClasses; k++)
+		{
+			int64_t score = model->bias[k];
+
+			for (int i = 0; i < CLASSIFIER_NUM_INPUTS; i++)
+			{
+				score += (int64_t)model->weight[k][i] * _sets[s].x[i];
+			}
+
+			if ((k == 0) || (score > bestScore))
+			{
+				best = k;
+				bestScore = score;
+			}
+		}
+
+		confusion[_sets[s].cls][best]++;
+
+		if (best == _sets[s].cls)
+			correct++;
+	}
+
+	fprintf(stderr, "%zu feature sets, %d classes, %.1f%% classified correctly\n\n", _numSets, _numClasses, (100.0 * correct) / _numSets);
+	fprintf(stderr, "grip\\classified");
+	for (int k = 0; k < _numClasses; k++)
+	{
+		fprintf(stderr, "\t%d", _classGrip[k]);
+	}
+	fprintf(stderr, "\n");
+
+	for (int k = 0; k < _numClasses; k++)
+	{
+		fprintf(stderr, "%d\t\t", _classGrip[k]);
+		for (int j = 0; j < _numClasses; j++)
+		{
+			fprintf(stderr, "\t%zu", confusion[k][j]);
+		}
+		fprintf(stderr, "\n");
+	}
+}
+
+////////////////////////////// UPLOAD //////////////////////////////
+
+// write a value to the upload, starting a new line if it does not fit
+static void writeValue(FILE *out, int32_t val, int *lineLen, uint32_t *checksum)
+{
+	char str[16];
+	int len = snprintf(str, sizeof(str), "%ld", (long)val);
+
+	if (*lineLen && ((*lineLen + 1 + len) > LDA_LINE_LEN))
+	{
+		fprintf(out, "\n");
+		*lineLen = 0;
+	}
+
+	fprintf(out, "%s%s", (*lineLen ? "," : ""), str);
+	*lineLen += len + (*lineLen ? 1 : 0);
+	*checksum += (uint32_t)val;
+}
+
+// write the model in the B3 upload format
+static void writeUpload(FILE *out, const LDAModel *model)
+{
+	int lineLen = 0;
+	uint32_t checksum = 0;
+
+	fprintf(out, "B3\n");
+
+	writeValue(out, model->numClasses, &lineLen, &checksum);
+	writeValue(out, CLASSIFIER_NUM_INPUTS, &lineLen, &checksum);
+
+	for (int k = 0; k < model->numClasses; k++)
+	{
+		writeValue(out, model->grip[k], &lineLen, &checksum);
+		writeValue(out, model->bias[k], &lineLen, &checksum);
+
+		for (int i = 0; i < CLASSIFIER_NUM_INPUTS; i++)
+		{
+			writeValue(out, model->weight[k][i], &lineLen, &checksum);
+		}
+	}
+
+	int32_t sum = (int32_t)checksum;
+	writeValue(out, sum, &lineLen, &checksum);
+	fprintf(out, "\n");
+}
+
+////////////////////////////// MAIN //////////////////////////////
+
+int main(int argc, char **argv)
+{
+	const char *outPath = NULL;
+
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		_peakThresh[c] = 600;		// resetToDefaults()
+	}
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char *arg = argv[i];
+		const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+		if (!strcmp(arg, "--help") || !val)
+		{
+			printUsage(argv[0]);
+			return (strcmp(arg, "--help") ? 1 : 0);
+		}
+
+		i++;
+
+		if (!strcmp(arg, "--class"))
+		{
+			const char *sep = strchr(val, ':');
+
+			if (!sep || (_numFiles >= LDA_MAX_FILES))
+			{
+				printUsage(argv[0]);
+				return 1;
+			}
+
+			_files[_numFiles].grip = atoi(val);
+			_files[_numFiles].path = sep + 1;
+			_numFiles++;
+		}
+		else if (!strcmp(arg, "--thresh"))
+		{
+			// a single threshold for every channel, or a comma separated threshold of each channel
+			const char *p = val;
+
+			for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+			{
+				char *end;
+
+				_peakThresh[c] = (int)strtol(p, &end, 10);
+
+				if (*end != ',')
+					break;
+				p = end + 1;
+			}
+
+			if (!strchr(val, ','))
+			{
+				for (int c = 1; c < NUM_EMG_CHANNELS; c++)
+				{
+					_peakThresh[c] = _peakThresh[0];
+				}
+			}
+		}
+		else if (!strcmp(arg, "--calibrated"))
+		{
+			_calibrated = (atoi(val) != 0);
+		}
+		else if (!strcmp(arg, "--skip"))
+		{
+			_skipTime = strtoul(val, NULL, 10);
+		}
+		else if (!strcmp(arg, "--ridge"))
+		{
+			_ridge = atof(val);
+		}
+		else if (!strcmp(arg, "--out"))
+		{
+			outPath = val;
+		}
+		else
+		{
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	// assign a class to each grip, in the order they are given
+	for (int f = 0; f < _numFiles; f++)
+	{
+		int grip = _files[f].grip;
+		int cls = 0;
+
+		if ((grip < CLASSIFIER_REST) || (grip >= NUM_GRIPS))
+		{
+			fprintf(stderr, "grip %d is not valid (-1 - %d)\n", grip, NUM_GRIPS - 1);
+			return 1;
+		}
+
+		while ((cls < _numClasses) && (_classGrip[cls] != grip))
+			cls++;
+
+		if (cls == _numClasses)
+		{
+			if (_numClasses >= CLASSIFIER_MAX_CLASSES)
+			{
+				fprintf(stderr, "too many classes (max %d)\n", CLASSIFIER_MAX_CLASSES);
+				return 1;
+			}
+
+			_classGrip[_numClasses++] = grip;
+		}
+
+		if (!loadTrace(cls, _files[f].path))
+		{
+			fprintf(stderr, "could not read %s\n", _files[f].path);
+			return 1;
+		}
+	}
+
+	if (_numClasses < 2)
+	{
+		fprintf(stderr, "at least 2 classes are needed\n");
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	static LDAModel model;
+
+	if (!train(&model))
+		return 1;
+
+	test(&model);
+
+	FILE *out = outPath ? fopen(outPath, "w") : stdout;
+
+	if (!out)
+	{
+		fprintf(stderr, "could not write %s\n", outPath);
+		return 1;
+	}
+
+	writeUpload(out, &model);
+
+	if (outPath)
+		fclose(out);
+
+	return 0;
+}
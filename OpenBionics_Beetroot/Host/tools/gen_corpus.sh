@@ -0,0 +1,60 @@
+#!/bin/sh
+#	Open Bionics - Beetroot
+#	Generate a small labelled EMG corpus for bin/emg_bench, using the host build (--record)
+#
+#	tools/gen_corpus.sh [dir]		(default corpus/, run from Host/ after make)
+#
+#	Each trace is 25s of virtual time, with EMG enabled (M1) and trace recording started (A7) at the start.
+#	The contractions are simulated pulse trains (--emg-pulse), and the label of each pulse is written relative
+#	to the start of the trace, which is reported by the host build.
+#
+#	mixed	short pulses on both channels, with long holds on channel 0
+#	weak	low amplitude pulses on both channels, closer to the noise floor
+#	noisy	pulses on channel 0, over a high resting level & noise
+
+DIR=${1:-corpus}
+HOST=./bin/beetroot_host
+TIME=25
+
+if [ ! -x "$HOST" ]; then
+	echo "$HOST not found, run make first" >&2
+	exit 1
+fi
+
+mkdir -p "$DIR" || exit 1
+
+# gen <name> <extra host options> <train>...
+# where each train is <ch>:<per>:<w>:<amp>:<start>:<end>:<pulse|hold> (ms)
+gen()
+{
+	name=$1
+	extra=$2
+	shift 2
+
+	args=""
+	for t in "$@"; do
+		args="$args --emg-pulse ${t%:*}"
+	done
+
+	start=$($HOST --quiet --time $TIME --cmd 0:M1 --cmd 1:A7 --record "$DIR/$name.bin" $extra $args 2>&1 >/dev/null |
+		sed -n 's/^\[host\] trace start: *\([0-9]*\) ms$/\1/p')
+
+	if [ -z "$start" ]; then
+		echo "$name: no trace recorded" >&2
+		exit 1
+	fi
+
+	# one label per pulse, sorted by onset
+	{
+		echo "# onset_ms,channel,duration_ms,kind"
+		for t in "$@"; do
+			echo "$t" | awk -F: -v st="$start" '{ for (t = $5; t < $6; t += $2) printf "%d,%d,%d,%s\n", t - st, $1, $3, $7 }'
+		done | sort -t, -k1,1n
+	} > "$DIR/$name.labels"
+
+	echo "$DIR/$name.bin: trace start $start ms, $(grep -vc '^#' "$DIR/$name.labels") labels"
+}
+
+gen mixed "" 0:3000:300:900:2000:8000:pulse 0:5000:1200:900:10000:20000:hold 1:3000:300:800:3500:21000:pulse
+gen weak "" 0:2000:250:650:2000:22000:pulse 1:2000:250:600:3000:22000:pulse
+gen noisy "--emg-noise 300:400" 0:2500:300:900:2000:22000:pulse
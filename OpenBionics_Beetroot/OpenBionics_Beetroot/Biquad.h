@@ -0,0 +1,164 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	Biquad.h
+*
+*/
+
+// Fixed-point biquad filters.
+// The coefficients are designed with the RBJ 'Audio EQ Cookbook' formulae using constexpr functions, so that a
+// filter for a given sample rate is calculated by the compiler and stored as Q30 integers (no floating point is
+// used at run time). Each filter is run as a Direct Form I biquad, with 32 bit state and a 64 bit accumulator.
+//
+// e.g.	static constexpr BiquadCoeffs lowPass = biquadLowPass(1000, 100, BIQUAD_Q_BUTTERWORTH);
+
+#ifndef BIQUAD_H_
+#define BIQUAD_H_
+
+#include <Arduino.h>
+
+#define BIQUAD_COEFF_BITS		30				// coefficients are Q30, so that |a1| < 2 can be represented
+#define BIQUAD_PI				3.14159265358979323846
+#define BIQUAD_Q_BUTTERWORTH	0.70710678118654752440
+
+typedef struct _BiquadCoeffs
+{
+	int32_t b0, b1, b2;		// Q30, feed-forward coefficients
+	int32_t a1, a2;			// Q30, feedback coefficients (a0 is normalised to 1)
+} BiquadCoeffs;
+
+/////////////////////////////////////// COEFFICIENT DESIGN (compile time) ///////////////////////////////////////
+
+// sin(x) & cos(x) for 0 <= x <= pi, as Taylor series (the <math.h> functions are not constexpr)
+constexpr double biquadSinTerms(double x2, double term, int n)
+{
+	return (n > 20) ? 0 : (term + biquadSinTerms(x2, -term * x2 / ((2 * n) * ((2 * n) + 1)), n + 1));
+}
+constexpr double biquadCosTerms(double x2, double term, int n)
+{
+	return (n > 20) ? 0 : (term + biquadCosTerms(x2, -term * x2 / (((2 * n) - 1) * (2 * n)), n + 1));
+}
+constexpr double biquadSin(double x) { return biquadSinTerms(x * x, x, 1); }
+constexpr double biquadCos(double x) { return biquadCosTerms(x * x, 1, 1); }
+
+// convert a coefficient to Q30, rounding to nearest
+constexpr int32_t biquadToFixed(double c)
+{
+	return (int32_t)((c * (1L << BIQUAD_COEFF_BITS)) + ((c < 0) ? -0.5 : 0.5));
+}
+
+// normalise the coefficients by a0, and convert to Q30
+constexpr BiquadCoeffs biquadNormalise(double b0, double b1, double b2, double a0, double a1, double a2)
+{
+	return BiquadCoeffs{ biquadToFixed(b0 / a0), biquadToFixed(b1 / a0), biquadToFixed(b2 / a0),
+						 biquadToFixed(a1 / a0), biquadToFixed(a2 / a0) };
+}
+
+// angular frequency of f0 (Hz) at sample rate fs (Hz)
+constexpr double biquadW0(double fs, double f0) { return (2 * BIQUAD_PI * f0 / fs); }
+
+// alpha term of the cookbook formulae
+constexpr double biquadAlpha(double w0, double q) { return (biquadSin(w0) / (2 * q)); }
+
+constexpr BiquadCoeffs biquadLowPassW(double cosW0, double alpha)
+{
+	return biquadNormalise((1 - cosW0) / 2, 1 - cosW0, (1 - cosW0) / 2, 1 + alpha, -2 * cosW0, 1 - alpha);
+}
+
+constexpr BiquadCoeffs biquadHighPassW(double cosW0, double alpha)
+{
+	return biquadNormalise((1 + cosW0) / 2, -(1 + cosW0), (1 + cosW0) / 2, 1 + alpha, -2 * cosW0, 1 - alpha);
+}
+
+constexpr BiquadCoeffs biquadNotchW(double cosW0, double alpha)
+{
+	return biquadNormalise(1, -2 * cosW0, 1, 1 + alpha, -2 * cosW0, 1 - alpha);
+}
+
+// 2nd order low-pass, cut-off f0 (Hz) at sample rate fs (Hz)
+constexpr BiquadCoeffs biquadLowPass(double fs, double f0, double q)
+{
+	return biquadLowPassW(biquadCos(biquadW0(fs, f0)), biquadAlpha(biquadW0(fs, f0), q));
+}
+
+// 2nd order high-pass, cut-off f0 (Hz) at sample rate fs (Hz)
+constexpr BiquadCoeffs biquadHighPass(double fs, double f0, double q)
+{
+	return biquadHighPassW(biquadCos(biquadW0(fs, f0)), biquadAlpha(biquadW0(fs, f0), q));
+}
+
+// notch at f0 (Hz) at sample rate fs (Hz), the -3dB bandwidth is f0 / q
+constexpr BiquadCoeffs biquadNotch(double fs, double f0, double q)
+{
+	return biquadNotchW(biquadCos(biquadW0(fs, f0)), biquadAlpha(biquadW0(fs, f0), q));
+}
+
+/////////////////////////////////////// FILTER (run time) ///////////////////////////////////////
+
+// a cascade of N biquads
+template <uint8_t N>
+class BIQUAD_CHAIN
+{
+	public:
+		BIQUAD_CHAIN() { _coeffs = NULL; reset(); }
+
+		// attach the coefficients of each stage and clear the filter state
+		void begin(const BiquadCoeffs *coeffs)
+		{
+			_coeffs = coeffs;
+			reset();
+		}
+
+		// clear the filter state
+		void reset(void)
+		{
+			for (uint8_t i = 0; i < N; i++)
+			{
+				_state[i].x1 = _state[i].x2 = 0;
+				_state[i].y1 = _state[i].y2 = 0;
+			}
+		}
+
+		// filter a sample through each stage
+		int32_t run(int32_t x)
+		{
+			for (uint8_t i = 0; i < N; i++)
+			{
+				const BiquadCoeffs *c = &_coeffs[i];
+				State *s = &_state[i];
+
+				int64_t acc = ((int64_t)c->b0 * x) + ((int64_t)c->b1 * s->x1) + ((int64_t)c->b2 * s->x2)
+							- ((int64_t)c->a1 * s->y1) - ((int64_t)c->a2 * s->y2);
+				int32_t y = (int32_t)(acc >> BIQUAD_COEFF_BITS);
+
+				s->x2 = s->x1;
+				s->x1 = x;
+				s->y2 = s->y1;
+				s->y1 = y;
+
+				x = y;
+			}
+
+			return x;
+		}
+
+	private:
+		typedef struct _State
+		{
+			int32_t x1, x2;		// previous inputs
+			int32_t y1, y2;		// previous outputs
+		} State;
+
+		const BiquadCoeffs *_coeffs;	// coefficients of each stage
+		State _state[N];				// state of each stage
+};
+
+#endif // BIQUAD_H_
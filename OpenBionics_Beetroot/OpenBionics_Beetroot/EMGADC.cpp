@@ -0,0 +1,228 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EMGADC.cpp
+*
+*/
+
+// Scan timing and reading of the block ring. The ADC set up and conversion (begin(), end() and convert()) are
+// within EMGADC_SAMD.cpp
+
+#include "Globals.h"
+#include "EMGADC.h"
+
+EMG_ADC EMGADC;
+
+////////////////////////////// Constructors/Destructors //////////////////////////////
+
+EMG_ADC::EMG_ADC()
+{
+	_numComplete = 0;
+	_numRead = 0;
+	_numOverruns = 0;
+
+	_numChannels = 0;
+	_shift = 0;
+	_rate = 0;
+	_fullTicks = 1;
+	_ticksPerScan = 1;
+	_scansPerBlock = EMG_ADC_BLOCK_SIZE;
+	_tickCount = 0;
+	_scan = 0;
+	_running = false;
+	_scanning = false;
+	_idle = false;
+	_numTicks = 0;
+	_numIdleTicks = 0;
+}
+
+////////////////////////////// Public Methods //////////////////////////////
+
+// start scanning, any blocks from a previous run are discarded
+void EMG_ADC::start(void)
+{
+	if (!_running || _scanning)
+	{
+		return;
+	}
+
+	_numRead = _numComplete;
+	_tickCount = 0;
+	_scan = 0;
+	_idle = false;
+	_scanning = true;
+}
+
+// stop scanning, and leave the ADC to analogRead()
+void EMG_ADC::stop(void)
+{
+	_scanning = false;
+}
+
+// returns true if scanning
+bool EMG_ADC::scanning(void)
+{
+	return _scanning;
+}
+
+// scan at the idle rate (true) or the full rate (false), from the next block
+void EMG_ADC::setIdle(bool idle)
+{
+	_idle = idle && (_fullTicks < EMG_ADC_IDLE_TICKS);		// the idle rate must be below the full rate
+}
+
+// returns true if scanning at the idle rate
+bool EMG_ADC::idle(void)
+{
+	return _idle;
+}
+
+// number of complete blocks waiting to be read
+uint8_t EMG_ADC::available(void)
+{
+	uint32_t n = _numComplete - _numRead;		// unsigned difference survives overflow
+
+	// the block after the newest complete block is being written by the interrupt, so if every other block is
+	// waiting, skip the oldest blocks to prevent reading a block while it is overwritten
+	if (n > (EMG_ADC_NUM_BLOCKS - 1))
+	{
+		_numOverruns += n - (EMG_ADC_NUM_BLOCKS - 1);
+		_numRead += n - (EMG_ADC_NUM_BLOCKS - 1);
+		n = EMG_ADC_NUM_BLOCKS - 1;
+	}
+
+	return n;
+}
+
+// number of scans within the oldest complete block (1 in idle mode)
+uint8_t EMG_ADC::getNumScans(void)
+{
+	return _blockScans[_numRead % EMG_ADC_NUM_BLOCKS];
+}
+
+// read the sample of a channel from a scan within the oldest complete block
+int EMG_ADC::read(uint8_t scan, uint8_t ch)
+{
+	if ((scan >= getNumScans()) || (ch >= _numChannels))
+	{
+		return 0;
+	}
+
+	return _buff[_numRead % EMG_ADC_NUM_BLOCKS][(scan * _numChannels) + ch] >> _shift;
+}
+
+// us, time at which a scan within the oldest complete block was converted
+uint32_t EMG_ADC::getScanTime(uint8_t scan)
+{
+	uint32_t block = _numRead % EMG_ADC_NUM_BLOCKS;
+	uint32_t blockTime = _blockTime[block];		// time of the last scan within the block
+
+	if (scan >= _blockScans[block])
+	{
+		return blockTime;
+	}
+
+	// the scans of a block are a whole number of 1ms ticks apart
+	return blockTime - ((uint32_t)(_blockScans[block] - 1 - scan) * _blockTicks[block] * 1000UL);
+}
+
+// free the oldest complete block, so that it can be re-used
+void EMG_ADC::release(void)
+{
+	if (_numRead != _numComplete)
+	{
+		_numRead++;
+	}
+}
+
+// Hz, sample rate of each channel
+uint16_t EMG_ADC::getRate(void)
+{
+	return _rate;
+}
+
+// number of blocks that were skipped as they were not read in time
+uint32_t EMG_ADC::getNumOverruns(void)
+{
+	return _numOverruns;
+}
+
+// clear the number of overruns and the idle time
+void EMG_ADC::reset(void)
+{
+	_numOverruns = 0;
+
+	noInterrupts();
+	_numTicks = 0;
+	_numIdleTicks = 0;
+	interrupts();
+}
+
+// print the number of overruns, the length of the ring and the time spent idle
+void EMG_ADC::printStatus(void)
+{
+	if (!_running)
+	{
+		return;
+	}
+
+	MYSERIAL_PRINT_PGM("EMG ADC:\toverruns ");
+	MYSERIAL_PRINT(_numOverruns);
+	MYSERIAL_PRINT_PGM(" (ring ");
+	MYSERIAL_PRINT(((uint32_t)(EMG_ADC_NUM_BLOCKS - 1) * EMG_ADC_BLOCK_SIZE * 1000UL) / _rate);
+	MYSERIAL_PRINT_PGM("ms), idle ");
+	MYSERIAL_PRINT(_numTicks ? ((float)_numIdleTicks * 100.0 / _numTicks) : 0.0);
+	MYSERIAL_PRINT_PGM("% at ");
+	MYSERIAL_PRINT(1000 / EMG_ADC_IDLE_TICKS);
+	MYSERIAL_PRINTLN_PGM("Hz");
+}
+
+// called from the 1ms timer interrupt to make any scan that is due
+void EMG_ADC::tick(void)
+{
+	if (!_scanning)
+	{
+		return;
+	}
+
+	// apply any change between the idle & full rate at the start of each block, so each block has a single rate
+	if (_scan == 0)
+	{
+		_ticksPerScan = _idle ? EMG_ADC_IDLE_TICKS : _fullTicks;
+		_scansPerBlock = _idle ? 1 : EMG_ADC_BLOCK_SIZE;
+	}
+
+	_numTicks++;
+	if (_idle && (_scan == 0))
+	{
+		_numIdleTicks++;
+	}
+
+	if (++_tickCount < _ticksPerScan)
+	{
+		return;
+	}
+	_tickCount = 0;
+
+	uint32_t block = _numComplete % EMG_ADC_NUM_BLOCKS;
+
+	convert(&_buff[block][_scan * _numChannels]);
+
+	// timestamp each complete block with the time of its last scan
+	if (++_scan >= _scansPerBlock)
+	{
+		_scan = 0;
+		_blockTime[block] = micros();
+		_blockScans[block] = _scansPerBlock;
+		_blockTicks[block] = _ticksPerScan;
+		_numComplete++;
+	}
+}
@@ -0,0 +1,121 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EMGADC.h
+*
+*/
+
+// EMG acquisition using the SAMD21 ADC.
+// The ADC is shared with FingerLib, which reads the fingers with analogRead() from its 1ms timer interrupt. So that
+// the two can never use the ADC at the same time, the EMG channels are converted from the same interrupt, by tick()
+// (called from milliSecInterrupt()). Each scan converts the attached pins one after another with a fast ADC clock
+// (a few us per pin), then returns the ADC to the set up used by analogRead(). Scans are timestamped a block at a time,
+// and the blocks are then read from loop() using available(), read() and release().
+//
+// Scans are only made between start() and stop(), so the ADC is left to FingerLib while EMG is not in use.
+// analogRead() must not be called from loop() while scanning, as a scan could interrupt its conversion.
+//
+// The ring is EMG_ADC_NUM_BLOCKS long so that the reader can fall behind by up to (EMG_ADC_NUM_BLOCKS - 1) blocks.
+// If it falls further behind, the oldest blocks are skipped and counted as overruns (printed by the loop profiler, L).
+// At 1kHz the reader can fall behind by 124ms, which covers the longest task that can delay the EMG task (Monitor, ~75ms on its first run).
+//
+// While the muscles are at rest, the EMG control sets idle mode (setIdle()), which scans every EMG_ADC_IDLE_TICKS
+// ticks rather than at the full rate, to save the conversions and the processing of each sample. Each idle scan is
+// a block of its own, so that it is read without waiting for the rest of a block, and the rate returns to full from
+// the next tick once idle mode is cleared. The number of scans within a block is returned by getNumScans().
+//
+// Why not free running, timer triggered conversions into a DMA buffer: that was the first version of this module, but
+// the Arduino core analogRead() re-configures and disables the ADC on every call, so each finger read made by FingerLib
+// within its interrupt stopped or corrupted the EMG conversions (and the EMG set up changed the finger readings). The
+// two can not share the ADC that way without changing FingerLib, so the CPU makes each scan within the same interrupt.
+// As a result the sample clock is the 1ms tick, so the rate is 1kHz or a factor of it (500Hz, 250Hz...), 2kHz is not
+// possible, and the ADC wait is made within the interrupt rather than being taken off the CPU.
+//
+// Cost to the interrupt: each scan switches the ADC set up and back (a few us of register synchronisation), then waits
+// for each conversion (EMG_ADC_CONV_US per channel, times the number of averaged samples), e.g. ~20us per tick for
+// 2 channels without averaging, ~2% of the CPU at 1kHz. begin() rejects a set up whose conversions would take longer
+// than EMG_ADC_MAX_SCAN_US (10% of the tick). The cost is measured by the 'EMG ADC' probe of the loop profiler (L),
+// shown as the ISR load. In exchange, loop() no longer waits for conversions with interrupts disabled, and the samples
+// are evenly spaced on the tick rather than depending on the loop speed.
+
+#ifndef EMG_ADC_H_
+#define EMG_ADC_H_
+
+#include <Arduino.h>
+
+#define EMG_ADC_MAX_CHANNELS	4		// maximum number of pins that can be attached
+#define EMG_ADC_MAX_AIN			20		// number of analogue inputs (AIN0 - AIN19)
+#define EMG_ADC_BLOCK_SIZE		4		// scans per block
+#define EMG_ADC_NUM_BLOCKS		32		// blocks within the ring, must be a power of 2
+#define EMG_ADC_IDLE_TICKS		10		// number of 1ms ticks between scans in idle mode (100Hz)
+
+#define EMG_ADC_CONV_US			7		// us, approximate duration of a conversion (1.5MHz ADC clock, 12 bit, SAMPLEN 3)
+#define EMG_ADC_MAX_SCAN_US		100		// us, longest scan allowed within the 1ms timer interrupt
+
+class EMG_ADC
+{
+	public:
+		EMG_ADC();
+
+		bool begin(const int *pins, uint8_t numChannels, uint16_t rate, uint8_t res = 10, uint8_t avg = 1);	// set up the conversion of each pin at 'rate' Hz (a factor of 1kHz), with 'res' bits and 'avg' samples averaged (1 - 16) by the hardware
+		void end(void);							// stop the conversions
+
+		void start(void);						// start scanning, any blocks from a previous run are discarded
+		void stop(void);						// stop scanning, and leave the ADC to analogRead()
+		bool scanning(void);					// returns true if scanning
+
+		void setIdle(bool idle);				// scan at the idle rate (true) or the full rate (false), from the next block
+		bool idle(void);						// returns true if scanning at the idle rate
+
+		uint8_t available(void);				// number of complete blocks waiting to be read
+		uint8_t getNumScans(void);				// number of scans within the oldest complete block (1 in idle mode)
+		int read(uint8_t scan, uint8_t ch);		// read the sample of a channel from a scan within the oldest complete block
+		uint32_t getScanTime(uint8_t scan);		// us, time at which a scan within the oldest complete block was converted
+		void release(void);						// free the oldest complete block, so that it can be re-used
+
+		uint16_t getRate(void);					// Hz, sample rate of each channel
+		uint32_t getNumOverruns(void);			// number of blocks that were skipped as they were not read in time
+
+		void reset(void);						// clear the number of overruns and the idle time
+		void printStatus(void);					// print the number of overruns, the length of the ring and the time spent idle
+
+		void tick(void);						// called from the 1ms timer interrupt to make any scan that is due, DO NOT CALL
+
+	private:
+		void convert(volatile uint16_t *dst);	// convert each channel into dst (EMGADC_SAMD.cpp)
+
+		volatile uint16_t _buff[EMG_ADC_NUM_BLOCKS][EMG_ADC_BLOCK_SIZE * EMG_ADC_MAX_CHANNELS];	// conversion results
+		volatile uint32_t _blockTime[EMG_ADC_NUM_BLOCKS];	// us, time at which each block was completed
+		volatile uint8_t _blockScans[EMG_ADC_NUM_BLOCKS];	// number of scans within each block
+		volatile uint8_t _blockTicks[EMG_ADC_NUM_BLOCKS];	// number of ticks between the scans of each block
+		volatile uint32_t _numComplete;			// number of blocks completed (written by the interrupt)
+		uint32_t _numRead;						// number of blocks released by the reader
+		uint32_t _numOverruns;					// number of blocks skipped
+
+		uint8_t _numChannels;					// number of attached pins
+		uint8_t _ain[EMG_ADC_MAX_CHANNELS];		// analogue input of each channel
+		uint8_t _shift;							// number of bits to remove from each result, to give the requested resolution
+		uint16_t _rate;							// Hz
+		uint8_t _fullTicks;						// number of 1ms ticks between scans at the full rate
+		volatile uint8_t _ticksPerScan;			// number of 1ms ticks between scans of the current block
+		volatile uint8_t _scansPerBlock;		// number of scans within the current block
+		volatile uint8_t _tickCount;			// ticks since the last scan
+		volatile uint8_t _scan;					// scan being written within the current block
+		bool _running;							// true once set up by begin()
+		volatile bool _scanning;				// true between start() and stop()
+		volatile bool _idle;					// scan at the idle rate, applied at the start of each block
+		volatile uint32_t _numTicks;			// ticks while scanning, since reset
+		volatile uint32_t _numIdleTicks;		// ticks while scanning at the idle rate, since reset
+};
+
+extern EMG_ADC EMGADC;
+
+#endif // EMG_ADC_H_
@@ -0,0 +1,183 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EMGADC_SAMD.cpp
+*
+*/
+
+// SAMD21 ADC set up for EMG_ADC.
+// convert() is called from the FingerLib 1ms timer interrupt, so it can not interrupt (or be interrupted by) the
+// analogRead() of the fingers. Each call saves the set up that analogRead() uses (as left by the Arduino core init(),
+// analogReadResolution() & analogReference(), e.g. SAMPCTRL 0x3f), switches the ADC to the EMG set up, converts each
+// channel in turn, then restores the saved registers, so the finger readings are unchanged.
+
+#include <Arduino.h>
+
+#if defined(ARDUINO_ARCH_SAMD)
+
+#include <wiring_private.h>		// pinPeripheral()
+
+#include "Globals.h"
+#include "EMGADC.h"
+
+static uint32_t _ctrlB;					// EMG resolution & ADC clock
+static uint8_t _avgCtrl;				// EMG hardware averaging
+
+// wait for the ADC registers to synchronise
+static void syncADC(void)
+{
+	while (ADC->STATUS.bit.SYNCBUSY);
+}
+
+// ADC set up used by analogRead(), saved before each scan
+typedef struct _ADCSetup
+{
+	uint8_t avgCtrl;
+	uint8_t sampCtrl;
+	uint16_t ctrlB;
+	uint32_t inputCtrl;
+} ADCSetup;
+
+// save the set up used by analogRead()
+static void saveADC(ADCSetup *setup)
+{
+	setup->avgCtrl = ADC->AVGCTRL.reg;
+	setup->sampCtrl = ADC->SAMPCTRL.reg;
+	setup->ctrlB = ADC->CTRLB.reg;
+	setup->inputCtrl = ADC->INPUTCTRL.reg;
+}
+
+// return the ADC to the set up used by analogRead(), disabled as analogRead() leaves it
+static void restoreADC(const ADCSetup *setup)
+{
+	ADC->CTRLA.bit.ENABLE = 0;
+	syncADC();
+	ADC->AVGCTRL.reg = setup->avgCtrl;
+	ADC->SAMPCTRL.reg = setup->sampCtrl;
+	ADC->INPUTCTRL.reg = setup->inputCtrl;
+	syncADC();
+	ADC->CTRLB.reg = setup->ctrlB;
+	syncADC();
+	ADC->INTFLAG.reg = ADC_INTFLAG_RESRDY;
+}
+
+////////////////////////////// Public Methods //////////////////////////////
+
+// set up the conversion of each pin at 'rate' Hz (a factor of 1kHz), with 'res' bits and 'avg' samples averaged (1 - 16) by the hardware
+bool EMG_ADC::begin(const int *pins, uint8_t numChannels, uint16_t rate, uint8_t res, uint8_t avg)
+{
+	uint8_t avgBits = 0;
+	uint8_t hwRes;
+
+	// scans are made on the 1ms tick, so the rate must be 1kHz or a factor of it (see EMGADC.h)
+	if ((numChannels == 0) || (numChannels > EMG_ADC_MAX_CHANNELS) || (rate == 0) || (rate > 1000) || (1000 % rate) || (res > 12))
+	{
+		return false;
+	}
+
+	end();
+
+	// hardware averaging of up to 16 samples gives a 12 bit result
+	while (((1 << (avgBits + 1)) <= avg) && (avgBits < 4))
+	{
+		avgBits++;
+	}
+
+	// the scan is made within the timer interrupt, so it must be short
+	if (((uint16_t)numChannels * (1 << avgBits) * EMG_ADC_CONV_US) > EMG_ADC_MAX_SCAN_US)
+	{
+		return false;
+	}
+
+	for (uint8_t c = 0; c < numChannels; c++)
+	{
+		_ain[c] = g_APinDescription[pins[c]].ulADCChannelNumber;
+
+		if (_ain[c] >= EMG_ADC_MAX_AIN)
+		{
+			return false;
+		}
+	}
+
+	for (uint8_t c = 0; c < numChannels; c++)
+	{
+		pinPeripheral(pins[c], PIO_ANALOG);
+	}
+
+	hwRes = (avgBits || (res > 10)) ? 12 : ((res > 8) ? 10 : 8);
+	_shift = (res < hwRes) ? (hwRes - res) : 0;
+
+	_avgCtrl = ADC_AVGCTRL_SAMPLENUM(avgBits) | ADC_AVGCTRL_ADJRES(avgBits);
+	_ctrlB = ADC_CTRLB_PRESCALER_DIV32 |		// 1.5MHz ADC clock
+		(avgBits ? ADC_CTRLB_RESSEL_16BIT : ((hwRes == 12) ? ADC_CTRLB_RESSEL_12BIT : ((hwRes == 10) ? ADC_CTRLB_RESSEL_10BIT : ADC_CTRLB_RESSEL_8BIT)));
+
+	_numChannels = numChannels;
+	_rate = rate;
+	_fullTicks = 1000 / rate;
+	_ticksPerScan = _fullTicks;
+	_scansPerBlock = EMG_ADC_BLOCK_SIZE;
+	_idle = false;
+
+	_numComplete = 0;
+	_numRead = 0;
+	_numOverruns = 0;
+
+	_running = true;
+
+	return true;
+}
+
+// stop the conversions
+void EMG_ADC::end(void)
+{
+	if (!_running)
+	{
+		return;
+	}
+
+	stop();
+
+	_running = false;
+}
+
+// convert each channel into dst, called from the timer interrupt
+void EMG_ADC::convert(volatile uint16_t *dst)
+{
+	ADCSetup setup;
+
+	saveADC(&setup);
+
+	// switch to the EMG set up (the ADC is disabled by analogRead() after each conversion)
+	ADC->CTRLA.bit.ENABLE = 0;
+	syncADC();
+	ADC->AVGCTRL.reg = _avgCtrl;
+	ADC->SAMPCTRL.reg = ADC_SAMPCTRL_SAMPLEN(3);		// allow the sample capacitor to settle after each input change
+	ADC->CTRLB.reg = _ctrlB;
+	syncADC();
+	ADC->CTRLA.bit.ENABLE = 1;
+	syncADC();
+
+	for (uint8_t c = 0; c < _numChannels; c++)
+	{
+		ADC->INPUTCTRL.reg = ADC_INPUTCTRL_MUXPOS(_ain[c]) | ADC_INPUTCTRL_MUXNEG_GND | (setup.inputCtrl & ADC_INPUTCTRL_GAIN_Msk);	// keep the gain of analogReference()
+		syncADC();
+
+		ADC->INTFLAG.reg = ADC_INTFLAG_RESRDY;
+		ADC->SWTRIG.bit.START = 1;
+		while (!(ADC->INTFLAG.reg & ADC_INTFLAG_RESRDY));
+
+		dst[c] = ADC->RESULT.reg;
+	}
+
+	restoreADC(&setup);
+}
+
+#endif // ARDUINO_ARCH_SAMD
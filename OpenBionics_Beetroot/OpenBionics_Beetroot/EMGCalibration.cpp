@@ -0,0 +1,416 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EMGCalibration.cpp
+*
+*/
+
+#include "Globals.h"
+#include "EMGCalibration.h"
+
+#include "Initialisation.h"		// settings, storeSettings()
+#include "TimerManagement.h"	// customMillis()
+#include "Utils.h"				// isqrt32()
+
+EMG_CALIBRATION EMGCal;
+
+// ms, duration of each stage (after CAL_SETTLE_TIME), in the order of CalStage
+static const uint16_t calStageTime[] = { 0, CAL_REST_TIME, CAL_MAX_TIME, CAL_PULSE_TIME, CAL_VERIFY_TIME };
+
+////////////////////////////// Constructors/Destructors //////////////////////////////
+
+EMG_CALIBRATION::EMG_CALIBRATION()
+{
+	_stage = CAL_OFF;
+	_startTime = 0;
+	_stageTime = 0;
+	_prevCalibrated = false;
+}
+
+////////////////////////////// Public Methods //////////////////////////////
+
+// start the calibration, from the CAL_REST stage
+void EMG_CALIBRATION::start(void)
+{
+	// keep the settings from before the first attempt, if the calibration is restarted
+	if (!running())
+	{
+		for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+		{
+			_prev[c] = settings.emg.channel[c];
+		}
+		_prevCalibrated = settings.emg.calibrated;
+	}
+
+	memset(_ch, 0, sizeof(_ch));
+
+	MYSERIAL_PRINTLN_PGM("EMG calibration started, follow each instruction (E0 to cancel)");
+
+	_startTime = customMillis();
+	startStage(CAL_REST);
+}
+
+// stop the calibration, and restore the previous settings
+void EMG_CALIBRATION::cancel(void)
+{
+	if (!running())
+		return;
+
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		settings.emg.channel[c] = _prev[c];
+	}
+	settings.emg.calibrated = _prevCalibrated;
+
+	EMG.updateThresholds();
+
+	_stage = CAL_OFF;
+
+	MYSERIAL_PRINTLN_PGM("EMG calibration cancelled, settings unchanged");
+}
+
+// returns true if a calibration is in progress
+bool EMG_CALIBRATION::running(void)
+{
+	return (_stage != CAL_OFF);
+}
+
+// measure the most recent sample of every channel, and move through the stages
+void EMG_CALIBRATION::addSample(EMGchannel *channel)
+{
+	if (!running())
+		return;
+
+	uint32_t elapsed = customMillis() - _stageTime;
+
+	// ignore the samples while the user reacts to the prompt
+	if (elapsed < CAL_SETTLE_TIME)
+		return;
+
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		measure(_ch[c], channel[c]);
+	}
+
+	if (elapsed >= (uint32_t)(CAL_SETTLE_TIME + calStageTime[_stage]))
+		endStage();
+}
+
+// print the calibrated & current threshold, hysteresis and gain of each channel
+void EMG_CALIBRATION::printSettings(void)
+{
+	if (running())
+	{
+		MYSERIAL_PRINT_PGM("EMG calibration in progress, stage ");
+		MYSERIAL_PRINT(_stage);
+		MYSERIAL_PRINTLN_PGM("/4");
+		return;
+	}
+
+	if (settings.emg.calibrated)
+	{
+		MYSERIAL_PRINTLN_PGM("EMG - calibrated");
+	}
+	else
+	{
+		MYSERIAL_PRINTLN_PGM("EMG - not calibrated, E1 to calibrate");
+	}
+
+	MYSERIAL_PRINTLN_PGM("Ch\tThresh\tCurrent\tHyst\tGain");
+
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		const EMGChannelSettings *cs = &settings.emg.channel[c];
+
+		MYSERIAL_PRINT(c);
+		MYSERIAL_PRINT_PGM("\t");
+		MYSERIAL_PRINT(cs->peakThresh);
+		MYSERIAL_PRINT_PGM("\t");
+		MYSERIAL_PRINT(EMG.getPeakThresh(c));		// including any drift
+		MYSERIAL_PRINT_PGM("\t");
+		MYSERIAL_PRINT(cs->hysteresis);
+		MYSERIAL_PRINT_PGM("%\tx");
+		MYSERIAL_PRINTLN((float)cs->gain / EMG_GAIN_UNITY);
+	}
+
+	MYSERIAL_PRINT_PGM("Hold time - ");
+	MYSERIAL_PRINTLN(settings.emg.holdTime);
+}
+
+////////////////////////////// Private Methods //////////////////////////////
+
+// prompt the user, and start the timer of a stage
+void EMG_CALIBRATION::startStage(CalStage stage)
+{
+	_stage = stage;
+	_stageTime = customMillis();
+
+	MYSERIAL_PRINT_PGM("EMG calibration ");
+	MYSERIAL_PRINT(stage);
+	MYSERIAL_PRINT_PGM("/4 - ");
+
+	switch (stage)
+	{
+	case CAL_REST:
+		MYSERIAL_PRINT_PGM("relax every muscle");
+		break;
+	case CAL_MAX:
+		MYSERIAL_PRINT_PGM("tense each muscle as hard as possible, one at a time");
+		break;
+	case CAL_PULSE:
+		MYSERIAL_PRINT_PGM("tense & relax each muscle ");
+		MYSERIAL_PRINT(CAL_NUM_PULSES);
+		MYSERIAL_PRINT_PGM(" times, one at a time");
+		break;
+	case CAL_VERIFY:
+		MYSERIAL_PRINT_PGM("relax every muscle, checking the new thresholds");
+		break;
+	default:
+		break;
+	}
+
+	MYSERIAL_PRINT_PGM(" (");
+	MYSERIAL_PRINT((CAL_SETTLE_TIME + calStageTime[stage]) / 1000);
+	MYSERIAL_PRINTLN_PGM("s)");
+}
+
+// process the measurements of the current stage, and start the next stage
+void EMG_CALIBRATION::endStage(void)
+{
+	switch (_stage)
+	{
+	case CAL_REST:
+		endRest();
+		startStage(CAL_MAX);
+		break;
+	case CAL_MAX:
+		endMax();
+		startStage(CAL_PULSE);
+		break;
+	case CAL_PULSE:
+		endPulse();
+		startStage(CAL_VERIFY);
+		break;
+	case CAL_VERIFY:
+		endVerify();
+		break;
+	default:
+		_stage = CAL_OFF;
+		break;
+	}
+}
+
+// calculate the noise of each channel
+void EMG_CALIBRATION::endRest(void)
+{
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		CalChannel *cal = &_ch[c];
+
+		if (cal->count == 0)
+			continue;
+
+		int64_t n = cal->count;
+		int32_t mean = cal->sum / (int32_t)n;
+		int64_t var = ((n * (int64_t)cal->sumSq) - ((int64_t)cal->sum * cal->sum)) / (n * n);	// without rounding the mean
+
+		cal->restMean = mean;
+		cal->noiseSD = isqrt32((var > 0) ? (uint32_t)var : 0);
+		cal->noisePeak -= mean;				// max sample at rest, relative to the mean
+
+		cal->noiseCeil = cal->noisePeak;
+		if ((EMG_DRIFT_SIGMAS * cal->noiseSD) > cal->noiseCeil)
+			cal->noiseCeil = EMG_DRIFT_SIGMAS * cal->noiseSD;
+	}
+}
+
+// set the provisional pulse thresholds of each channel
+void EMG_CALIBRATION::endMax(void)
+{
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		CalChannel *cal = &_ch[c];
+		int range = cal->maxAmp - cal->noiseCeil;
+
+		cal->pulseOn = cal->noiseCeil + (range / 4);
+		cal->pulseOff = cal->noiseCeil + (range / 8);
+		cal->inPulse = false;
+	}
+}
+
+// calculate and apply the new settings of each channel
+void EMG_CALIBRATION::endPulse(void)
+{
+	bool anyCalibrated = false;
+
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		CalChannel *cal = &_ch[c];
+		EMGChannelSettings *cs = &settings.emg.channel[c];
+
+		// a channel without a clear contraction keeps its settings
+		cal->calibrated = (cal->numPulses > 0) && (cal->pulseMin > cal->noiseCeil) && (cal->maxAmp >= (CAL_MIN_SNR * cal->noiseCeil));
+
+		if (!cal->calibrated)
+			continue;
+
+		int thresh = cal->noiseCeil + ((cal->pulseMin - cal->noiseCeil) / 2);
+		int end = cal->noiseCeil + ((thresh - cal->noiseCeil) / 2);
+		int gain = ((1 << EMG_SAMPLE_RES) << EMG_GAIN_BITS) / cal->maxAmp;		// max contraction to full scale
+
+		cs->peakThresh = thresh;
+		cs->hysteresis = ((thresh - end) * 100) / thresh;
+		cs->gain = constrain(gain, 1, 255);
+
+		anyCalibrated = true;
+	}
+
+	if (anyCalibrated)
+		settings.emg.calibrated = true;
+
+	// detect PEAKs using the new thresholds, to count the false triggers
+	EMG.updateThresholds();
+}
+
+// store the new settings, and print the results
+void EMG_CALIBRATION::endVerify(void)
+{
+	_stage = CAL_OFF;
+
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		if (_ch[c].calibrated)
+		{
+			storeSettings();
+			break;
+		}
+	}
+
+	printResults();
+}
+
+// measure a sample during the current stage
+void EMG_CALIBRATION::measure(CalChannel &cal, EMGchannel &channel)
+{
+	int level = channel.level;
+
+	if (_stage == CAL_REST)
+	{
+		cal.sum += level;
+		cal.sumSq += (uint32_t)(level * level);
+		cal.count++;
+
+		if ((cal.count == 1) || (level > cal.noisePeak))
+			cal.noisePeak = level;
+
+		return;
+	}
+
+	// smoothed amplitude, relative to the mean at rest
+	cal.smooth += ((level - cal.restMean) - cal.smooth) >> CAL_SMOOTH_BITS;
+
+	switch (_stage)
+	{
+	case CAL_MAX:
+		if (cal.smooth > cal.maxAmp)
+			cal.maxAmp = cal.smooth;
+		break;
+
+	case CAL_PULSE:
+		if (cal.smooth > cal.maxAmp)
+			cal.maxAmp = cal.smooth;
+
+		// measure the peak of each pulse, between the provisional thresholds
+		if (!cal.inPulse)
+		{
+			if (cal.smooth >= cal.pulseOn)
+			{
+				cal.inPulse = true;
+				cal.pulsePeak = cal.smooth;
+			}
+		}
+		else if (cal.smooth < cal.pulseOff)
+		{
+			cal.inPulse = false;
+
+			if ((cal.numPulses == 0) || (cal.pulsePeak < cal.pulseMin))
+				cal.pulseMin = cal.pulsePeak;
+
+			cal.numPulses++;
+		}
+		else if (cal.smooth > cal.pulsePeak)
+		{
+			cal.pulsePeak = cal.smooth;
+		}
+		break;
+
+	case CAL_VERIFY:
+		// count each PEAK detected at rest
+		if (channel.above && !cal.prevAbove)
+			cal.falseTriggers++;
+
+		cal.prevAbove = channel.above;
+		break;
+
+	default:
+		break;
+	}
+}
+
+// print the measurements & new settings of each channel, and the false trigger rate
+void EMG_CALIBRATION::printResults(void)
+{
+	uint16_t falseTriggers = 0;
+
+	MYSERIAL_PRINT_PGM("EMG calibration complete in ");
+	MYSERIAL_PRINT((float)(customMillis() - _startTime) / 1000);
+	MYSERIAL_PRINTLN_PGM("s");
+
+	MYSERIAL_PRINTLN_PGM("Ch\tNoise\tMax\tPulses\tThresh\tHyst\tGain");
+
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		const CalChannel *cal = &_ch[c];
+		const EMGChannelSettings *cs = &settings.emg.channel[c];
+
+		falseTriggers += cal->falseTriggers;
+
+		MYSERIAL_PRINT(c);
+		MYSERIAL_PRINT_PGM("\t");
+		MYSERIAL_PRINT(cal->noiseCeil);
+		MYSERIAL_PRINT_PGM("\t");
+		MYSERIAL_PRINT(cal->maxAmp);
+		MYSERIAL_PRINT_PGM("\t");
+		MYSERIAL_PRINT(cal->numPulses);
+		MYSERIAL_PRINT_PGM("\t");
+
+		if (cal->calibrated)
+		{
+			MYSERIAL_PRINT(cs->peakThresh);
+			MYSERIAL_PRINT_PGM("\t");
+			MYSERIAL_PRINT(cs->hysteresis);
+			MYSERIAL_PRINT_PGM("%\tx");
+			MYSERIAL_PRINTLN((float)cs->gain / EMG_GAIN_UNITY);
+		}
+		else
+		{
+			MYSERIAL_PRINTLN_PGM("FAILED, no clear contraction, settings unchanged");
+		}
+	}
+
+	MYSERIAL_PRINT_PGM("False triggers - ");
+	MYSERIAL_PRINT(falseTriggers);
+	MYSERIAL_PRINT_PGM(" in ");
+	MYSERIAL_PRINT((float)CAL_VERIFY_TIME / 1000);
+	MYSERIAL_PRINT_PGM("s (");
+	MYSERIAL_PRINT((float)falseTriggers * 60000 / CAL_VERIFY_TIME);
+	MYSERIAL_PRINTLN_PGM(" per minute)");
+}
@@ -0,0 +1,121 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EMGCalibration.h
+*
+*/
+
+// Guided per-user EMG calibration (E1).
+// The user is prompted over serial through each stage, and the first CAL_SETTLE_TIME of each stage is ignored
+// while the user reacts to the prompt. Every sample of every channel is measured relative to the mean at rest,
+// and smoothed over (1 << CAL_SMOOTH_BITS) samples.
+//
+//		CAL_REST		relax, measure the mean, the standard deviation and the peak of the noise
+//		CAL_MAX			tense each muscle as hard as possible, measure the maximum amplitude
+//		CAL_PULSE		tense & relax each muscle CAL_NUM_PULSES times, measure the weakest deliberate contraction
+//		CAL_VERIFY		relax, count the PEAKs detected using the new thresholds (false triggers)
+//
+// For each channel, the noise ceiling is the larger of the noise peak and (EMG_DRIFT_SIGMAS x standard deviation).
+// The PEAK threshold is half way between the noise ceiling and the weakest pulse, and a PEAK ends half way between
+// the noise ceiling and the threshold (hysteresis). The gain scales the maximum amplitude to the full ADC range
+// for proportional control. A channel without a clear contraction (CAL_MIN_SNR x noise ceiling) keeps its settings.
+// Once calibrated, EMG_CONTROL raises the threshold of a channel while the noise at rest drifts above it.
+
+#ifndef EMG_CALIBRATION_H_
+#define EMG_CALIBRATION_H_
+
+#include <Arduino.h>
+
+#include "EMGControl.h"			// EMGchannel, NUM_EMG_CHANNELS
+#include "Initialisation.h"		// EMGChannelSettings
+
+#define CAL_SETTLE_TIME		1000	// ms, ignored at the start of each stage
+#define CAL_REST_TIME		5000	// ms, duration of each stage (after CAL_SETTLE_TIME)
+#define CAL_MAX_TIME		6000
+#define CAL_PULSE_TIME		12000
+#define CAL_VERIFY_TIME		5000
+
+#define CAL_NUM_PULSES		5		// pulses requested of each muscle
+#define CAL_MIN_SNR			3		// min (max contraction / noise ceiling) of a calibrated channel
+#define CAL_SMOOTH_BITS		3		// amplitude is smoothed over (1 << CAL_SMOOTH_BITS) samples
+
+typedef enum _CalStage
+{
+	CAL_OFF = 0,		// not calibrating
+	CAL_REST,			// measure the noise at rest
+	CAL_MAX,			// measure the maximum contraction
+	CAL_PULSE,			// measure repeated contractions
+	CAL_VERIFY			// count false triggers at rest
+} CalStage;
+
+typedef struct _CalChannel
+{
+	int32_t sum;			// sum of the samples at rest
+	uint64_t sumSq;			// sum of the squares of the samples at rest
+	uint32_t count;			// number of samples at rest
+
+	int restMean;			// mean sample at rest
+	int noiseSD;			// standard deviation of the samples at rest
+	int noisePeak;			// max amplitude at rest
+	int noiseCeil;			// max(noisePeak, EMG_DRIFT_SIGMAS x noiseSD)
+
+	int smooth;				// smoothed amplitude (sample - restMean)
+	int maxAmp;				// max smoothed amplitude
+
+	int pulseOn;			// provisional thresholds used to count the pulses
+	int pulseOff;
+	bool inPulse;			// a pulse is being measured
+	int pulsePeak;			// max amplitude of the current pulse
+	int pulseMin;			// weakest pulse
+	uint8_t numPulses;		// number of pulses detected
+
+	bool prevAbove;			// PEAK state of the previous sample, to count false triggers
+	uint16_t falseTriggers;	// number of PEAKs detected at rest
+
+	bool calibrated;		// new settings have been calculated
+} CalChannel;
+
+class EMG_CALIBRATION
+{
+	public:
+		EMG_CALIBRATION();
+
+		void start(void);						// start the calibration, from the CAL_REST stage
+		void cancel(void);						// stop the calibration, and restore the previous settings
+		bool running(void);						// returns true if a calibration is in progress
+
+		void addSample(EMGchannel *channel);	// measure the most recent sample of every channel, and move through the stages
+
+		void printSettings(void);				// print the calibrated & current threshold, hysteresis and gain of each channel
+
+	private:
+		CalStage _stage;						// current stage
+		uint32_t _startTime;					// ms, time the calibration started
+		uint32_t _stageTime;					// ms, time the current stage started
+		CalChannel _ch[NUM_EMG_CHANNELS];		// measurements of each channel
+		EMGChannelSettings _prev[NUM_EMG_CHANNELS];	// settings before the calibration, restored if it is cancelled
+		uint8_t _prevCalibrated;				// calibrated flag before the calibration
+
+		void startStage(CalStage stage);		// prompt the user, and start the timer of a stage
+		void endStage(void);					// process the measurements of the current stage, and start the next stage
+
+		void endRest(void);						// calculate the noise of each channel
+		void endMax(void);						// set the provisional pulse thresholds of each channel
+		void endPulse(void);					// calculate and apply the new settings of each channel
+		void endVerify(void);					// store the new settings, and print the results
+
+		void measure(CalChannel &cal, EMGchannel &channel);	// measure a sample during the current stage
+		void printResults(void);				// print the measurements & new settings of each channel, and the false trigger rate
+};
+
+extern EMG_CALIBRATION EMGCal;
+
+#endif // EMG_CALIBRATION_H_
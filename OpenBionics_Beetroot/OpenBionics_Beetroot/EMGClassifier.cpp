@@ -0,0 +1,291 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EMGClassifier.cpp
+*
+*/
+
+#include "Globals.h"
+#include "EMGClassifier.h"
+
+#include "Grips.h"				// NUM_GRIPS
+#include "I2C_EEPROM.h"			// EEPROM
+#include "Initialisation.h"		// EEPROM_LOC_BOARD_SETTINGS
+#include "SerialControl.h"		// SERIAL_BUFF_SIZE
+
+static_assert((EEPROM_LOC_CLASSIFIER + sizeof(LDAModel)) <= EEPROM_LOC_BOARD_SETTINGS, "the classifier model overlaps the settings in EEPROM, reduce CLASSIFIER_MAX_CLASSES");
+
+EMG_CLASSIFIER Classifier;
+
+////////////////////////////// Constructors/Destructors //////////////////////////////
+
+EMG_CLASSIFIER::EMG_CLASSIFIER()
+{
+	_model.init = 0;
+	_model.numClasses = 0;
+
+	_class = CLASSIFIER_REST;
+	_votes = 0;
+	_rested = true;
+	_grip = CLASSIFIER_NONE;
+
+	_uploading = false;
+	_numReceived = 0;
+	_checksum = 0;
+}
+
+////////////////////////////// Public Methods //////////////////////////////
+
+// load the model from EEPROM
+void EMG_CLASSIFIER::begin(void)
+{
+	EEPROM_readStruct(EEPROM_LOC_CLASSIFIER, _model);
+
+	if (!valid())
+		_model.numClasses = 0;
+
+	_class = CLASSIFIER_REST;
+	_votes = 0;
+	_rested = true;
+	_grip = CLASSIFIER_NONE;
+}
+
+// returns true if a valid model has been loaded
+bool EMG_CLASSIFIER::valid(void)
+{
+	return (!_uploading && (_model.init == CLASSIFIER_INIT_CODE) && (_model.numClasses > 0) && (_model.numClasses <= CLASSIFIER_MAX_CLASSES));
+}
+
+// classify a set of features (CLASSIFIER_NUM_INPUTS long), returns the class
+int EMG_CLASSIFIER::classify(const int32_t *inputs)
+{
+	int best = 0;
+	int64_t bestScore = 0;
+
+	for (int k = 0; k < _model.numClasses; k++)
+	{
+		const int32_t *w = _model.weight[k];
+		int64_t score = _model.bias[k];
+
+		for (int i = 0; i < CLASSIFIER_NUM_INPUTS; i++)
+		{
+			score += (int64_t)w[i] * inputs[i];
+		}
+
+		if ((k == 0) || (score > bestScore))
+		{
+			best = k;
+			bestScore = score;
+		}
+	}
+
+	return best;
+}
+
+// classify a set of features, and select a grip once the class is stable
+void EMG_CLASSIFIER::run(const int32_t *inputs)
+{
+	if (!valid())
+		return;
+
+	int c = classify(inputs);
+
+	if (c == _class)
+	{
+		if (_votes < CLASSIFIER_NUM_VOTES)
+			_votes++;
+	}
+	else
+	{
+		_class = c;
+		_votes = 1;
+	}
+
+	if (_votes < CLASSIFIER_NUM_VOTES)
+		return;
+
+	// select the grip of a stable class once, then wait for the muscles to rest before the next selection
+	if (_model.grip[_class] == CLASSIFIER_REST)
+	{
+		_rested = true;
+	}
+	else if (_rested)
+	{
+		_grip = _model.grip[_class];
+		_rested = false;
+	}
+}
+
+// returns the selected grip and clears it, or CLASSIFIER_NONE
+int EMG_CLASSIFIER::getGrip(void)
+{
+	int g = _grip;
+
+	_grip = CLASSIFIER_NONE;
+
+	return g;
+}
+
+// start receiving a model over serial
+void EMG_CLASSIFIER::startUpload(void)
+{
+	_uploading = true;
+	_numReceived = 0;
+	_checksum = 0;
+
+	_model.init = 0;
+	_model.numClasses = 0;
+
+	MYSERIAL_PRINTLN_PGM("Classifier upload - send the model values");
+}
+
+// returns true if a model is being received
+bool EMG_CLASSIFIER::uploading(void)
+{
+	return _uploading;
+}
+
+// receive a line of comma separated model values
+void EMG_CLASSIFIER::receive(char *buff)
+{
+	const int maxVals = (SERIAL_BUFF_SIZE / 2) + 1;		// each value is at least 1 digit and a comma
+	int vals[maxVals];
+	int n = convertFromCSV(buff, vals, maxVals);
+
+	for (int i = 0; (i < n) && _uploading; i++)
+	{
+		uint16_t total = 2 + (_model.numClasses * (2 + CLASSIFIER_NUM_INPUTS));	// number of values before the checksum
+
+		// the last value is the checksum
+		if ((_numReceived >= 2) && (_numReceived == total))
+		{
+			endUpload(vals[i] == _checksum);
+			return;
+		}
+
+		if (!storeValue(_numReceived, vals[i]))
+		{
+			endUpload(false);
+			return;
+		}
+
+		_checksum = (int32_t)((uint32_t)_checksum + (uint32_t)vals[i]);		// wrap without overflow
+		_numReceived++;
+	}
+}
+
+// print the model and the most recent class
+void EMG_CLASSIFIER::printStatus(void)
+{
+	if (_uploading)
+	{
+		MYSERIAL_PRINT_PGM("Classifier upload in progress, ");
+		MYSERIAL_PRINT(_numReceived);
+		MYSERIAL_PRINTLN_PGM(" values received");
+		return;
+	}
+
+	if (!valid())
+	{
+		MYSERIAL_PRINTLN_PGM("No classifier model, train with LDATrainer and upload with B3");
+		return;
+	}
+
+	MYSERIAL_PRINT_PGM("Classifier - ");
+	MYSERIAL_PRINT(_model.numClasses);
+	MYSERIAL_PRINT_PGM(" classes, ");
+	MYSERIAL_PRINT(CLASSIFIER_NUM_INPUTS);
+	MYSERIAL_PRINTLN_PGM(" inputs");
+
+	for (int k = 0; k < _model.numClasses; k++)
+	{
+		MYSERIAL_PRINT_PGM("Class ");
+		MYSERIAL_PRINT(k);
+		MYSERIAL_PRINT_PGM("\t");
+
+		if (_model.grip[k] == CLASSIFIER_REST)
+		{
+			MYSERIAL_PRINT_PGM("Rest");
+		}
+		else
+		{
+			MYSERIAL_PRINT(Grip.getGripName(_model.grip[k]));
+		}
+
+		if (k == _class)
+		{
+			MYSERIAL_PRINT_PGM("\t<");
+		}
+
+		MYSERIAL_PRINT_PGM("\n");
+	}
+}
+
+////////////////////////////// Private Methods //////////////////////////////
+
+// store an uploaded value, returns false if it is not valid
+bool EMG_CLASSIFIER::storeValue(uint16_t index, int32_t val)
+{
+	if (index == 0)
+	{
+		if ((val < 1) || (val > CLASSIFIER_MAX_CLASSES))
+			return false;
+
+		_model.numClasses = val;
+		return true;
+	}
+
+	if (index == 1)
+		return (val == CLASSIFIER_NUM_INPUTS);
+
+	// each class is a grip number, a bias and the weights
+	int k = (index - 2) / (2 + CLASSIFIER_NUM_INPUTS);
+	int j = (index - 2) % (2 + CLASSIFIER_NUM_INPUTS);
+
+	if (j == 0)
+	{
+		if ((val < CLASSIFIER_REST) || (val >= NUM_GRIPS))
+			return false;
+
+		_model.grip[k] = val;
+	}
+	else if (j == 1)
+	{
+		_model.bias[k] = val;
+	}
+	else
+	{
+		_model.weight[k][j - 2] = val;
+	}
+
+	return true;
+}
+
+// finish receiving a model, and store it if it is valid
+void EMG_CLASSIFIER::endUpload(bool success)
+{
+	_uploading = false;
+
+	if (success)
+	{
+		_model.init = CLASSIFIER_INIT_CODE;
+		EEPROM_writeStruct(EEPROM_LOC_CLASSIFIER, _model);
+
+		MYSERIAL_PRINTLN_PGM("Classifier upload complete");
+	}
+	else
+	{
+		MYSERIAL_PRINT_PGM("Classifier upload FAILED at value ");
+		MYSERIAL_PRINTLN(_numReceived);
+	}
+
+	begin();		// reload the stored model
+}
@@ -0,0 +1,94 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EMGClassifier.h
+*
+*/
+
+// Linear discriminant analysis (LDA) grip classifier.
+// Each new set of EMG features (NUM_EMG_FEATURES for each channel, see EMGFeatures.h) is classified by taking the
+// class with the highest score, where score = bias + sum(weight x feature). The weights and biases are trained on
+// the host (Host/tools/LDATrainer.cpp) from recorded EMG traces (A7), scaled to integers, and uploaded over
+// serial (B3) into EEPROM. Scores are accumulated as int64_t, so inference is
+// (CLASSIFIER_MAX_CLASSES x CLASSIFIER_NUM_INPUTS) multiplies, tens of us on the SAMD21.
+//
+// Each class is mapped to a grip number, or CLASSIFIER_REST. A grip is only selected once the same class has
+// been detected for CLASSIFIER_NUM_VOTES consecutive sets of features, and the next grip can only be selected
+// after CLASSIFIER_REST has been detected again.
+//
+// Upload format (B3), a sequence of comma separated integers over any number of lines:
+//
+//		numClasses, numInputs, { grip, bias, weight[numInputs] } x numClasses, checksum
+//
+// where checksum is the sum of all of the previous values (int32_t, wrapping).
+
+#ifndef EMG_CLASSIFIER_H_
+#define EMG_CLASSIFIER_H_
+
+#include <Arduino.h>
+
+#include "EMGControl.h"			// NUM_EMG_CHANNELS
+#include "EMGFeatures.h"		// NUM_EMG_FEATURES
+
+#define CLASSIFIER_MAX_CLASSES	((NUM_EMG_CHANNELS > 6) ? 5 : ((NUM_EMG_CHANNELS > 4) ? 6 : 8))	// rest + grips, limited by the space for the model in EEPROM
+#define CLASSIFIER_NUM_INPUTS	(NUM_EMG_CHANNELS * NUM_EMG_FEATURES)	// features of each channel, in channel order
+#define CLASSIFIER_REST			-1		// class grip number, do not select a grip
+#define CLASSIFIER_NONE			-2		// no grip selection is pending
+#define CLASSIFIER_NUM_VOTES	4		// number of consecutive detections needed to select a grip
+
+#define EEPROM_LOC_CLASSIFIER	0		// location within EEPROM of the classifier model (up to EEPROM_LOC_BOARD_SETTINGS)
+#define CLASSIFIER_INIT_CODE	0xB1	// stored with a valid model
+
+typedef struct _LDAModel
+{
+	uint8_t init;											// CLASSIFIER_INIT_CODE if a valid model has been stored
+	uint8_t numClasses;										// number of classes
+	int8_t grip[CLASSIFIER_MAX_CLASSES];					// grip number of each class, or CLASSIFIER_REST
+	int32_t bias[CLASSIFIER_MAX_CLASSES];					// bias of each class
+	int32_t weight[CLASSIFIER_MAX_CLASSES][CLASSIFIER_NUM_INPUTS];	// weight of each feature, for each class
+} LDAModel;
+
+class EMG_CLASSIFIER
+{
+	public:
+		EMG_CLASSIFIER();
+
+		void begin(void);						// load the model from EEPROM
+		bool valid(void);						// returns true if a valid model has been loaded
+
+		int classify(const int32_t *inputs);	// classify a set of features (CLASSIFIER_NUM_INPUTS long), returns the class
+		void run(const int32_t *inputs);		// classify a set of features, and select a grip once the class is stable
+		int getGrip(void);						// returns the selected grip and clears it, or CLASSIFIER_NONE
+
+		void startUpload(void);					// start receiving a model over serial
+		bool uploading(void);					// returns true if a model is being received
+		void receive(char *buff);				// receive a line of comma separated model values
+
+		void printStatus(void);					// print the model and the most recent class
+
+	private:
+		LDAModel _model;						// model used for classification, or being received
+		int _class;								// most recent class
+		uint8_t _votes;							// number of consecutive detections of _class
+		bool _rested;							// CLASSIFIER_REST has been detected since the last grip selection
+		int _grip;								// selected grip, or CLASSIFIER_NONE
+
+		bool _uploading;						// a model is being received
+		uint16_t _numReceived;					// number of values received
+		int32_t _checksum;						// sum of the values received
+
+		bool storeValue(uint16_t index, int32_t val);	// store an uploaded value, returns false if it is not valid
+		void endUpload(bool success);			// finish receiving a model, and store it if it is valid
+};
+
+extern EMG_CLASSIFIER Classifier;
+
+#endif // EMG_CLASSIFIER_H_
@@ -16,16 +16,78 @@
 #include "Globals.h"
 #include "EMGControl.h"
 
+#include "EMGADC.h"
+#include "EMGCalibration.h"
+#include "EMGStream.h"
+#include "EMGClassifier.h"
+#include "EMGGesture.h"
+#include "EMGStrategy.h"
+#include "ErrorHandling.h"
 #include "Grips.h"
+#include "I2C_ADC_MAX1161X.h"
 #include "Initialisation.h"
 #include "TimerManagement.h"
+#include "Trace.h"
+
+static_assert((NUM_EMG_CHANNELS >= 1) && (NUM_EMG_CHANNELS <= EMG_MAX_CHANNELS), "NUM_EMG_CHANNELS must be 1 - EMG_MAX_CHANNELS");
+static_assert(EMG_OPEN_CHANNEL < NUM_EMG_CHANNELS, "EMG_OPEN_CHANNEL is not a valid channel");
+static_assert((NUM_EMG_CHANNELS == 1) || ((EMG_CLOSE_CHANNEL < NUM_EMG_CHANNELS) && (EMG_CLOSE_CHANNEL != EMG_OPEN_CHANNEL)), "EMG_CLOSE_CHANNEL is not a valid channel");
+static_assert((sizeof(EMGchannel) * NUM_EMG_CHANNELS) <= EMG_RAM_BUDGET, "the EMG channels use more than EMG_RAM_BUDGET, shorten the windows (EMG_WINDOW_SHRINK)");
+
+#if defined(USE_I2C_ADC)
+static_assert(NUM_EMG_CHANNELS <= MAX1161X_MAX_CHANNELS, "NUM_EMG_CHANNELS is greater than the number of I2C ADC channels");
+static_assert(MAX1161X_FRAME_US(NUM_EMG_CHANNELS) <= ((1000000UL / EMG_SAMPLE_RATE) / 2), "an I2C ADC frame takes more than half of the sample period, reduce NUM_EMG_CHANNELS or EMG_SAMPLE_RATE");
+#else
+static_assert(NUM_EMG_CHANNELS <= EMG_ADC_MAX_CHANNELS, "NUM_EMG_CHANNELS is greater than the number of SAMD21 ADC channels, use USE_I2C_ADC");
+
+// analogue pin of each channel
+static const int emgChannelPins[] = EMG_CHANNEL_PINS;
+static_assert((sizeof(emgChannelPins) / sizeof(emgChannelPins[0])) == NUM_EMG_CHANNELS, "EMG_CHANNEL_PINS must list a pin for each channel");
+#endif
+
+#if defined(USE_EMG_FILTER)
+static_assert(EMG_FILTER_LP_FREQ < (EMG_SAMPLE_RATE / 2), "EMG_FILTER_LP_FREQ must be below the Nyquist frequency");
+
+// filter stages, designed by the compiler for the EMG sample rate
+static constexpr BiquadCoeffs emgFilterCoeffs[EMG_FILTER_STAGES] =
+{
+	biquadHighPass(EMG_SAMPLE_RATE, EMG_FILTER_HP_FREQ, BIQUAD_Q_BUTTERWORTH),
+	biquadNotch(EMG_SAMPLE_RATE, EMG_FILTER_NOTCH_FREQ, EMG_FILTER_NOTCH_Q),
+	biquadLowPass(EMG_SAMPLE_RATE, EMG_FILTER_LP_FREQ, BIQUAD_Q_BUTTERWORTH)
+};
+#endif
+
+// control strategy of each EMG mode, specialised for the number of channels and the polarity
+static EMG_SIMPLE_CONTROL <NUM_EMG_CHANNELS> simpleControl;
+static EMG_PROPORTIONAL_CONTROL <NUM_EMG_CHANNELS, EMG_POLARITY> proportionalControl;
+
+// number of samples a PEAK needs to be held to be recognised as a HOLD (settings.emg.holdTime at EMG_SAMPLE_RATE)
+static uint32_t holdSamples(void)
+{
+	return ((uint32_t)settings.emg.holdTime * EMG_SAMPLE_RATE) / 1000;
+}
+
+// toggle direction between open & close when a PEAK is detected
+static void control_simple(EMGchannel *channel)
+{
+	simpleControl.run(channel);
+}
+
+// open/close the hand at a speed proportional to the magnitude of the EMG signal
+static void control_proportional(EMGchannel *channel)
+{
+	proportionalControl.run(channel);
+}
 
 ////////////////////////////// Constructors/Destructors //////////////////////////////
 
 EMG_CONTROL::EMG_CONTROL()
 {
 	_mode = EMG_OFF;
+	_control = NULL;
 	_printVals = false;
+	_newFeatures = false;
+	_activeTime = 0;
 }
 
 ////////////////////////////// Public Methods //////////////////////////////
@@ -35,31 +97,69 @@ void EMG_CONTROL::begin(void)
 {
 	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
 	{
-		_channel[c].noiseFloor.begin(NOISE_BUFFER_SIZE);
+		_channel[c].noiseFloor.begin();
 
 		for (int i = 0; i < NOISE_BUFFER_SIZE; i++)
 		{
 			_channel[c].noiseFloor.write(BUFFER_DEFAULT_VAL);
 		}
+
+		_channel[c].features.begin(EMG_FEATURE_HOP, EMG_FEATURE_ZC_THRESH, EMG_FEATURE_SSC_THRESH);
+
+#if defined(USE_EMG_FILTER)
+		_channel[c].filter.begin(emgFilterCoeffs);
+		_channel[c].envelope.begin();
+#endif
+
+		_channel[c].role = EMG_ROLE_NONE;
+		_channel[c].above = false;
+
+		setDetector(c, (settings.emg.onset & (1 << c)) ? EMG_DETECT_ONSET : EMG_DETECT_THRESHOLD);
 	}
 
+	// assign the open/close channels, a single channel toggles between open & close
+#if (NUM_EMG_CHANNELS == 1)
+	_channel[EMG_OPEN_CHANNEL].role = EMG_ROLE_TOGGLE;
+#else
+	_channel[EMG_OPEN_CHANNEL].role = EMG_ROLE_OPEN;
+	_channel[EMG_CLOSE_CHANNEL].role = EMG_ROLE_CLOSE;
+#endif
+
+	updateThresholds();
+
 
-#if defined(USE_I2C_EMG)
+#if defined(USE_I2C_ADC)
 	setHeadphoneJack(JACK_I2C);		// set comms switch to I2C over the headphone jack
+
+	// configure the I2C ADC to scan every channel
+	if (!ADC2.begin(NUM_EMG_CHANNELS, EMG_SAMPLE_RES))
+		ERROR.set(ERROR_EMG_ADC_INIT);
+
+	_frameTime = micros();
 #else
 	setHeadphoneJack(JACK_ADC);		// set comms switch to ADC over the headphone jack
 
-	attachPin(0, A4);		// if using analogue EMG, attach analogue pins
-	#if (NUM_EMG_CHANNELS > 1 )
-		attachPin(1, A5);	// if using analogue EMG, attach analogue pins
-	#endif
+	// if using analogue EMG, attach analogue pins
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		attachPin(c, emgChannelPins[c]);
+	}
+
+	// set up the ADC conversions of the attached pins, which are scanned while EMG is in use
+	int pins[NUM_EMG_CHANNELS];
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		pins[c] = _channel[c].pin;
+	}
+	if (!EMGADC.begin(pins, NUM_EMG_CHANNELS, EMG_SAMPLE_RATE, EMG_SAMPLE_RES, EMG_SAMPLE_AVG))
+		ERROR.set(ERROR_EMG_ADC_INIT);
 #endif
 }
 
 // check whether EMG mode is enabled
 bool EMG_CONTROL::enabled(void)
 {
-	if ((_mode == MODE_EMG_SIMPLE) || (_mode == MODE_EMG_PROP))
+	if ((_mode == EMG_SIMPLE) || (_mode == EMG_PROPORTIONAL))
 		return true;
 	else
 		return false;
@@ -68,19 +168,37 @@ bool EMG_CONTROL::enabled(void)
 // run EMG acquisition, analysis and control
 void EMG_CONTROL::run(void)
 {
-	if (_mode == EMG_OFF)
+	if ((_mode == EMG_OFF) && !EMGCal.running() && !EMGStream.streaming())
+	{
+#if !defined(USE_I2C_ADC)
+		EMGADC.stop();		// leave the ADC to the fingers
+#endif
 		return;
+	}
 
-	// read the raw sample data and remove the noise floor
-	getSample();
+#if !defined(USE_I2C_ADC)
+	if (!EMGADC.scanning())
+	{
+		EMGADC.start();
+		_activeTime = micros();		// scan at the full rate until the noise floor has been measured
+	}
+#endif
 
-	// detect PEAK or HOLD on each EMG channel
-	analyseSignal();
+	// read the raw sample data, remove the noise floor and detect PEAK or HOLD on each EMG channel
+	if (!acquire())
+		return;
 
 	// print ADC values if M3 is enabled
 	if (_printVals)
 		printEMGData();
 
+	// the hand is not controlled while the muscles are being calibrated (or while calibrating or streaming from EMG_OFF)
+	if (EMGCal.running() || (_mode == EMG_OFF))
+	{
+		EMGGesture.clear();		// discard any gestures, rather than acting on them once control resumes
+		return;
+	}
+
 	// control hand using either simple or proportional mode
 	control();
 }
@@ -100,15 +218,92 @@ bool EMG_CONTROL::toggleADCVals(void)
 	return _printVals;
 }
 
+// most recent set of time-domain features of a channel (NUM_EMG_FEATURES long)
+const int32_t *EMG_CONTROL::getFeatures(int ch)
+{
+	return _channel[ch].features.read();
+}
+
 // set EMG to off, simple or proportional mode 
 void EMG_CONTROL::setMode(EMGMode mode)
 {
-	if (IS_BETWEEN(mode, EMG_OFF, EMG_PROPORTIONAL))
+	if (!IS_BETWEEN(mode, EMG_OFF, EMG_PROPORTIONAL))
+		return;
+
+	_mode = mode;
+
+	// select the control strategy of the mode, and restart it from the current state of the hand
+	switch (_mode)
 	{
-		_mode = mode;
+	case EMG_SIMPLE:
+		simpleControl.begin();
+		_control = control_simple;
+		break;
+	case EMG_PROPORTIONAL:
+		proportionalControl.begin();
+		_control = control_proportional;
+		break;
+	default:
+		_control = NULL;
+		break;
 	}
 }
 
+// set the PEAK threshold of each channel from the settings, raised if the noise floor has increased (drift)
+void EMG_CONTROL::updateThresholds(void)
+{
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		const EMGChannelSettings *cs = &settings.emg.channel[c];
+		int thresh = cs->peakThresh;
+
+		// a calibrated threshold follows the noise at rest while it is above the threshold (a threshold set by hand is fixed)
+		if (settings.emg.calibrated)
+		{
+			int noise = EMG_DRIFT_SIGMAS * isqrt32(_channel[c].noiseFloor.readVariance());
+
+			if (noise > thresh)
+				thresh = noise;
+		}
+
+		_channel[c].peakThresh = thresh;
+		_channel[c].endThresh = thresh - ((thresh * cs->hysteresis) / 100);
+	}
+}
+
+// current PEAK threshold of a channel, including any drift
+int EMG_CONTROL::getPeakThresh(int ch)
+{
+	return _channel[ch].peakThresh;
+}
+
+// us, time of the sample that triggered the most recent PEAK of a channel
+uint32_t EMG_CONTROL::getPeakTime(int ch)
+{
+	return _channel[ch].peakTime;
+}
+
+// set how a PEAK of a channel is detected, and restart the detection
+void EMG_CONTROL::setDetector(int ch, EMGDetector detector)
+{
+	if (ch >= NUM_EMG_CHANNELS)
+		return;
+
+	_channel[ch].detector = detector;
+	_channel[ch].onset.begin(EMG_ONSET_ON_DEVS, EMG_ONSET_OFF_DEVS, EMG_ONSET_MIN_ON, EMG_ONSET_MIN_OFF, EMG_ONSET_INIT_DEV, EMG_ONSET_MIN_DEV);
+
+	_channel[ch].PEAK = false;
+	_channel[ch].HOLD = false;
+	_channel[ch].holdCount = -1;
+	_channel[ch].above = false;
+}
+
+// how a PEAK of a channel is detected
+EMGDetector EMG_CONTROL::getDetector(int ch)
+{
+	return _channel[ch].detector;
+}
+
 // set EMG mode to EMG_OFF
 void EMG_CONTROL::off(void)
 {
@@ -130,28 +325,105 @@ void EMG_CONTROL::proportional(void)
 
 ////////////////////////////// Private Methods //////////////////////////////
 
-// read an EMG sample, add to noise floor, store active component as signal
-void EMG_CONTROL::getSample(void)
+// read and analyse every new EMG sample, returns false if there are no new samples
+bool EMG_CONTROL::acquire(void)
+{
+	int samples[NUM_EMG_CHANNELS];
+
+#if defined(USE_I2C_ADC)
+	const uint32_t framePeriod = 1000000UL / EMG_SAMPLE_RATE;		// us
+	uint32_t now = micros();
+
+	// read a frame of every channel at EMG_SAMPLE_RATE
+	if ((int32_t)(now - _frameTime) < 0)
+		return false;
+
+	_frameTime += framePeriod;
+
+	// if more than a frame behind, skip the missed frames rather than reading them in a burst
+	if ((int32_t)(now - _frameTime) >= 0)
+		_frameTime = now + framePeriod;
+
+	if (!ADC2.read(samples))
+		return false;
+
+	getSample(samples, now);
+	extractFeatures();
+	analyseSignal();
+
+	if (EMGCal.running())
+		EMGCal.addSample(_channel);
+
+	EMGStream.addSample(_channel);
+#else
+	if (!EMGADC.available())
+		return false;
+
+	// analyse every scan of each complete block, so that the signal analysis sees a uniform sample rate
+	do
+	{
+		uint8_t numScans = EMGADC.getNumScans();
+		uint32_t sampleTime = 0;
+
+		for (uint8_t s = 0; s < numScans; s++)
+		{
+			for (uint8_t c = 0; c < NUM_EMG_CHANNELS; c++)
+			{
+				samples[c] = EMGADC.read(s, c);
+			}
+
+			sampleTime = EMGADC.getScanTime(s);
+			getSample(samples, sampleTime);
+			extractFeatures();
+			analyseSignal();
+
+			if (EMGCal.running())
+				EMGCal.addSample(_channel);
+
+			EMGStream.addSample(_channel);
+		}
+
+		EMGADC.release();
+
+		// scan at the idle rate once every channel has been at the noise floor for EMG_IDLE_DELAY,
+		// and return to the full rate from the next tick after the first sample above it
+		EMGADC.setIdle(idleAllowed() && ((sampleTime - _activeTime) >= (EMG_IDLE_DELAY * 1000UL)));
+	} while (EMGADC.available());
+#endif
+
+	return true;
+}
+
+// add an EMG sample to noise floor, store active component as signal
+void EMG_CONTROL::getSample(const int *samples, uint32_t sampleTime)
 {
 	for (uint8_t c = 0; c < NUM_EMG_CHANNELS; c++)
 	{
-		// read raw EMG sample
-#ifdef USE_I2C_ADC
-		_channel[c].sample = ADC2.read(c);
-#else
-		noInterrupts();
-		_channel[c].sample = analogRead(_channel[c].pin);
-		interrupts();
+		_channel[c].sample = samples[c];
+		_channel[c].sampleTime = sampleTime;		// timestamp the sample, to measure the latency to the resulting grip command
+
+		int level = _channel[c].sample;
+
+#if defined(USE_EMG_FILTER)
+		level = filterSample(c, level);				// use the envelope of the filtered sample
 #endif
 
-		// add to noise floor if muscle is NOT active
-		calcNoiseFloor(c, _channel[c].sample);
+		_channel[c].level = level;
+
+		// add to noise floor if muscle is NOT active, otherwise store the time of the activity
+		if (!calcNoiseFloor(c, level))
+			_activeTime = sampleTime;
 
 		// store the previous signal for signal analysis
 		_channel[c].prevSignal = _channel[c].signal;
 
 		// signal is the size of the active signal (signal > noise floor), and is always >= 0
-		_channel[c].signal = _channel[c].sample - _channel[c].noiseFloor.readMean();
+		_channel[c].signal = level - _channel[c].noiseFloor.readMean();
+
+#if !defined(USE_EMG_FILTER)
+		_channel[c].filtered = _channel[c].signal;		// without the band-pass filter, use the sample with the noise floor removed
+#endif
+
 		if (_channel[c].signal < 0)
 			_channel[c].signal = 0;
 
@@ -161,69 +433,193 @@ void EMG_CONTROL::getSample(void)
 		else
 			_channel[c].active = false;
 	}
+
+	// record the raw samples, if trace recording is enabled
+	Trace.recordSamples(TRACE_EMG, samples, NUM_EMG_CHANNELS, sampleTime);
 }
 
-// detect whether EMG is in a PEAK or HOLD
+// filter a raw sample, then return the envelope (RMS or mean absolute value) of the filtered signal
+int EMG_CONTROL::filterSample(int ch, int sample)
+{
+#if defined(USE_EMG_FILTER)
+	int filtered = _channel[ch].filter.run((int32_t)sample << EMG_FILTER_SHIFT) >> EMG_FILTER_SHIFT;
+
+	_channel[ch].filtered = filtered;
+
+#if defined(EMG_ENVELOPE_RMS)
+	_channel[ch].envelope.write(filtered);
+	return isqrt32(_channel[ch].envelope.readMeanSquare());
+#else
+	_channel[ch].envelope.write(abs(filtered));
+	return _channel[ch].envelope.readMean();
+#endif
+
+#else
+	(void)ch;			// unused without the band-pass filter
+	return sample;
+#endif
+}
+
+// add the latest sample of each channel to the feature windows
+void EMG_CONTROL::extractFeatures(void)
+{
+	bool ready = false;
+
+	for (uint8_t c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		if (_channel[c].features.write(_channel[c].filtered))
+			ready = true;
+	}
+
+	if (!ready)
+		return;
+
+	_newFeatures = true;
+
+	// track any drift of the noise at rest, at the rate of the features
+	updateThresholds();
+
+	// classify the features of all channels, to select a grip
+	if (settings.classifierEn)
+	{
+		int32_t inputs[CLASSIFIER_NUM_INPUTS];
+
+		for (uint8_t c = 0; c < NUM_EMG_CHANNELS; c++)
+		{
+			memcpy(&inputs[c * NUM_EMG_FEATURES], _channel[c].features.read(), NUM_EMG_FEATURES * sizeof(int32_t));
+		}
+
+		Classifier.run(inputs);
+	}
+}
+
+// detect whether EMG is in a PEAK or HOLD, and follow any gestures
 void EMG_CONTROL::analyseSignal(void)
 {
 	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
 	{
-
-		//if (!_channel[c].active)		// if the muscle is not active
-		//	break;						// end channel analysis
+		if (_channel[c].detector == EMG_DETECT_ONSET)
+		{
+			analyseOnset(_channel[c]);
+			continue;
+		}
 
 		if (!_channel[c].active)			// if the muscle is not active
 		{
 			_channel[c].PEAK = false;		// clear PEAK flag	
 			_channel[c].HOLD = false;		// set HOLD flag
-			_channel[c].HOLD_timer.stop();	// stop HOLD timer
+			_channel[c].holdCount = -1;		// stop timing the HOLD
+			_channel[c].above = false;
 
-			break;							// end channel analysis
+			continue;						// end analysis of this channel
 		}
 
-		if (_channel[c].HOLD_timer.started())			// if HOLD timer is running
+		// the HOLD is timed by counting samples, so it does not depend on how late the samples are processed
+		if (_channel[c].holdCount >= 0)					// if the HOLD is being timed
 		{
-			if (_channel[c].HOLD_timer.timeElapsed(settings.emg.holdTime) && !_channel[c].HOLD)	// if PEAK has been HELD and HOLD flag is not set
+			if ((++_channel[c].holdCount >= (int32_t)holdSamples()) && !_channel[c].HOLD)	// if PEAK has been HELD and HOLD flag is not set
 			{
 				_channel[c].HOLD = true;				// set HOLD flag		
-				_channel[c].HOLD_timer.stop();			// stop HOLD timer
+				_channel[c].holdCount = -1;				// stop timing the HOLD
 			}
 		}
 
-		if (detect_peakStart(_channel[c].signal, _channel[c].prevSignal))							// if at PEAK_START
+		if (detect_peakStart(_channel[c]))								// if at PEAK_START
 		{
-			_channel[c].HOLD_timer.start();				// start HOLD timer
-#if (NUM_EMG_CHANNELS == 2)
-			_channel[c].PEAK = true;					// set single PEAK flag	
-#endif
+			_channel[c].holdCount = 0;					// start timing the HOLD
+
+			// a toggle channel only triggers a PEAK once it is released, so that a HOLD does not also toggle
+			if (_channel[c].role != EMG_ROLE_TOGGLE)
+			{
+				_channel[c].PEAK = true;				// set single PEAK flag	
+				_channel[c].peakTime = _channel[c].sampleTime;
+			}
 		}
-		else if (detect_peakEnd(_channel[c].signal, _channel[c].prevSignal))						// if at PEAK_END
+		else if (detect_peakEnd(_channel[c]))							// if at PEAK_END
 		{
-			_channel[c].HOLD_timer.stop();				// stop HOLD timer
+			_channel[c].holdCount = -1;					// stop timing the HOLD
 
-#if (NUM_EMG_CHANNELS == 1)
-			// if the muscle is not held, then trigger a PEAK
-			if (!_channel[c].HOLD)
-				_channel[c].PEAK = true;				// set single PEAK flag	
+			if (_channel[c].role == EMG_ROLE_TOGGLE)
+			{
+				// if the muscle is not held, then trigger a PEAK
+				if (!_channel[c].HOLD)
+				{
+					_channel[c].PEAK = true;			// set single PEAK flag	
+					_channel[c].peakTime = _channel[c].sampleTime;
+				}
+			}
+			else
+			{
+				_channel[c].PEAK = false;				// clear PEAK flag	
+			}
+		}
+	}
+
+	EMGGesture.addSample(_channel);
+}
+
+// detect whether EMG is in a PEAK or HOLD, using the onset detector
+// a PEAK lasts from the onset to the offset, and a HOLD is counted in samples from the onset (excluding the offset delay)
+void EMG_CONTROL::analyseOnset(EMGchannel &channel)
+{
+	uint32_t prevDuration = channel.onset.duration();
 
+#if defined(USE_EMG_FILTER)
+	OnsetEvent event = channel.onset.write(channel.filtered);		// Teager-Kaiser energy of the raw EMG
 #else
-			_channel[c].PEAK = false;					// clear PEAK flag	
+	// the envelope is smooth, so its Teager-Kaiser energy is ~0 during a steady contraction, use the square instead
+	OnsetEvent event = channel.onset.writeEnergy((int32_t)channel.filtered * abs(channel.filtered));
 #endif
+	uint32_t numHoldSamples = holdSamples();
+
+	channel.above = channel.onset.active();
+
+	if (event == ONSET_START)
+	{
+		// a toggle channel only triggers a PEAK once it is released, so that a HOLD does not also toggle
+		if (channel.role != EMG_ROLE_TOGGLE)
+		{
+			channel.PEAK = true;
+			channel.peakTime = channel.sampleTime;
 		}
 	}
+	else if (event == ONSET_END)
+	{
+		if (channel.role == EMG_ROLE_TOGGLE)
+		{
+			// if the muscle was not held, then trigger a PEAK
+			if (channel.onset.duration() < numHoldSamples)
+			{
+				channel.PEAK = true;
+				channel.peakTime = channel.sampleTime;
+			}
+		}
+		else
+		{
+			channel.PEAK = false;
+		}
+
+		channel.HOLD = false;
+	}
+	else if (channel.above && (prevDuration < numHoldSamples) && (channel.onset.duration() >= numHoldSamples))
+	{
+		channel.HOLD = true;
+	}
 }
 
 // print EMG signal, raw value, noise floor, peak flag and hold flag
 void EMG_CONTROL::printEMGData(void)
 {
-	const char* open_close[2] = { "Open", "Close" };
-
 	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
 	{
-#if (NUM_EMG_CHANNELS == 2)
-		MYSERIAL_PRINT(open_close[c]);
-		MYSERIAL_PRINT_PGM("  ");
-#endif
+		if (_channel[c].role == EMG_ROLE_OPEN)
+		{
+			MYSERIAL_PRINT_PGM("Open  ");
+		}
+		else if (_channel[c].role == EMG_ROLE_CLOSE)
+		{
+			MYSERIAL_PRINT_PGM("Close  ");
+		}
 		MYSERIAL_PRINT_PGM("M");
 		MYSERIAL_PRINT(c);
 		MYSERIAL_PRINT_PGM(": ");
@@ -251,198 +647,129 @@ void EMG_CONTROL::printEMGData(void)
 	}
 
 	MYSERIAL_PRINT_PGM("\n");
-}
 
-// change grip if HOLD, and run EMG control mode (simple or proportional)
-void EMG_CONTROL::control(void)
-{
-	// if the OPEN muscle has been HELD
-	if (_channel[0].HOLD)			
+#if defined(PRINT_EMG_FEATURES)
+	// print each new set of features
+	if (_newFeatures)
 	{
-		// reset HOLD flag
-		_channel[0].HOLD = false;
+		_newFeatures = false;
 
-		// cycle to next grip
-		Grip.nextGrip();
-		Grip.open();
-		Grip.run();
-
-		MYSERIAL_PRINTLN_PGM("Grip Change");
-		MYSERIAL_PRINT_PGM("Grip ");
-		MYSERIAL_PRINTLN(Grip.getGripName());
-	}
+		for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+		{
+			const int32_t *f = getFeatures(c);
+
+			MYSERIAL_PRINT_PGM("F");
+			MYSERIAL_PRINT(c);
+			MYSERIAL_PRINT_PGM(": MAV ");
+			MYSERIAL_PRINT(f[FEATURE_MAV]);
+			MYSERIAL_PRINT_PGM(" WL ");
+			MYSERIAL_PRINT(f[FEATURE_WL]);
+			MYSERIAL_PRINT_PGM(" ZC ");
+			MYSERIAL_PRINT(f[FEATURE_ZC]);
+			MYSERIAL_PRINT_PGM(" SSC ");
+			MYSERIAL_PRINT(f[FEATURE_SSC]);
+			MYSERIAL_PRINT_PGM(" VAR ");
+			MYSERIAL_PRINT(f[FEATURE_VAR]);
+			MYSERIAL_PRINT_PGM("\t");
+		}
 
-	// run EMG control mode
-	switch (settings.mode)
-	{
-	case MODE_EMG_SIMPLE:
-		control_simple();
-		break;
-	case MODE_EMG_PROP:
-		control_proportional();
-		break;
-	default:
-		break;
+		MYSERIAL_PRINT_PGM("\n");
 	}
+#endif
 }
 
-// toggle direction between open & close when a PEAK is detected
-void EMG_CONTROL::control_simple(void)
+// change grip if a gesture is recognised (or if the classifier has selected a grip), and run the control strategy of the EMG mode (simple or proportional)
+void EMG_CONTROL::control(void)
 {
-	const char *open_close[2] = { "OPEN","CLOSE" };
-
-#if (NUM_EMG_CHANNELS == 1)
-
-	// if channel has triggered a PEAK, and hand is not already OPEN
-	if (_channel[0].PEAK)
-	{
-		_channel[0].PEAK = false;                // reset PEAK trigger
-
-		Grip.setDir(!Grip.getDir());
-		Grip.run();
-
-		MYSERIAL_PRINT_PGM("Arm ");
-		MYSERIAL_PRINTLN(open_close[Grip.getDir()]);
-	}
-
-#elif (NUM_EMG_CHANNELS == 2)
-	// if OPEN channel has triggered a PEAK, and hand is not already OPEN
-	if (_channel[0].PEAK && (Grip.getDir() != OPEN))
-	{
-		_channel[0].PEAK = false;                // reset PEAK trigger
-		MYSERIAL_PRINTLN_PGM("Arm OPEN");
-
-		Grip.setDir(OPEN);
-
-	}
-	else if (_channel[1].PEAK && (Grip.getDir() != CLOSE))
+	// if grips are selected by the classifier
+	if (settings.classifierEn && Classifier.valid())
 	{
-		_channel[1].PEAK = false;                // reset PEAK trigger
-		MYSERIAL_PRINTLN_PGM("Arm CLOSE");
-		
-		Grip.setDir(CLOSE);
-	}
-
-	Grip.run();
+		int g = Classifier.getGrip();
 
-#endif
-}
-
-// open/close the hand at a speed proportional to the magnitude of the EMG signal
-void EMG_CONTROL::control_proportional(void)
-{
-#if (NUM_EMG_CHANNELS == 1)
+		// gestures are not used to change grip
+		EMGGesture.clear();
 
-	static double pos = 0;
+		if (g >= 0)
+		{
+			Grip.setGrip(g);
+			Grip.open();
+			Grip.run();
 
-#if defined(TENSE_CLOSE_RELAX_OPEN)
-	if (EMG[0].signal > 0)
-	{
-		pos -= calcPosChange(EMG[0].signal);
-	}
-	else
-	{
-		pos += calcPosChange(900);
-	}
-#elif defined(TENSE_OPEN_RELAX_CLOSE)
-	if (EMG[0].signal > 0)
-	{
-		pos += calcPosChange(EMG[0].signal);
+			MYSERIAL_PRINTLN_PGM("Grip Classified");
+			MYSERIAL_PRINT_PGM("Grip ");
+			MYSERIAL_PRINTLN(Grip.getGripName());
+		}
 	}
+	// otherwise run the action of each recognised gesture (e.g. HOLD the OPEN muscle to cycle to the next grip)
 	else
 	{
-		pos -= calcPosChange(900);
-	}
-#endif
-
-	//MYSERIAL_PRINT_PGM("pos: ");
-	//MYSERIAL_PRINTLN_PGM(pos);
-
-	pos = constrain(pos, 0, 100);
-
-	Grip.setPos(pos);
-	Grip.run();
+		Gesture g;
 
-#elif (NUM_EMG_CHANNELS == 2)
-	static double pos = 0;
-
-	if (_channel[0].signal > _channel[1].signal)
-	{
-		pos += calcPosChange(_channel[0].signal);
-	}
-	else if (_channel[0].signal < _channel[1].signal)
-	{
-		pos -= calcPosChange(_channel[1].signal);
+		while ((g = EMGGesture.read()) != GESTURE_NONE)
+		{
+			EMGGesture.run(g);
+		}
 	}
 
-	//MYSERIAL_PRINT_PGM("pos: ");
-	//MYSERIAL_PRINTLN_PGM(pos);
-
-	pos = constrain(pos, 0, 100);
-
-	Grip.setPos(pos);
-	Grip.run();
-
-#endif
+	// run the control strategy selected by setMode()
+	_control(_channel);
 }
 
-// generate noise floor, only when muscle is inactive 
-void EMG_CONTROL::calcNoiseFloor(int muscleNum, int  muscleVal)
+// generate noise floor, only when muscle is inactive, returns true if the sample is at the noise floor
+bool EMG_CONTROL::calcNoiseFloor(int muscleNum, int  muscleVal)
 {
 	const int dampening = 3;		// used to reduce the noise floor creeping upwards too quickly when the muscle is held tensed
 
 	// if muscle value is less than the noise floor + sensitivity offset / dampening
 	// (this reduces upwards creep of the noise floor when the muscle is held tensed)
-	if (muscleVal < (_channel[muscleNum].noiseFloor.readMean() + (settings.emg.peakThresh / dampening)))
+	if (muscleVal < (_channel[muscleNum].noiseFloor.readMean() + (_channel[muscleNum].peakThresh / dampening)))
 	{
 		_channel[muscleNum].noiseFloor.write(muscleVal);		// add to noise floor buffer
+		return true;
 	}
+
+	return false;
 }
 
-// calculate the 'speed' (change in pos) of movement by using the magnitude of the EMG signal
-double EMG_CONTROL::calcPosChange(int signal)
+// returns true if nothing needs every EMG sample, so the ADC can be scanned at the idle rate
+bool EMG_CONTROL::idleAllowed(void)
 {
-	bool invert = false;
-	double _exp;
-
-	double  power = 2;				// expo 
-	double sensitivity = 2;			// gradient 
-
-	static double k = pow((1024 / sensitivity), power);		// normalise, then modify expo sensitivity
-
-	if (isEven(power))				// fix issue that -x^2 = x?^2 
-		invert = true;
-
-	//MYSERIAL_PRINT_PGM("signal: ");
-	//MYSERIAL_PRINT_PGM(signal);
-	//MYSERIAL_PRINT_PGM("\tpower: ");
-	//MYSERIAL_PRINT_PGM(power);
-	//MYSERIAL_PRINT_PGM("\tk: ");
-	//MYSERIAL_PRINT_PGM(k);
-
-
-	// calculate position change as exponent (sensitivity is x^power proportional to _yPos)
-	_exp = pow(signal, power) / k;
-
-	//MYSERIAL_PRINT_PGM("_exp: ");
-	//MYSERIAL_PRINTLN_PGM(_exp);
+#if defined(USE_EMG_FILTER)
+	return false;			// the band-pass filter & envelope are designed for EMG_SAMPLE_RATE
+#else
+	// calibration, streaming, trace recording and the classifier use every sample at the full rate
+	if (EMGCal.running() || EMGStream.streaming() || Trace.recording() || settings.classifierEn)
+		return false;
 
-	if (invert)						// fix issue that -x^2 = x?^2
-		_exp = -_exp;
+	// the onset detector measures the energy at rest, and times the onset & offset in samples, at the full rate
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		if (_channel[c].detector == EMG_DETECT_ONSET)
+			return false;
+	}
 
-	return _exp;
+	return true;
+#endif
 }
 
 // detect whether a peak has just crossed the peak threshold (sensitivity offset)
-bool EMG_CONTROL::detect_peakStart(int currVal, int prevVal)
+bool EMG_CONTROL::detect_peakStart(EMGchannel &channel)
 {
-	return ((prevVal < settings.emg.peakThresh) && (currVal >= settings.emg.peakThresh));
+	if (channel.above || (channel.signal < channel.peakThresh))
+		return false;
+
+	channel.above = true;
+	return true;
 }
 
-// detect whether a peak has just fallen below the peak threshold (sensitivity offset)
-bool EMG_CONTROL::detect_peakEnd(int currVal, int prevVal)
+// detect whether a peak has just fallen below the end threshold (peak threshold - hysteresis)
+bool EMG_CONTROL::detect_peakEnd(EMGchannel &channel)
 {
-	return ((prevVal >= settings.emg.peakThresh) && (currVal < settings.emg.peakThresh));
+	if (!channel.above || (channel.signal >= channel.endThresh))
+		return false;
+
+	channel.above = false;
+	return true;
 }
 
 
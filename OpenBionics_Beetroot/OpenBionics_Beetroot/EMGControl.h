@@ -17,14 +17,80 @@
 #define EMG_CONTROL_H_
 
 //#include "CircleBuff.h"
+#include "Biquad.h"
+#include "EMGFeatures.h"
+#include "EMGOnset.h"
+#include "StatsWindow.h"
 #include "TimerManagement.h"
 
-#define NUM_EMG_CHANNELS	2
+// CHANNEL SETTINGS
+#define NUM_EMG_CHANNELS	2		// number of EMG channels (1 - EMG_MAX_CHANNELS)
+#define EMG_MAX_CHANNELS	8		// the SAMD21 ADC supports up to EMG_ADC_MAX_CHANNELS, the I2C ADC supports up to EMG_MAX_CHANNELS
+#define EMG_CHANNEL_PINS	{ A4, A5 }	// analogue pin of each channel (SAMD21 ADC only)
+#define EMG_OPEN_CHANNEL	0		// channel that opens the hand, or toggles between open & close if it is the only channel
+#define EMG_CLOSE_CHANNEL	1		// channel that closes the hand, any other channels are only used for the features (e.g. grip classifier)
+//#define USE_I2C_ADC				// uncomment this line to read the EMG from an external I2C ADC (I2C_ADC_MAX1161X.h) over the headphone jack
+#define EMG_POLARITY		EMG_TENSE_CLOSE	// single channel proportional control, EMG_TENSE_CLOSE (tense to close, relax to open) or EMG_TENSE_OPEN
+#define EMG_RELAX_SIGNAL	900		// single channel proportional control, signal used to return while the muscle is relaxed
+
 #define PRINT_MORE_EMG_DETAIL			// uncomment this line to view more EMG details
 
-#define NOISE_BUFFER_SIZE	128
+// RAM SETTINGS
+// Each channel holds a window of samples for the noise floor, the features and the envelope (~2KB per channel at full
+// length), so the windows are shortened as channels are added, to keep every channel within EMG_RAM_BUDGET
+#define EMG_RAM_BUDGET		10240	// bytes, max RAM used by the EMG channels (a third of the SAMD21 RAM), checked by EMGControl.cpp
+#if (NUM_EMG_CHANNELS > 4)
+#define EMG_WINDOW_SHRINK	2		// noise floor & envelope windows are 1/4 length, feature window is 1/2 length
+#elif (NUM_EMG_CHANNELS > 2)
+#define EMG_WINDOW_SHRINK	1		// every window is 1/2 length
+#else
+#define EMG_WINDOW_SHRINK	0		// full length windows
+#endif
+
+#define NOISE_BUFFER_BITS	(7 - EMG_WINDOW_SHRINK)
+#define NOISE_BUFFER_SIZE	(1 << NOISE_BUFFER_BITS)	// 128 (at full length)
 #define BUFFER_DEFAULT_VAL	925
 
+#define EMG_IDLE_DELAY		500		// ms, time every channel must be at the noise floor before the ADC is scanned at the idle rate (EMGADC.h)
+
+// THRESHOLD SETTINGS (EMGCalibration.h)
+#define EMG_GAIN_BITS		5		// fractional bits of the channel gain
+#define EMG_GAIN_UNITY		(1 << EMG_GAIN_BITS)	// gain of x1.00
+#define EMG_DRIFT_SIGMAS	6		// a calibrated PEAK threshold is raised to at least this many standard deviations of the noise floor
+
+// ONSET SETTINGS (EMGOnset.h)
+#define EMG_ONSET_SMOOTH_BITS	4	// energy is averaged over (1 << EMG_ONSET_SMOOTH_BITS) samples
+#define EMG_ONSET_ADAPT_BITS	9	// resting mean & deviation of the energy adapt over ~(1 << EMG_ONSET_ADAPT_BITS) samples
+#define EMG_ONSET_ON_DEVS	8		// onset threshold, deviations above the mean energy at rest
+#define EMG_ONSET_OFF_DEVS	3		// offset threshold, deviations above the mean energy at rest
+#define EMG_ONSET_MIN_ON	3		// samples, min duration above the onset threshold to trigger a PEAK
+#define EMG_ONSET_MIN_OFF	25		// samples, min duration below the offset threshold to end a PEAK
+#define EMG_ONSET_INIT_DEV	2000	// initial deviation, so the thresholds start high while the resting energy is measured
+#define EMG_ONSET_MIN_DEV	16		// min deviation, so that a very quiet channel does not trigger on quantisation noise
+
+// ADC SETTINGS (EMGADC.h)
+#define EMG_SAMPLE_RATE		1000	// Hz, sample rate of each channel, 1kHz or a factor of it (scanned on the 1ms tick, see EMGADC.h)
+#define EMG_SAMPLE_RES		10		// bits
+#define EMG_SAMPLE_AVG		1		// number of conversions averaged by the ADC for each sample (1 - 16), > 1 uses the 12 bit result
+
+// FILTER SETTINGS (Biquad.h)
+//#define USE_EMG_FILTER				// uncomment this line to filter raw (unrectified) EMG, for sensors without an envelope output
+#define EMG_FILTER_STAGES	3		// high-pass, notch, low-pass
+#define EMG_FILTER_HP_FREQ	20		// Hz, high-pass cut-off, removes the DC offset and motion artefacts
+#define EMG_FILTER_NOTCH_FREQ	50	// Hz, mains hum (50 or 60)
+#define EMG_FILTER_NOTCH_Q	5		// notch bandwidth is (EMG_FILTER_NOTCH_FREQ / EMG_FILTER_NOTCH_Q)
+#define EMG_FILTER_LP_FREQ	450		// Hz, low-pass cut-off, must be below (EMG_SAMPLE_RATE / 2)
+#define EMG_FILTER_SHIFT	8		// fractional bits added to each sample within the filter
+#define EMG_ENVELOPE_BITS	(6 - EMG_WINDOW_SHRINK)		// envelope window is (1 << EMG_ENVELOPE_BITS) samples, window x (max filtered sample)^2 must fit in an int32_t
+#define EMG_ENVELOPE_RMS			// comment this line to use a mean absolute value envelope instead of RMS
+
+// FEATURE SETTINGS (EMGFeatures.h)
+#define EMG_FEATURE_WINDOW_BITS	(7 - ((EMG_WINDOW_SHRINK > 0) ? 1 : 0))	// feature window is (1 << EMG_FEATURE_WINDOW_BITS) samples, 128ms at 1kHz (64ms for more than 2 channels)
+#define EMG_FEATURE_HOP		32		// samples between each new set of features
+#define EMG_FEATURE_ZC_THRESH	10	// ADC counts, min step across zero to count as a zero crossing
+#define EMG_FEATURE_SSC_THRESH	25	// ADC counts^2, min (x - prev) x (x - next) to count as a slope sign change
+//#define PRINT_EMG_FEATURES		// uncomment this line to print the EMG features with the ADC vals (M3)
+
 typedef enum _EMGMode
 {
 	EMG_OFF = 0,		// EMG MODE NOT RUNNING
@@ -32,23 +98,62 @@ typedef enum _EMGMode
 	EMG_PROPORTIONAL	// PROPORTIONAL EMG MODE
 } EMGMode;
 
+typedef enum _EMGRole
+{
+	EMG_ROLE_NONE = 0,	// only used for the features (e.g. grip classifier)
+	EMG_ROLE_TOGGLE,	// single channel, toggles between open & close
+	EMG_ROLE_OPEN,		// opens the hand
+	EMG_ROLE_CLOSE		// closes the hand
+} EMGRole;
+
+typedef enum _EMGPolarity
+{
+	EMG_TENSE_CLOSE = 0,	// single channel, tense to close, relax to open
+	EMG_TENSE_OPEN			// single channel, tense to open, relax to close
+} EMGPolarity;
+
+typedef enum _EMGDetector
+{
+	EMG_DETECT_THRESHOLD = 0,	// PEAK while the signal is above the PEAK threshold (U#)
+	EMG_DETECT_ONSET			// PEAK from onset to offset of the adaptive energy detector (EMGOnset.h)
+} EMGDetector;
+
 typedef struct _EMGChannel
 {
 	int pin;
+	EMGRole role;			// how the channel controls the hand
+	EMGDetector detector;	// how a PEAK is detected
+
+	STATS_WINDOW <int, NOISE_BUFFER_BITS> noiseFloor;
 
-	CIRCLE_BUFFER <int>noiseFloor;
+#if defined(USE_EMG_FILTER)
+	BIQUAD_CHAIN <EMG_FILTER_STAGES> filter;		// band-pass & notch filter of the raw sample
+	STATS_WINDOW <int, EMG_ENVELOPE_BITS> envelope;	// filtered samples, for the envelope
+#endif
 
-	MS_NB_TIMER HOLD_timer;
+	int32_t holdCount;		// samples since the PEAK started, while the HOLD is timed (-1 if not), so the hold is in signal time
 
 	bool active;
 	int sample;
+	uint32_t sampleTime;	// us, time the sample was read
 	int signal;
 	int prevSignal;
+	int filtered;			// sample with a mean of ~0 (band-pass filtered, or with the noise floor removed)
+	int level;				// sample, or the envelope of the filtered sample, before the noise floor is removed
+	int peakThresh;			// PEAK threshold, the channel setting raised by any increase in the noise (drift)
+	int endThresh;			// signal below which a PEAK ends (peakThresh - hysteresis)
+	bool above;				// the signal has crossed peakThresh, and has not yet fallen below endThresh
+
+	EMG_FEATURES <EMG_FEATURE_WINDOW_BITS> features;	// time-domain features of 'filtered'
+	EMG_ONSET <EMG_ONSET_SMOOTH_BITS, EMG_ONSET_ADAPT_BITS> onset;	// onset detector of 'filtered' (EMG_DETECT_ONSET only)
 
 	bool PEAK;
+	uint32_t peakTime;		// us, time of the sample that triggered the PEAK
 	bool HOLD;
 } EMGchannel;
 
+typedef void (*EMGControlFunc)(EMGchannel *channel);	// runs the control strategy of an EMG mode (EMGStrategy.h)
+
 class EMG_CONTROL
 {
 	public:
@@ -60,6 +165,12 @@ class EMG_CONTROL
 
 		void attachPin(int ch, int pin);		// assign ADC EMG pin to EMG channel
 		bool toggleADCVals(void);				// toggle whether to print ADC vals over serial, return _printVals state							
+		const int32_t *getFeatures(int ch);		// most recent set of time-domain features of a channel (NUM_EMG_FEATURES long)
+		void updateThresholds(void);			// set the PEAK threshold of each channel from the settings, raised if the noise floor has increased (drift)
+		int getPeakThresh(int ch);				// current PEAK threshold of a channel, including any drift
+		uint32_t getPeakTime(int ch);			// us, time of the sample that triggered the most recent PEAK of a channel
+		void setDetector(int ch, EMGDetector detector);	// set how a PEAK of a channel is detected, and restart the detection
+		EMGDetector getDetector(int ch);		// how a PEAK of a channel is detected
 		
 		void setMode(EMGMode mode);		// set EMG to off, simple or proportional mode 
 		void off(void);					// set EMG mode to EMG_OFF
@@ -70,21 +181,29 @@ class EMG_CONTROL
 		EMGchannel _channel[NUM_EMG_CHANNELS];	// EMG channel struct
 		bool _printVals;						// flag to determine whether to print ADC values
 		EMGMode _mode;							// current EMG mode
-
-		void getSample(void);			// read an EMG sample, add to noise floor, store active component as signal 
-		void analyseSignal(void);		// detect whether EMG is in a PEAK or HOLD
-
-		void control(void);				// change grip if HOLD, and run EMG control mode (simple or proportional)
-		void control_simple(void);			// toggle direction between open & close when a PEAK is detected
-		void control_proportional(void);	// open/close the hand at a speed proportional to the magnitude of the EMG signal
+		bool _newFeatures;						// a new set of features is ready
+		uint32_t _activeTime;					// us, time of the last sample of any channel above the noise floor
+		EMGControlFunc _control;				// control strategy of the current EMG mode
+#if defined(USE_I2C_ADC)
+		uint32_t _frameTime;					// us, time the next frame of the I2C ADC is due
+#endif
+
+		bool acquire(void);				// read and analyse every new EMG sample, returns false if there are no new samples
+		void getSample(const int *samples, uint32_t sampleTime);	// add an EMG sample to noise floor, store active component as signal 
+		void analyseSignal(void);		// detect whether EMG is in a PEAK or HOLD, and follow any gestures
+		void analyseOnset(EMGchannel &channel);	// detect whether EMG is in a PEAK or HOLD, using the onset detector
+		int filterSample(int ch, int sample);	// filter a raw sample, then return the envelope (RMS or mean absolute value) of the filtered signal
+		void extractFeatures(void);		// add the latest sample of each channel to the feature windows
+
+		void control(void);				// change grip if a gesture is recognised, and run the control strategy of the EMG mode (simple or proportional)
 
 		void printEMGData(void);		// print EMG signal, raw value, noise floor, peak flag and hold flag
 
-		void calcNoiseFloor(int muscleNum, int  muscleVal);		// generate noise floor, only when muscle is inactive 
-		double calcPosChange(int signal);						// calculate the 'speed' (change in pos) of movement by using the magnitude of the EMG signal
+		bool calcNoiseFloor(int muscleNum, int  muscleVal);		// generate noise floor, only when muscle is inactive, returns true if the sample is at the noise floor
+		bool idleAllowed(void);			// returns true if nothing needs every EMG sample, so the ADC can be scanned at the idle rate
 
-		bool detect_peakStart(int currVal, int prevVal);		// detect whether a peak has just crossed the peak threshold (sensitivity offset)
-		bool detect_peakEnd(int currVal, int prevVal);			// detect whether a peak has just fallen below the peak threshold (sensitivity offset)
+		bool detect_peakStart(EMGchannel &channel);			// detect whether a peak has just crossed the peak threshold (sensitivity offset)
+		bool detect_peakEnd(EMGchannel &channel);			// detect whether a peak has just fallen below the end threshold (peak threshold - hysteresis)
 
 };
 
@@ -0,0 +1,175 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EMGFeatures.h
+*
+*/
+
+// Incremental time-domain EMG features over a sliding window of (1 << WINDOW_BITS) samples.
+// When a sample is written, the contribution of that sample to each feature (|x|, |x - prev|, whether there
+// was a zero crossing or a slope sign change) is added to a running total and stored, and the contribution of
+// the oldest sample is subtracted, so no feature needs the window to be re-scanned. A new set of features is
+// made available every 'hop' samples, once the window is full.
+//
+// The samples should have a mean of ~0 (e.g. band-pass filtered, or with the noise floor removed).
+
+#ifndef EMG_FEATURES_H_
+#define EMG_FEATURES_H_
+
+#include <Arduino.h>
+
+typedef enum _EMGFeature
+{
+	FEATURE_MAV = 0,		// mean absolute value
+	FEATURE_WL,				// waveform length, sum of |x - prev| over the window
+	FEATURE_ZC,				// number of zero crossings
+	FEATURE_SSC,			// number of slope sign changes
+	FEATURE_VAR,			// variance
+	NUM_EMG_FEATURES
+} EMGFeature;
+
+#define EMG_FEATURE_ZC		0x01	// contribution flag, the sample crossed zero
+#define EMG_FEATURE_SSC		0x02	// contribution flag, the previous sample was a slope sign change
+
+template <uint8_t WINDOW_BITS>
+class EMG_FEATURES
+{
+	public:
+		EMG_FEATURES() { begin(1 << WINDOW_BITS, 0, 0); }
+
+		// clear the window, new features are ready every 'hop' samples, and zero crossings/slope sign changes
+		// smaller than the thresholds are ignored as noise
+		void begin(uint16_t hop, uint16_t zcThresh, uint16_t sscThresh)
+		{
+			_hop = hop ? hop : 1;
+			_zcThresh = zcThresh;
+			_sscThresh = sscThresh;
+
+			_head = 0;
+			_count = 0;
+			_sinceHop = 0;
+			_prev[0] = _prev[1] = 0;
+
+			_sumAbs = 0;
+			_sumWL = 0;
+			_numZC = 0;
+			_numSSC = 0;
+			_sum = 0;
+			_sumSq = 0;
+
+			for (uint8_t i = 0; i < NUM_EMG_FEATURES; i++)
+			{
+				_features[i] = 0;
+			}
+		}
+
+		// add a sample to the window, returns true if a new set of features is ready
+		bool write(int x)
+		{
+			int d = x - _prev[0];
+			uint16_t wl = abs(d);
+			uint8_t flags = 0;
+
+			// zero crossing between the previous sample and this one
+			if ((((x > 0) && (_prev[0] < 0)) || ((x < 0) && (_prev[0] > 0))) && (wl >= _zcThresh))
+				flags |= EMG_FEATURE_ZC;
+
+			// slope sign change at the previous sample
+			int32_t ssc = (int32_t)(_prev[0] - _prev[1]) * (_prev[0] - x);
+			if ((ssc > 0) && (ssc >= (int32_t)_sscThresh))
+				flags |= EMG_FEATURE_SSC;
+
+			// remove the contribution of the oldest sample
+			if (_count == SIZE)
+			{
+				int old = _x[_head];
+
+				_sumAbs -= abs(old);
+				_sumWL -= _wl[_head];
+				_numZC -= (_flags[_head] & EMG_FEATURE_ZC) ? 1 : 0;
+				_numSSC -= (_flags[_head] & EMG_FEATURE_SSC) ? 1 : 0;
+				_sum -= old;
+				_sumSq -= (uint32_t)((int32_t)old * old);
+			}
+			else
+			{
+				_count++;
+			}
+
+			// add the contribution of the new sample
+			_x[_head] = x;
+			_wl[_head] = wl;
+			_flags[_head] = flags;
+			_head = (_head + 1) & MASK;
+
+			_sumAbs += abs(x);
+			_sumWL += wl;
+			_numZC += (flags & EMG_FEATURE_ZC) ? 1 : 0;
+			_numSSC += (flags & EMG_FEATURE_SSC) ? 1 : 0;
+			_sum += x;
+			_sumSq += (uint32_t)((int32_t)x * x);
+
+			_prev[1] = _prev[0];
+			_prev[0] = x;
+
+			// only publish new features every 'hop' samples, once the window is full
+			if (++_sinceHop < _hop)
+				return false;
+
+			_sinceHop = 0;
+
+			if (_count < SIZE)
+				return false;
+
+			_features[FEATURE_MAV] = _sumAbs >> WINDOW_BITS;
+			_features[FEATURE_WL] = _sumWL;
+			_features[FEATURE_ZC] = _numZC;
+			_features[FEATURE_SSC] = _numSSC;
+			_features[FEATURE_VAR] = (int32_t)(((int64_t)_sumSq - (((int64_t)_sum * _sum) >> WINDOW_BITS)) >> WINDOW_BITS);
+
+			return true;
+		}
+
+		// read a feature of the most recent set
+		int32_t read(EMGFeature f) { return _features[f]; }
+
+		// read the most recent set of features (NUM_EMG_FEATURES long)
+		const int32_t *read(void) { return _features; }
+
+		// number of samples within the window
+		uint16_t size(void) { return SIZE; }
+
+	private:
+		enum { SIZE = (1 << WINDOW_BITS), MASK = (SIZE - 1) };
+
+		int16_t _x[SIZE];				// samples within the window
+		uint16_t _wl[SIZE];				// |x - prev| of each sample
+		uint8_t _flags[SIZE];			// zero crossing & slope sign change flags of each sample
+		uint16_t _head;					// location of the oldest sample (once the window is full)
+		uint16_t _count;				// number of samples within the window
+
+		uint16_t _hop;					// samples between each new set of features
+		uint16_t _sinceHop;				// samples since the last set of features
+		uint16_t _zcThresh;				// min |x - prev| of a zero crossing
+		uint16_t _sscThresh;			// min (x - prev) x (x - next) of a slope sign change
+		int _prev[2];					// previous two samples
+
+		uint32_t _sumAbs;				// running sum of |x|
+		uint32_t _sumWL;				// running sum of |x - prev|
+		uint16_t _numZC;				// running number of zero crossings
+		uint16_t _numSSC;				// running number of slope sign changes
+		int32_t _sum;					// running sum of x
+		uint32_t _sumSq;				// running sum of x^2
+
+		int32_t _features[NUM_EMG_FEATURES];	// most recent set of features
+};
+
+#endif // EMG_FEATURES_H_
@@ -0,0 +1,201 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EMGGesture.cpp
+*
+*/
+
+#include "Globals.h"
+#include "EMGGesture.h"
+
+#include "Grips.h"				// Grip
+#include "Initialisation.h"		// settings, storeSettings()
+
+EMG_GESTURE EMGGesture;
+
+// EMG channel of each gesture channel
+static const uint8_t gestureChannels[NUM_GESTURE_CHANNELS] =
+{
+	EMG_OPEN_CHANNEL,
+#if (NUM_GESTURE_CHANNELS > 1)
+	EMG_CLOSE_CHANNEL
+#endif
+};
+
+static const char *gestureNames[NUM_GESTURES] = { "Hold Open","Hold Close","Double Open","Double Close","Co-contraction" };
+static const char *actionNames[NUM_GESTURE_ACTIONS] = { "None","Next Grip","Previous Grip","Favourite Grip","Toggle Mode" };
+
+////////////////////////////// Constructors/Destructors //////////////////////////////
+
+EMG_GESTURE::EMG_GESTURE()
+{
+	begin();
+}
+
+////////////////////////////// Public Methods //////////////////////////////
+
+// clear the state of each channel, and any recognised gestures
+void EMG_GESTURE::begin(void)
+{
+	for (int i = 0; i < NUM_GESTURE_CHANNELS; i++)
+	{
+		_ch[i].above = false;
+		_ch[i].hold = false;
+		_ch[i].used = false;
+		_ch[i].pulse = false;
+		_ch[i].startTime = 0;
+		_ch[i].endTime = 0;
+	}
+
+	_pending = 0;
+}
+
+// follow the most recent sample of the OPEN & CLOSE channels, and recognise any gestures
+void EMG_GESTURE::addSample(EMGchannel *channel)
+{
+	for (int i = 0; i < NUM_GESTURE_CHANNELS; i++)
+	{
+		EMGchannel *ch = &channel[gestureChannels[i]];
+		GestureChannel *g = &_ch[i];
+		uint32_t now = ch->sampleTime;
+
+		// start of a contraction
+		if (ch->above && !g->above)
+		{
+			g->startTime = now;
+			g->used = false;
+
+#if (NUM_GESTURE_CHANNELS > 1)
+			GestureChannel *other = &_ch[1 - i];
+
+			// the other muscle started tensing just before this one
+			if (other->above && !other->used && ((now - other->startTime) <= (GESTURE_COCONTRACT_TIME * 1000UL)))
+			{
+				g->used = other->used = true;
+				g->pulse = other->pulse = false;
+				recognise(GESTURE_COCONTRACT);
+			}
+			else
+#endif
+			// the previous contraction was a short pulse, which ended just before this one
+			if (g->pulse && ((now - g->endTime) <= (GESTURE_DOUBLE_GAP * 1000UL)))
+			{
+				g->used = true;
+				recognise((Gesture)(GESTURE_DOUBLE_OPEN + i));
+			}
+
+			g->pulse = false;
+		}
+		// end of a contraction, which may be the first pulse of a double pulse
+		else if (!ch->above && g->above)
+		{
+			g->pulse = !g->used && !g->hold && !ch->HOLD;
+			g->endTime = now;
+		}
+
+		// the contraction has just been held
+		if (ch->HOLD && !g->hold && !g->used)
+		{
+			g->used = true;
+			recognise((Gesture)(GESTURE_HOLD_OPEN + i));
+		}
+
+		g->above = ch->above;
+		g->hold = ch->HOLD;
+	}
+}
+
+// read and clear a recognised gesture, returns GESTURE_NONE if there are none
+Gesture EMG_GESTURE::read(void)
+{
+	for (int g = 0; g < NUM_GESTURES; g++)
+	{
+		if (_pending & (1 << g))
+		{
+			_pending &= ~(1 << g);
+			return (Gesture)g;
+		}
+	}
+
+	return GESTURE_NONE;
+}
+
+// discard any recognised gestures
+void EMG_GESTURE::clear(void)
+{
+	_pending = 0;
+}
+
+// run the action mapped to a gesture
+void EMG_GESTURE::run(Gesture gesture)
+{
+	if (!IS_BETWEEN(gesture, 0, NUM_GESTURES - 1))
+		return;
+
+	switch (settings.gesture.action[gesture])
+	{
+	case GESTURE_ACTION_NEXT_GRIP:
+		Grip.nextGrip();
+		break;
+	case GESTURE_ACTION_PREV_GRIP:
+		Grip.prevGrip();
+		break;
+	case GESTURE_ACTION_FAVOURITE:
+		Grip.setGrip(settings.gesture.favouriteGrip);
+		break;
+	case GESTURE_ACTION_TOGGLE_MODE:
+		if (settings.mode == MODE_EMG_PROP)
+		{
+			EMG.simple();
+			settings.mode = MODE_EMG_SIMPLE;
+			MYSERIAL_PRINTLN_PGM("Muscle mode - Simple");
+		}
+		else
+		{
+			EMG.proportional();
+			settings.mode = MODE_EMG_PROP;
+			MYSERIAL_PRINTLN_PGM("Muscle mode - Proportional");
+		}
+		storeSettings();
+		return;
+	case GESTURE_ACTION_NONE:
+	default:
+		return;
+	}
+
+	// the grip has changed
+	Grip.open();
+	Grip.run();
+
+	MYSERIAL_PRINTLN_PGM("Grip Change");
+	MYSERIAL_PRINT_PGM("Grip ");
+	MYSERIAL_PRINTLN(Grip.getGripName());
+}
+
+// name of a gesture
+const char *EMG_GESTURE::getName(Gesture gesture)
+{
+	return IS_BETWEEN(gesture, 0, NUM_GESTURES - 1) ? gestureNames[gesture] : "None";
+}
+
+// name of an action
+const char *EMG_GESTURE::getActionName(GestureAction action)
+{
+	return (action < NUM_GESTURE_ACTIONS) ? actionNames[action] : "None";
+}
+
+////////////////////////////// Private Methods //////////////////////////////
+
+// add a gesture to the recognised gestures
+void EMG_GESTURE::recognise(Gesture gesture)
+{
+	_pending |= (1 << gesture);
+}
@@ -0,0 +1,102 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EMGGesture.h
+*
+*/
+
+// EMG gesture recogniser, for faster grip switching than cycling through the grips with a HOLD.
+// The contractions of the OPEN & CLOSE channels (from the PEAK detection of each channel, 'above' & HOLD) are
+// followed sample by sample by a timed state machine, which recognises:
+//
+//		GESTURE_HOLD_x			a contraction held for the hold time (T#)
+//		GESTURE_DOUBLE_x		two short contractions, the second starting within GESTURE_DOUBLE_GAP of the end of the first
+//		GESTURE_COCONTRACT		both muscles tensed, the second starting within GESTURE_COCONTRACT_TIME of the first
+//
+// A gesture is recognised as soon as it can be, and the contractions that make up a gesture are not also counted
+// towards another gesture. Each gesture is mapped to an action (J# N#), which is run by EMG_CONTROL::control().
+// The normal open/close control still responds to each contraction.
+
+#ifndef EMG_GESTURE_H_
+#define EMG_GESTURE_H_
+
+#include <Arduino.h>
+
+#include "EMGControl.h"			// EMGchannel, NUM_EMG_CHANNELS
+
+#define GESTURE_DOUBLE_GAP		400		// ms, max time from the end of a pulse to the start of the next pulse of a double pulse
+#define GESTURE_COCONTRACT_TIME	150		// ms, max time between the start of each contraction of a co-contraction
+
+#define NUM_GESTURE_CHANNELS	((NUM_EMG_CHANNELS > 1) ? 2 : 1)	// OPEN & CLOSE, or a single toggle channel
+
+typedef enum _Gesture
+{
+	GESTURE_NONE = -1,		// no gesture
+	GESTURE_HOLD_OPEN = 0,	// OPEN muscle held
+	GESTURE_HOLD_CLOSE,		// CLOSE muscle held
+	GESTURE_DOUBLE_OPEN,	// two pulses of the OPEN muscle
+	GESTURE_DOUBLE_CLOSE,	// two pulses of the CLOSE muscle
+	GESTURE_COCONTRACT,		// both muscles tensed together
+	NUM_GESTURES
+} Gesture;
+
+typedef enum _GestureAction
+{
+	GESTURE_ACTION_NONE = 0,	// ignore the gesture
+	GESTURE_ACTION_NEXT_GRIP,	// cycle to the next grip
+	GESTURE_ACTION_PREV_GRIP,	// cycle to the previous grip
+	GESTURE_ACTION_FAVOURITE,	// jump to the favourite grip
+	GESTURE_ACTION_TOGGLE_MODE,	// toggle between simple & proportional EMG mode
+	NUM_GESTURE_ACTIONS
+} GestureAction;
+
+typedef struct _GestureSettings
+{
+	uint8_t action[NUM_GESTURES];	// GestureAction of each gesture
+	uint8_t favouriteGrip;			// grip selected by GESTURE_ACTION_FAVOURITE
+} GestureSettings;
+
+typedef struct _GestureChannel
+{
+	bool above;				// the muscle was tensed at the previous sample
+	bool hold;				// the muscle was held at the previous sample
+	bool used;				// the current contraction is part of a gesture
+	bool pulse;				// the previous contraction was a short pulse, which may start a double pulse
+	uint32_t startTime;		// us, start of the current contraction
+	uint32_t endTime;		// us, end of the previous contraction
+} GestureChannel;
+
+class EMG_GESTURE
+{
+	public:
+		EMG_GESTURE();
+
+		void begin(void);						// clear the state of each channel, and any recognised gestures
+
+		void addSample(EMGchannel *channel);	// follow the most recent sample of the OPEN & CLOSE channels, and recognise any gestures
+		Gesture read(void);						// read and clear a recognised gesture, returns GESTURE_NONE if there are none
+		void clear(void);						// discard any recognised gestures
+
+		void run(Gesture gesture);				// run the action mapped to a gesture
+
+		const char *getName(Gesture gesture);				// name of a gesture
+		const char *getActionName(GestureAction action);	// name of an action
+
+	private:
+		GestureChannel _ch[NUM_GESTURE_CHANNELS];	// state of the OPEN & CLOSE channels
+		uint8_t _pending;						// bit per recognised gesture, not yet read
+
+		void recognise(Gesture gesture);		// add a gesture to the recognised gestures
+};
+
+extern EMG_GESTURE EMGGesture;
+
+#endif // EMG_GESTURE_H_
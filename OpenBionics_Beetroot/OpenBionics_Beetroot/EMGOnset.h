@@ -0,0 +1,184 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EMGOnset.h
+*
+*/
+
+// Adaptive EMG onset detector, an alternative to the fixed PEAK threshold (K#).
+// Each sample is converted to an energy, either by the Teager-Kaiser energy operator (write()), which responds to
+// both the amplitude and the frequency of raw EMG, so a contraction stands out from the noise within a few samples:
+//
+//		psi[n-1] = x[n-1]^2 - (x[n-2] x x[n])
+//
+// or by the caller (writeEnergy(), e.g. the square of an envelope). The energy is averaged over (1 << SMOOTH_BITS)
+// samples, a moving average rather than an exponential one, so that it returns to rest within the window however
+// large the contraction. While the muscle is at rest, the mean and mean absolute deviation of the energy are
+// tracked over ~(1 << ADAPT_BITS) samples. The onset threshold is (mean + onDevs x deviation) and the offset threshold is
+// (mean + offDevs x deviation), a lower threshold so that a contraction does not chatter around a single level.
+// An onset is only detected once the energy has been above the onset threshold for 'minOn' consecutive samples,
+// and an offset once it has been below the offset threshold for 'minOff' samples, so single spikes are ignored.
+//
+// The deviation starts at 'initDev', so the thresholds start high and settle as the resting energy is measured.
+// The samples should have a mean of ~0 (e.g. band-pass filtered, or with the noise floor removed).
+
+#ifndef EMG_ONSET_H_
+#define EMG_ONSET_H_
+
+#include <Arduino.h>
+
+#define EMG_ONSET_FRAC_BITS		8		// fractional bits of the resting mean & deviation
+
+typedef enum _OnsetEvent
+{
+	ONSET_NONE = 0,		// no change
+	ONSET_START,		// the energy has been above the onset threshold for 'minOn' samples
+	ONSET_END			// the energy has been below the offset threshold for 'minOff' samples
+} OnsetEvent;
+
+template <uint8_t SMOOTH_BITS, uint8_t ADAPT_BITS>
+class EMG_ONSET
+{
+	public:
+		EMG_ONSET() { begin(8, 3, 1, 1, 1, 1); }
+
+		// reset the detector, thresholds of 'onDevs' & 'offDevs' deviations above the resting mean, an onset/offset
+		// must last 'minOn'/'minOff' samples, the deviation starts at 'initDev' and is never below 'minDev'
+		void begin(uint8_t onDevs, uint8_t offDevs, uint8_t minOn, uint8_t minOff, int32_t initDev, int32_t minDev)
+		{
+			_onDevs = onDevs;
+			_offDevs = (offDevs < onDevs) ? offDevs : onDevs;
+			_minOn = minOn ? minOn : 1;
+			_minOff = minOff ? minOff : 1;
+			_minDev = minDev;
+
+			_x[0] = _x[1] = 0;
+			_head = 0;
+			_sum = 0;
+			_energy = 0;
+
+			for (uint8_t i = 0; i < SIZE; i++)
+			{
+				_window[i] = 0;
+			}
+
+			_mean = 0;
+			_dev = initDev << EMG_ONSET_FRAC_BITS;
+
+			_active = false;
+			_count = 0;
+			_duration = 0;
+		}
+
+		// add a sample, returns ONSET_START or ONSET_END once the Teager-Kaiser energy has crossed a threshold
+		OnsetEvent write(int x)
+		{
+			// energy of the previous sample, as the operator needs the samples either side
+			int32_t psi = ((int32_t)_x[0] * _x[0]) - ((int32_t)_x[1] * x);
+
+			_x[1] = _x[0];
+			_x[0] = x;
+
+			return writeEnergy(psi);
+		}
+
+		// add the energy of a sample, returns ONSET_START or ONSET_END once the smoothed energy has crossed a threshold
+		OnsetEvent writeEnergy(int32_t e)
+		{
+			_sum += e - _window[_head];
+			_window[_head] = e;
+			_head = (_head + 1) & MASK;
+			_energy = _sum >> SMOOTH_BITS;
+
+			if (!_active)
+			{
+				if (_energy > onThresh())
+				{
+					if (++_count < _minOn)
+						return ONSET_NONE;
+
+					_active = true;
+					_count = 0;
+					_duration = 0;
+					return ONSET_START;
+				}
+
+				// only the energy at rest (not a possible onset) is used to set the thresholds
+				_count = 0;
+				adapt();
+				return ONSET_NONE;
+			}
+
+			if (_energy >= offThresh())
+			{
+				_duration += _count + 1;		// include any short dip below the offset threshold
+				_count = 0;
+				return ONSET_NONE;
+			}
+
+			if (++_count < _minOff)
+				return ONSET_NONE;
+
+			_active = false;
+			_count = 0;
+			return ONSET_END;
+		}
+
+		// returns true between an onset and an offset
+		bool active(void) { return _active; }
+
+		// number of samples from the onset to the most recent sample above the offset threshold
+		uint32_t duration(void) { return _duration; }
+
+		// smoothed energy of the most recent sample
+		int32_t energy(void) { return _energy; }
+
+		// energy above which an onset is detected
+		int32_t onThresh(void) { return mean() + (_onDevs * dev()); }
+
+		// energy below which an offset is detected
+		int32_t offThresh(void) { return mean() + (_offDevs * dev()); }
+
+	private:
+		enum { SIZE = (1 << SMOOTH_BITS), MASK = (SIZE - 1) };
+
+		int _x[2];						// previous two samples
+		int32_t _window[SIZE];			// energy of the most recent samples
+		uint8_t _head;					// location of the oldest energy
+		int32_t _sum;					// running sum of the window
+		int32_t _energy;				// smoothed energy
+		int32_t _mean;					// mean of the energy at rest (EMG_ONSET_FRAC_BITS)
+		int32_t _dev;					// mean absolute deviation of the energy at rest (EMG_ONSET_FRAC_BITS)
+		int32_t _minDev;				// min deviation used for the thresholds
+
+		uint8_t _onDevs;				// deviations above the mean of the onset threshold
+		uint8_t _offDevs;				// deviations above the mean of the offset threshold
+		uint8_t _minOn;					// samples above the onset threshold to detect an onset
+		uint8_t _minOff;				// samples below the offset threshold to detect an offset
+
+		bool _active;					// an onset has been detected, and has not yet ended
+		uint8_t _count;					// consecutive samples beyond the threshold
+		uint32_t _duration;				// samples from the onset to the most recent sample above the offset threshold
+
+		int32_t mean(void) { return _mean >> EMG_ONSET_FRAC_BITS; }
+		int32_t dev(void) { int32_t d = _dev >> EMG_ONSET_FRAC_BITS; return (d > _minDev) ? d : _minDev; }
+
+		// move the resting mean & deviation towards the most recent energy
+		void adapt(void)
+		{
+			int32_t e = _energy << EMG_ONSET_FRAC_BITS;
+
+			_mean += (e - _mean) >> ADAPT_BITS;
+			_dev += (abs(e - _mean) - _dev) >> ADAPT_BITS;
+		}
+};
+
+#endif // EMG_ONSET_H_
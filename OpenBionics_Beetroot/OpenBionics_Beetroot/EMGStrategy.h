@@ -0,0 +1,179 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EMGStrategy.h
+*
+*/
+
+// EMG control strategies, one class for each control law.
+// Each strategy is specialised at compile time for the number of channels (and the polarity of a single channel),
+// and holds its own state. EMG_CONTROL selects and restarts the strategy of a mode when the mode is changed, so the
+// control of each sample does not branch on the mode, and a strategy can be added without changing the others.
+//
+// A strategy implements:
+//
+//		void begin(void)					restart from the current state of the hand, when the strategy is selected
+//		void run(EMGchannel *channel)		control the hand using the most recent analysis of each channel
+
+#ifndef EMG_STRATEGY_H_
+#define EMG_STRATEGY_H_
+
+#include "Globals.h"
+#include "EMGControl.h"			// EMGchannel, EMG_OPEN_CHANNEL, EMG_CLOSE_CHANNEL
+
+#include "Grips.h"				// Grip
+#include "Initialisation.h"		// settings
+#include "LatencyTracer.h"		// Latency
+#include "ResponseCurve.h"		// Curve, CURVE_FRAC_BITS
+
+// set the hand to fully open/closed, in response to the PEAK of a channel
+inline void emg_setDir(EMGchannel &channel, int dir)
+{
+	channel.PEAK = false;					// reset PEAK trigger
+	Latency.start(channel.peakTime);		// measure the time until the command is written to the fingers
+
+	Grip.setDir(dir);
+
+	if (dir == OPEN)
+	{
+		MYSERIAL_PRINTLN_PGM("Arm OPEN");
+	}
+	else
+	{
+		MYSERIAL_PRINTLN_PGM("Arm CLOSE");
+	}
+}
+
+
+// SIMPLE, open the hand when a PEAK is detected on the open channel, and close it on a PEAK of the close channel
+template <int NUM_CHANNELS>
+class EMG_SIMPLE_CONTROL
+{
+	public:
+		void begin(void) {}
+
+		void run(EMGchannel *channel)
+		{
+			// a PEAK is kept until the hand is not already open/closed
+			if (channel[EMG_OPEN_CHANNEL].PEAK && (Grip.getDir() != OPEN))
+				emg_setDir(channel[EMG_OPEN_CHANNEL], OPEN);
+			else if (channel[EMG_CLOSE_CHANNEL].PEAK && (Grip.getDir() != CLOSE))
+				emg_setDir(channel[EMG_CLOSE_CHANNEL], CLOSE);
+
+			Grip.run();
+		}
+};
+
+// SIMPLE, a single channel toggles direction between open & close when a PEAK is detected
+template <>
+class EMG_SIMPLE_CONTROL <1>
+{
+	public:
+		void begin(void) {}
+
+		void run(EMGchannel *channel)
+		{
+			if (channel[EMG_OPEN_CHANNEL].PEAK)
+				emg_setDir(channel[EMG_OPEN_CHANNEL], !Grip.getDir());
+
+			Grip.run();
+		}
+};
+
+
+// PROPORTIONAL, the grip position and the movement common to each channel count
+class EMG_PROPORTIONAL_BASE
+{
+	public:
+		// continue from the current grip position
+		void begin(void)
+		{
+			_pos = (int32_t)Grip.getPos() << CURVE_FRAC_BITS;
+		}
+
+	protected:
+		int32_t _pos;		// Q16.16, grip position
+
+		// signal of a channel, scaled by the gain of the channel (EMGCalibration.h)
+		int scaled(EMGchannel *channel, int c)
+		{
+			// a channel using the onset detector only moves the hand between the onset & offset, not on noise at rest
+			if ((channel[c].detector == EMG_DETECT_ONSET) && !channel[c].above)
+				return 0;
+
+			return (channel[c].signal * settings.emg.channel[c].gain) >> EMG_GAIN_BITS;
+		}
+
+		// measure the time from each muscle activation until the resulting position is written to the fingers
+		void trace(EMGchannel *channel, int numChannels)
+		{
+			for (int c = 0; c < numChannels; c++)
+			{
+				if (channel[c].PEAK)
+				{
+					channel[c].PEAK = false;
+					Latency.start(channel[c].peakTime);
+				}
+			}
+		}
+
+		// move towards open or close, at a speed proportional to the stronger of the two signals
+		void move(int open, int close)
+		{
+			if (open > close)
+			{
+				_pos -= Curve[CURVE_EMG].calc(open);		// OPEN
+			}
+			else if (open < close)
+			{
+				_pos += Curve[CURVE_EMG].calc(close);		// CLOSE
+			}
+
+			_pos = constrain(_pos, 0, ((int32_t)GRIP_CLOSE << CURVE_FRAC_BITS));
+
+			Grip.setPos(_pos >> CURVE_FRAC_BITS);
+			Grip.run();
+		}
+};
+
+// PROPORTIONAL, open/close the hand at a speed proportional to the magnitude of the open/close channel
+template <int NUM_CHANNELS, EMGPolarity POLARITY>
+class EMG_PROPORTIONAL_CONTROL : public EMG_PROPORTIONAL_BASE
+{
+	public:
+		void run(EMGchannel *channel)
+		{
+			trace(channel, NUM_CHANNELS);
+			move(scaled(channel, EMG_OPEN_CHANNEL), scaled(channel, EMG_CLOSE_CHANNEL));
+		}
+};
+
+// PROPORTIONAL, a single channel moves at a speed proportional to the magnitude of the signal while tensed,
+// and returns at the speed of EMG_RELAX_SIGNAL while relaxed
+template <EMGPolarity POLARITY>
+class EMG_PROPORTIONAL_CONTROL <1, POLARITY> : public EMG_PROPORTIONAL_BASE
+{
+	public:
+		void run(EMGchannel *channel)
+		{
+			int tensed = scaled(channel, EMG_OPEN_CHANNEL);
+			int relaxed = (tensed > 0) ? 0 : EMG_RELAX_SIGNAL;
+
+			trace(channel, 1);
+
+			if (POLARITY == EMG_TENSE_CLOSE)
+				move(relaxed, tensed);
+			else
+				move(tensed, relaxed);
+		}
+};
+
+#endif // EMG_STRATEGY_H_
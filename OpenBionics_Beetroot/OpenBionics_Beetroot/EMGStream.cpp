@@ -0,0 +1,179 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EMGStream.cpp
+*
+*/
+
+#include "Globals.h"
+#include "EMGStream.h"
+
+#include "Trace.h"				// SLIP framing
+
+EMG_STREAM EMGStream;
+
+////////////////////////////// Constructors/Destructors //////////////////////////////
+
+EMG_STREAM::EMG_STREAM()
+{
+	_en = false;
+	_seq = 0;
+	_numFrames = 0;
+	_numDropped = 0;
+	_len = 0;
+	_batchFrames = 0;
+}
+
+////////////////////////////// Public Methods //////////////////////////////
+
+// start streaming, from sequence number 0
+void EMG_STREAM::start(void)
+{
+	_en = true;
+	_seq = 0;
+	_numFrames = 0;
+	_numDropped = 0;
+
+	beginBatch();
+}
+
+// send any frames in the current batch, and stop streaming
+void EMG_STREAM::stop(void)
+{
+	if (_en && (_batchFrames > 0))
+		send();
+
+	_en = false;
+}
+
+// returns true if streaming
+bool EMG_STREAM::streaming(void)
+{
+	return _en;
+}
+
+// add a frame of the most recent sample of every channel, and send the batch once it is full
+void EMG_STREAM::addSample(EMGchannel *channel)
+{
+	uint8_t frame[EMG_STREAM_FRAME_SIZE];
+	uint8_t n = 0;
+
+	if (!_en)
+		return;
+
+	uint32_t time = channel[0].sampleTime;		// every channel is sampled within the same scan
+
+	frame[n++] = _seq;
+	frame[n++] = _seq >> 8;
+	frame[n++] = time;
+	frame[n++] = time >> 8;
+	frame[n++] = time >> 16;
+	frame[n++] = time >> 24;
+
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		uint16_t sample = channel[c].sample;
+		uint16_t noise = channel[c].noiseFloor.readMean();
+
+		frame[n++] = sample;
+		frame[n++] = sample >> 8;
+		frame[n++] = noise;
+		frame[n++] = noise >> 8;
+		frame[n++] = (channel[c].PEAK ? EMG_STREAM_PEAK : 0) | (channel[c].HOLD ? EMG_STREAM_HOLD : 0) | (channel[c].active ? EMG_STREAM_ACTIVE : 0);
+	}
+
+	_seq++;
+
+	// send the batch first if the frame (and the SLIP end) would not fit within the USB packet
+	if ((_batchFrames > 0) && ((_len + escape(frame, n, NULL) + 1) > EMG_STREAM_PACKET_SIZE))
+		send();
+
+	_len += escape(frame, n, &_batch[_len]);
+	_batchFrames++;
+
+	// send the batch once there is no space for another frame, rather than waiting for the next sample
+	if ((_len + EMG_STREAM_FRAME_SIZE + 1) > EMG_STREAM_PACKET_SIZE)
+		send();
+}
+
+// number of frames sent since streaming started
+uint32_t EMG_STREAM::getNumFrames(void)
+{
+	return _numFrames;
+}
+
+// number of frames dropped since streaming started, as the PC had not collected the previous packet
+uint32_t EMG_STREAM::getNumDropped(void)
+{
+	return _numDropped;
+}
+
+////////////////////////////// Private Methods //////////////////////////////
+
+// start a new batch, with the SLIP start and header
+void EMG_STREAM::beginBatch(void)
+{
+	_len = 0;
+	_batchFrames = 0;
+
+	_batch[_len++] = TRACE_END;
+	_batch[_len++] = EMG_STREAM_ID;
+	_batch[_len++] = NUM_EMG_CHANNELS;
+	_batch[_len++] = 0;						// number of frames, set when the batch is sent
+}
+
+// SLIP escape a number of bytes into 'out' (or just count them if NULL), returns the escaped size
+uint8_t EMG_STREAM::escape(const uint8_t *data, uint8_t len, uint8_t *out)
+{
+	uint8_t n = 0;
+
+	for (uint8_t i = 0; i < len; i++)
+	{
+		if ((data[i] == TRACE_END) || (data[i] == TRACE_ESC))
+		{
+			if (out)
+			{
+				out[n] = TRACE_ESC;
+				out[n + 1] = (data[i] == TRACE_END) ? TRACE_ESC_END : TRACE_ESC_ESC;
+			}
+			n += 2;
+		}
+		else
+		{
+			if (out)
+				out[n] = data[i];
+			n++;
+		}
+	}
+
+	return n;
+}
+
+// end the batch and send it, or drop it if the PC has not collected the previous packet
+void EMG_STREAM::send(void)
+{
+	_batch[EMG_STREAM_HEADER_SIZE] = _batchFrames;		// after TRACE_END, less than TRACE_END so never escaped
+	_batch[_len++] = TRACE_END;
+
+	// send the whole batch at once, so that it is not split by any text (a batch larger than a USB packet is dropped,
+	// as write() would wait for the PC to collect the first packet)
+	if ((_len <= EMG_STREAM_PACKET_SIZE) && serialTxReady(_len))
+	{
+		MYSERIAL.write(_batch, _len);
+		_numFrames += _batchFrames;
+	}
+	else
+	{
+		_numDropped += _batchFrames;
+	}
+
+	beginBatch();
+}
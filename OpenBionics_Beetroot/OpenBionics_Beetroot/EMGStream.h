@@ -0,0 +1,86 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EMGStream.h
+*
+*/
+
+// Binary streaming of every EMG sample over USB (M4), at the full EMG_SAMPLE_RATE.
+// Printing the ADC vals as text (M3) only shows the most recent sample of each EMG task, whereas the stream packs
+// every sample of every channel into a fixed size frame. Frames are collected into a batch that fits a single USB
+// packet (EMG_STREAM_PACKET_SIZE), and each batch is sent with one write once it is full. If the PC has not collected
+// the previous USB packet (serialTxReady()), the batch is dropped rather than waiting for the PC, so the control loop
+// is never stalled by a PC that stops reading. A batch that does not fit a single packet (a frame of many channels
+// with many escaped bytes) is also dropped, as the write would wait for the first packet to be collected.
+//
+// Each batch is sent as a SLIP frame (see Trace.h), so that it can be separated from the serial text. As the
+// first byte of the body is not a TraceType, trace readers ignore the batches. The body of each batch is:
+//
+//		EMG_STREAM_ID (1 byte), number of channels (1 byte), number of frames (1 byte), frames
+//
+// and each frame (little endian) is:
+//
+//		sequence number (uint16_t), time of the sample (uint32_t, us), { sample (uint16_t), noise floor (uint16_t), flags (1 byte) } x channels
+//
+// The sequence number increments for every frame, so any dropped frames appear as a gap.
+// The frames are decoded to CSV on the host by Host/tools/EMGStreamDecode.cpp.
+
+#ifndef EMG_STREAM_H_
+#define EMG_STREAM_H_
+
+#include <Arduino.h>
+
+#include "EMGControl.h"			// EMGchannel, NUM_EMG_CHANNELS
+
+#define EMG_STREAM_ID			0x80	// first byte of each batch body, not a TraceType
+#define EMG_STREAM_PACKET_SIZE	63		// max size of a SLIP framed batch, the space of a USB packet
+
+// FRAME FLAGS
+#define EMG_STREAM_PEAK			0x01	// PEAK detected
+#define EMG_STREAM_HOLD			0x02	// HOLD detected
+#define EMG_STREAM_ACTIVE		0x04	// signal above the noise floor
+
+#define EMG_STREAM_HEADER_SIZE	3		// ID, number of channels & number of frames
+#define EMG_STREAM_FRAME_SIZE	(6 + (5 * NUM_EMG_CHANNELS))	// bytes of each frame, before escaping
+
+class EMG_STREAM
+{
+	public:
+		EMG_STREAM();
+
+		void start(void);						// start streaming, from sequence number 0
+		void stop(void);						// send any frames in the current batch, and stop streaming
+		bool streaming(void);					// returns true if streaming
+
+		void addSample(EMGchannel *channel);	// add a frame of the most recent sample of every channel, and send the batch once it is full
+
+		uint32_t getNumFrames(void);			// number of frames sent since streaming started
+		uint32_t getNumDropped(void);			// number of frames dropped since streaming started, as the PC had not collected the previous packet
+
+	private:
+		bool _en;								// streaming enabled
+		uint16_t _seq;							// sequence number of the next frame
+		uint32_t _numFrames;					// number of frames sent
+		uint32_t _numDropped;					// number of frames dropped
+
+		// a single frame can be larger than EMG_STREAM_PACKET_SIZE once escaped (many channels), so allow for the worst case
+		uint8_t _batch[EMG_STREAM_PACKET_SIZE + (EMG_STREAM_FRAME_SIZE * 2) + EMG_STREAM_HEADER_SIZE + 2];	// SLIP framed batch
+		uint8_t _len;							// size of the batch, so far
+		uint8_t _batchFrames;					// number of frames in the batch
+
+		void beginBatch(void);					// start a new batch, with the SLIP start and header
+		uint8_t escape(const uint8_t *data, uint8_t len, uint8_t *out);	// SLIP escape a number of bytes into 'out' (or just count them if NULL), returns the escaped size
+		void send(void);						// end the batch and send it, or drop it if the PC has not collected the previous packet
+};
+
+extern EMG_STREAM EMGStream;
+
+#endif // EMG_STREAM_H_
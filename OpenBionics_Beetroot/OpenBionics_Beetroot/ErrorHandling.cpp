@@ -95,6 +95,14 @@ ERROR_HANDLING::ERROR_HANDLING()
 	_errorList[ERROR_TEMP_MAX].LED.c2 = LED_YELLOW;
 	_errorList[ERROR_TEMP_MAX].LED.blinkFreq = 5;					// 5Hz
 
+	// Error 010 - I2C EMG ADC fails to respond
+	_errorList[ERROR_EMG_ADC_INIT].num = 10;
+	_errorList[ERROR_EMG_ADC_INIT].type = ERROR_EMG_ADC_INIT;
+	_errorList[ERROR_EMG_ADC_INIT].level = LEVEL_WARN;
+	_errorList[ERROR_EMG_ADC_INIT].description = "EMG ADC is not detected, or can not be set up, during initialisation";
+	_errorList[ERROR_EMG_ADC_INIT].LED.c1 = LED_YELLOW;
+	_errorList[ERROR_EMG_ADC_INIT].duration = 5;					// display for 5s before clearing
+
 	_tempLvlLED = 0;		// value of the LED brightness before the override 
 }
 
@@ -187,6 +195,7 @@ void ERROR_HANDLING::set(ErrorType error)
 		// halt program (if still running)
 		while (1)
 		{
+			runEvents();			// keep the LED running
 #if defined(ARDUINO_ARCH_SAMD)
 			Watchdog.reset();
 #endif
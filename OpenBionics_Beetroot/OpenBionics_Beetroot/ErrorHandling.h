@@ -45,6 +45,7 @@ typedef enum _ErrorType
 	ERROR_TEMP_WARNING,		// 7 warning CPU temperature has been reached
 	ERROR_TEMP_MAX,			// 8 maximum CPU temperature has been reached
 	ERROR_WATCHDOG,			// 9 Watchdog timer triggered
+	ERROR_EMG_ADC_INIT,		// 10 I2C EMG ADC failed to respond, or the SAMD21 EMG ADC failed to set up, during initialisation
 } ErrorType;
 
 typedef enum _ErrorLevel
@@ -0,0 +1,155 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EventQueue.cpp
+*
+*/
+
+#include "Globals.h"
+#include "EventQueue.h"
+
+#if (EVENT_QUEUE_SIZE & (EVENT_QUEUE_SIZE - 1)) || (EVENT_QUEUE_SIZE > 128)
+#error "EVENT_QUEUE_SIZE must be a power of 2, no greater than 128"
+#endif
+
+EVENT_QUEUE Events;
+
+////////////////////////////// Constructors/Destructors //////////////////////////////
+
+EVENT_QUEUE::EVENT_QUEUE()
+{
+	_head = 0;
+	_tail = 0;
+	_maxDepth = 0;
+	_numDropped = 0;
+	_numTicks = 0;
+	_ticksTaken = 0;
+	_maxTicks = 0;
+}
+
+////////////////////////////// Public Methods //////////////////////////////
+
+// add an event to the queue (interrupt only), returns false if the event was dropped
+bool EVENT_QUEUE::post(EventType e)
+{
+	uint8_t head = _head;
+	uint8_t depth = (uint8_t)(head - _tail);		// indices are free running, unsigned difference survives overflow
+
+	if (depth >= EVENT_QUEUE_SIZE)
+	{
+		_numDropped++;
+		return false;
+	}
+
+	_buff[head & (EVENT_QUEUE_SIZE - 1)] = e;
+	_head = head + 1;				// publish the event only once it has been written
+
+	if (++depth > _maxDepth)
+	{
+		_maxDepth = depth;
+	}
+
+	return true;
+}
+
+// remove the oldest event from the queue (loop only), returns false if the queue is empty
+bool EVENT_QUEUE::get(EventType *e)
+{
+	uint8_t tail = _tail;
+
+	if (tail == _head)
+	{
+		return false;
+	}
+
+	*e = (EventType)_buff[tail & (EVENT_QUEUE_SIZE - 1)];
+	_tail = tail + 1;				// free the slot only once the event has been read
+
+	return true;
+}
+
+// count a 1ms tick (interrupt only)
+void EVENT_QUEUE::tick(void)
+{
+	_numTicks++;
+}
+
+// take the number of ticks since the last call (loop only)
+uint32_t EVENT_QUEUE::getTicks(void)
+{
+	uint32_t numTicks = _numTicks;				// read once, a 32 bit read is atomic
+	uint32_t n = numTicks - _ticksTaken;		// unsigned difference survives overflow
+
+	_ticksTaken = numTicks;
+
+	if (n > _maxTicks)
+	{
+		_maxTicks = n;
+	}
+
+	return n;
+}
+
+// returns true if there are ticks that have not been taken
+bool EVENT_QUEUE::tickPending(void)
+{
+	return (_numTicks != _ticksTaken);
+}
+
+// number of events currently queued
+uint8_t EVENT_QUEUE::getDepth(void)
+{
+	return (uint8_t)(_head - _tail);
+}
+
+// maximum number of events queued since reset
+uint8_t EVENT_QUEUE::getMaxDepth(void)
+{
+	return _maxDepth;
+}
+
+// number of events dropped since reset
+uint32_t EVENT_QUEUE::getNumDropped(void)
+{
+	uint32_t n;
+
+	noInterrupts();
+	n = _numDropped;
+	interrupts();
+
+	return n;
+}
+
+// clear the maximum depth, dropped count and max ticks
+void EVENT_QUEUE::reset(void)
+{
+	noInterrupts();
+	_maxDepth = 0;
+	_numDropped = 0;
+	interrupts();
+
+	_maxTicks = 0;
+}
+
+// print the queue depth, dropped events and the max ticks taken at once
+void EVENT_QUEUE::printStatus(void)
+{
+	MYSERIAL_PRINT_PGM("Events:\tdepth ");
+	MYSERIAL_PRINT(getDepth());
+	MYSERIAL_PRINT_PGM("/");
+	MYSERIAL_PRINT(EVENT_QUEUE_SIZE);
+	MYSERIAL_PRINT_PGM(", max ");
+	MYSERIAL_PRINT(getMaxDepth());
+	MYSERIAL_PRINT_PGM(", dropped ");
+	MYSERIAL_PRINT(getNumDropped());
+	MYSERIAL_PRINT_PGM(", max ticks ");
+	MYSERIAL_PRINTLN(_maxTicks);
+}
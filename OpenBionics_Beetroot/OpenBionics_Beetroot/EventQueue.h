@@ -0,0 +1,72 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	EventQueue.h
+*
+*/
+
+// Deferred work queue.
+// Work is deferred from the 1ms timer interrupt to loop(), so that slow work (serial printing, NeoPixel updates)
+// does not run within the interrupt. The 1ms tick is a counter rather than an event, as any number of ticks since
+// the last run only need a single run of the periodic work (ERROR and LED use timers), so a long task delays the
+// work without filling the queue. The number of ticks taken by each run shows how late the work was (max ticks).
+// Events that must each be handled are posted to a lock-free single producer (interrupt), single consumer (loop)
+// ring buffer, the producer only writes _head and the consumer only writes _tail. If the queue is full the event
+// is dropped and counted, so 'dropped' means an event was lost. The maximum depth is also stored.
+
+#ifndef EVENT_QUEUE_H_
+#define EVENT_QUEUE_H_
+
+#include <Arduino.h>
+
+#define EVENT_QUEUE_SIZE		32		// number of events that can be queued, must be a power of 2
+
+typedef enum _EventType
+{
+	EVENT_NONE = 0,			// no event (the 1ms tick is counted by tick(), no other events are currently posted)
+	NUM_EVENT_TYPES
+} EventType;
+
+class EVENT_QUEUE
+{
+	public:
+		EVENT_QUEUE();
+
+		bool post(EventType e);				// add an event to the queue (interrupt only), returns false if the event was dropped
+		bool get(EventType *e);				// remove the oldest event from the queue (loop only), returns false if the queue is empty
+
+		void tick(void);					// count a 1ms tick (interrupt only)
+		uint32_t getTicks(void);			// take the number of ticks since the last call (loop only)
+		bool tickPending(void);				// returns true if there are ticks that have not been taken
+
+		uint8_t getDepth(void);				// number of events currently queued
+		uint8_t getMaxDepth(void);			// maximum number of events queued since reset
+		uint32_t getNumDropped(void);		// number of events dropped since reset
+
+		void reset(void);					// clear the maximum depth, dropped count and max ticks
+		void printStatus(void);				// print the queue depth, dropped events and the max ticks taken at once
+
+	private:
+		volatile uint8_t _buff[EVENT_QUEUE_SIZE];	// queued events
+		volatile uint8_t _head;						// location of the next event to be posted (written by the interrupt)
+		volatile uint8_t _tail;						// location of the next event to be read (written by loop)
+
+		volatile uint8_t _maxDepth;					// maximum number of events queued since reset
+		volatile uint32_t _numDropped;				// number of events dropped since reset
+
+		volatile uint32_t _numTicks;				// number of ticks counted (written by the interrupt)
+		uint32_t _ticksTaken;						// number of ticks taken (written by loop)
+		uint32_t _maxTicks;							// maximum number of ticks taken at once since reset
+};
+
+extern EVENT_QUEUE Events;
+
+#endif // EVENT_QUEUE_H_
@@ -0,0 +1,123 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	FingerCache.cpp
+*
+*/
+
+#include <FingerLib.h>
+
+#include "Globals.h"
+#include "FingerCache.h"
+
+#include "LatencyTracer.h"		// Latency
+
+FINGER_CACHE FingerCache;
+
+////////////////////////////// Constructors/Destructors //////////////////////////////
+
+FINGER_CACHE::FINGER_CACHE()
+{
+	begin();
+}
+
+////////////////////////////// Public Methods //////////////////////////////
+
+// clear the cache, so that the next write to each finger is forwarded, and reset the counts
+void FINGER_CACHE::begin(void)
+{
+	for (int f = 0; f < NUM_FINGERS; f++)
+	{
+		_cmd[f].pos = -1;
+		_cmd[f].posRead = -1;
+		_cmd[f].speed = -1;
+		_cmd[f].speedRead = -1;
+	}
+
+	reset();
+}
+
+// write the target position of finger f, if it has changed
+void FINGER_CACHE::writePos(int f, int pos)
+{
+	if (!IS_BETWEEN(f, 0, NUM_FINGERS - 1))
+		return;
+
+	FingerCommand *cmd = &_cmd[f];
+
+	// the same position has already been written, and the finger has not since been written by something else
+	if ((pos == cmd->pos) && (finger[f].readTargetPos() == cmd->posRead))
+	{
+		_numSuppressed++;
+		return;
+	}
+
+	finger[f].writePos(pos);
+	cmd->pos = pos;
+	cmd->posRead = finger[f].readTargetPos();
+	_numIssued++;
+
+	// if a muscle activation has issued a grip command, store the EMG to actuation latency
+	Latency.stop();
+}
+
+// write the speed of finger f, if it has changed
+void FINGER_CACHE::writeSpeed(int f, int speed)
+{
+	if (!IS_BETWEEN(f, 0, NUM_FINGERS - 1))
+		return;
+
+	FingerCommand *cmd = &_cmd[f];
+
+	if ((speed == cmd->speed) && (finger[f].readSpeed() == cmd->speedRead))
+	{
+		_numSuppressed++;
+		return;
+	}
+
+	finger[f].writeSpeed(speed);
+	cmd->speed = speed;
+	cmd->speedRead = finger[f].readSpeed();
+	_numIssued++;
+}
+
+// number of writes forwarded to the fingers since reset
+uint32_t FINGER_CACHE::getNumIssued(void)
+{
+	return _numIssued;
+}
+
+// number of writes skipped since reset, as the value had not changed
+uint32_t FINGER_CACHE::getNumSuppressed(void)
+{
+	return _numSuppressed;
+}
+
+// clear the counts
+void FINGER_CACHE::reset(void)
+{
+	_numIssued = 0;
+	_numSuppressed = 0;
+}
+
+// print the number of issued & suppressed writes
+void FINGER_CACHE::printStatus(void)
+{
+	uint32_t total = _numIssued + _numSuppressed;
+
+	MYSERIAL_PRINT_PGM("Finger writes:\tissued ");
+	MYSERIAL_PRINT(_numIssued);
+	MYSERIAL_PRINT_PGM(", suppressed ");
+	MYSERIAL_PRINT(_numSuppressed);
+	MYSERIAL_PRINT_PGM(" (");
+	MYSERIAL_PRINT(total ? ((float)_numSuppressed * 100.0 / total) : 0.0);
+	MYSERIAL_PRINTLN_PGM("%)");
+}
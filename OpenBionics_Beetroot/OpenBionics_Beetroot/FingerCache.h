@@ -0,0 +1,63 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	FingerCache.h
+*
+*/
+
+// Finger command cache.
+// HANDle & proportional EMG run the grip on every poll/sample, so the same position & speed are written to each
+// finger many times a second. Writing a finger restarts its motion towards the target, so the writes from the grips
+// (via the trajectories) are passed through this cache, which only forwards a write if the value has changed.
+// The cache stores the value read back from the finger after each forwarded write, so a finger that has been written
+// by something else (e.g. F#, ROS) no longer matches and the next write is forwarded.
+// The number of forwarded (issued) and skipped (suppressed) writes are counted, and are printed by the loop profiler (L).
+
+#ifndef FINGER_CACHE_H_
+#define FINGER_CACHE_H_
+
+#include <Arduino.h>
+
+#include "Globals.h"			// NUM_FINGERS
+
+typedef struct _FingerCommand
+{
+	int16_t pos;			// last position forwarded to the finger, -1 if none
+	int16_t posRead;		// target position read back from the finger after it was written
+	int16_t speed;			// last speed forwarded to the finger, -1 if none
+	int16_t speedRead;		// speed read back from the finger after it was written
+} FingerCommand;
+
+class FINGER_CACHE
+{
+	public:
+		FINGER_CACHE();
+
+		void begin(void);						// clear the cache, so that the next write to each finger is forwarded, and reset the counts
+
+		void writePos(int f, int pos);			// write the target position of finger f, if it has changed
+		void writeSpeed(int f, int speed);		// write the speed of finger f, if it has changed
+
+		uint32_t getNumIssued(void);			// number of writes forwarded to the fingers since reset
+		uint32_t getNumSuppressed(void);		// number of writes skipped since reset, as the value had not changed
+
+		void reset(void);						// clear the counts
+		void printStatus(void);					// print the number of issued & suppressed writes
+
+	private:
+		FingerCommand _cmd[NUM_FINGERS];		// last command forwarded to each finger
+		uint32_t _numIssued;					// number of writes forwarded since reset
+		uint32_t _numSuppressed;				// number of writes skipped since reset
+};
+
+extern FINGER_CACHE FingerCache;
+
+#endif // FINGER_CACHE_H_
@@ -19,6 +19,8 @@
 #include "Grips.h"
 
 #include "Grips_Default.h"
+#include "LatencyTracer.h"
+#include "Trajectory.h"
 
 
 ////////////////////////////// Constructors/Destructors //////////////////////////////
@@ -29,87 +31,77 @@ GRIP_CLASS::GRIP_CLASS()
 
 ////////////////////////////// Public Methods //////////////////////////////
 
-// store all the default grips (default_GripPos) in _allGrips
+// select the first grip of the grip library (default_Grips)
 void GRIP_CLASS::begin(void)
 {
-	// store the default grips in the _allGrips struct
-	for (int gNum = 0; gNum < NUM_GRIPS; gNum++)
-	{
-		_allGrips[gNum].num = gNum;
-		_allGrips[gNum].name = default_GripNames[gNum];
-
-		for (int sNum = 0; sNum < NUM_GRIP_STEPS; sNum++)
-		{
-			_allGrips[gNum].step[sNum].count = default_GripPos[gNum][sNum][0];	// store the count value
-			_allGrips[gNum].step[sNum].pos = &default_GripPos[gNum][sNum][1];	// store a pointer to the pos values
-		}
-	}
-
 	// clear all values
 	_pos = 0;
 	_dir = OPEN;
 	_speed = MAX_FINGER_PWM;
 
-	// set current grip to be the very first grip
-	_currGrip = &_allGrips[0];
+	// set current grip to be the very first grip, not blended
+	compile(&_blendGrip, 0);
+	setGrip(0);
 }
 
 
 // set the current grip to the grip number gNum
 void GRIP_CLASS::setGrip(int gNum)
 {
-	gNum = constrain(gNum, 0, NUM_GRIPS);
-	_currGrip = &_allGrips[gNum];
+	gNum = constrain(gNum, 0, NUM_GRIPS - 1);
+	compile(&_currGrip, gNum);
+
+	_blend = 0;				// a newly selected grip is not blended
 }
 
 // get the number of the current grip
 int GRIP_CLASS::getGrip(void)
 {
-	return _currGrip->num;
+	return _currGrip.num;
 }
 
 // get the name of the current grip
 char* GRIP_CLASS::getGripName(void)
 {
-	return (char*)_currGrip->name;
+	return (char*)default_Grips[_currGrip.num].name;
 }
 
 // get the name of grip gNum
 char* GRIP_CLASS::getGripName(int gNum)
 {
-	return (char*)_allGrips[gNum].name;
+	return (char*)default_Grips[gNum].name;
 }
 
 // cycle to the next grip
 int GRIP_CLASS::nextGrip(void)
 {
 	// if the last grip has been reached, wrap around
-	if (_currGrip->num + 1 >= NUM_GRIPS)
+	if (_currGrip.num + 1 >= NUM_GRIPS)
 	{
-		_currGrip = &_allGrips[0];
+		setGrip(0);
 	}
 	else
 	{
-		_currGrip = &_allGrips[_currGrip->num + 1];
+		setGrip(_currGrip.num + 1);
 	}
 
-	return _currGrip->num;
+	return _currGrip.num;
 }
 
 // cycle to the previous grip
 int GRIP_CLASS::prevGrip(void)
 {
 	// if the first grip has been reached, wrap around
-	if (_currGrip->num <= 0)
+	if (_currGrip.num <= 0)
 	{
-		_currGrip = &_allGrips[NUM_GRIPS - 1];
+		setGrip(NUM_GRIPS - 1);
 	}
 	else
 	{
-		_currGrip = &_allGrips[_currGrip->num - 1];
+		setGrip(_currGrip.num - 1);
 	}
 
-	return _currGrip->num;
+	return _currGrip.num;
 }
 
 // open using the current grip
@@ -179,65 +171,66 @@ int GRIP_CLASS::getSpeed(void)
 	return _speed;
 }
 
-// calculate the target position for each finger depending on the target step number (_pos)
-void GRIP_CLASS::run(void)
+// blend the finger positions of the current grip towards grip gNum, by weight (0 - GRIP_BLEND_MAX)
+// the blend grip is only compiled when it changes, so the blend can be changed on every run()
+void GRIP_CLASS::setBlend(int gNum, int weight)
 {
-	uint16_t fingerNum;
-
-	uint16_t stepNum;
-	uint16_t posA, posB;
-	uint16_t countA, countB;
-	uint16_t stepModA = 0, stepModB = 0;
-
-	uint16_t currentCountVal, nextCountVal;
+	gNum = constrain(gNum, 0, NUM_GRIPS - 1);
+	_blend = constrain(weight, 0, GRIP_BLEND_MAX);
 
-	for (stepNum = 0; stepNum < NUM_GRIP_STEPS; stepNum++)				// count through COUNT rows (0 - 5)
+	if (_blend && (gNum != _blendGrip.num))
 	{
-		currentCountVal = _currGrip->step[stepNum].count;				// read first COUNT val
-		nextCountVal = _currGrip->step[stepNum + 1].count;				// read next COUNT val
-
-		if (IS_BETWEEN(_pos, currentCountVal, nextCountVal))			// if grip pos is between the two COUNT vals
-		{
-			for (fingerNum = 0; fingerNum < NUM_FINGERS; fingerNum++)		// count through each finger element
-			{
-				do														// search upwards for a finger position that isn't BLANK
-				{
-					posA = _currGrip->step[(stepNum - stepModA)].pos[fingerNum];		// read finger position from stored grip struct
+		compile(&_blendGrip, gNum);
+	}
+}
 
-					if (posA == (uint16_t)BLANK)						// if finger position is blank
-					{
-						stepModA++;										// look above for previous finger position
-					}
-				} while (posA == (uint16_t)BLANK);
+// get the number of the grip that the current grip is blended towards
+int GRIP_CLASS::getBlendGrip(void)
+{
+	return _blendGrip.num;
+}
 
-				do														// search below for a finger position that isn't BLANK
-				{
-					posB = _currGrip->step[(stepNum + 1 + stepModB)].pos[fingerNum];	// read finger position from stored grip struct
+// get the blend weight, 0 if the current grip is not blended
+int GRIP_CLASS::getBlend(void)
+{
+	return _blend;
+}
 
-					if (posB == (uint16_t)BLANK) 						// if finger position is blank
-					{
-						stepModB++;										// look below for next finger position
-					}
-				} while (posB == (uint16_t)BLANK);
+// get the target position of a finger at the grip position, including any blend
+int GRIP_CLASS::getFingerPos(int fingerNum)
+{
+	if (!IS_BETWEEN(fingerNum, 0, NUM_FINGERS - 1))
+		return BLANK;
 
+	int32_t pos = calcFingerPos(&_currGrip, fingerNum);
 
-				// stepMod - used to find the first finger pos (above or below) that isn't BLANK
-				// stepNum - row number of COUNT (0-5) that grip position is in between
-				countA = _currGrip->step[(stepNum - stepModA)].count;					// get below COUNT val
-				countB = _currGrip->step[(stepNum + 1 + stepModB)].count;				// get above COUNT val
+	// move the finger position towards that of the blend grip
+	if (_blend)
+	{
+		pos += ((calcFingerPos(&_blendGrip, fingerNum) - pos) * _blend) / GRIP_BLEND_MAX;
+	}
 
-				finger[fingerNum].writePos(map(_pos, countA, countB, posA, posB));		// map finger pos using below and above COUNT vals
+	return pos;
+}
 
-				finger[fingerNum].writeSpeed(_speed);									// set the finger speed
+// calculate the target position for each finger depending on the target step number (_pos)
+void GRIP_CLASS::run(void)
+{
+	bool moving = false;
 
-				stepModA = 0;
-				stepModB = 0;
+	for (int fingerNum = 0; fingerNum < NUM_FINGERS; fingerNum++)
+	{
+		Trajectory.writePos(fingerNum, getFingerPos(fingerNum));
+		Trajectory.writeSpeed(fingerNum, _speed);								// set the finger speed
 
-			}
-			break;				// if grip pos is between the two COUNT vals, exit from the search as grip management is complete
-		}
+		moving |= Trajectory.moving(fingerNum);
 	}
 
+	// any new finger position has been written (storing the EMG to actuation latency), or is being followed by the
+	// trajectories. If no finger is moving, a muscle activation that ran the grip did not move the fingers
+	if (!moving)
+		Latency.cancel();
+
 	// set current direction of the grip by using the average of all finger positions
 	if (_pos > (GRIP_CLOSE / 2))
 	{
@@ -250,4 +243,63 @@ void GRIP_CLASS::run(void)
 }
 
 
+////////////////////////////// Private Methods //////////////////////////////
+
+// compile the keyframes of grip gNum into segments, so that run() does not need to skip the unused keyframes, or divide
+// to interpolate between them. The keyframes of every grip have been checked when the grip library was compiled
+void GRIP_CLASS::compile(GripType *grip, int gNum)
+{
+	const GripDef *def = &default_Grips[gNum];
+
+	grip->num = gNum;
+
+	for (int fingerNum = 0; fingerNum < NUM_FINGERS; fingerNum++)
+	{
+		const GripKey *key = def->key[fingerNum];
+		int numSegs = 0;
+
+		// a segment between each keyframe and the next
+		while (((numSegs + 1) < GRIP_MAX_KEYS) && (key[numSegs + 1].pos != 0))
+		{
+			GripSegment *seg = &grip->fingerSeg[fingerNum][numSegs];
+			int32_t countA = key[numSegs].count, countB = key[numSegs + 1].count;
+			int32_t posA = key[numSegs].pos, posB = key[numSegs + 1].pos;
+			uint32_t dPos = abs(posB - posA);
+
+			seg->pos = posA;
+			seg->count = countA;
+
+			// rounding the slope away from 0 makes the interpolation match map() for every count value of the segment
+			seg->slope = ((dPos << GRIP_SLOPE_BITS) + (countB - countA - 1)) / (countB - countA);
+
+			if (posB < posA)
+				seg->slope = -seg->slope;
+
+			numSegs++;
+		}
+
+		grip->numSegs[fingerNum] = numSegs;
+	}
+}
+
+// position of a finger of a compiled grip at the grip position (_pos)
+int GRIP_CLASS::calcFingerPos(const GripType *grip, int fingerNum)
+{
+	const GripSegment *seg = grip->fingerSeg[fingerNum];
+	const GripSegment *last = seg + grip->numSegs[fingerNum] - 1;
+
+	// find the segment of the grip position, the final count value is the end of the last segment
+	while ((seg < last) && (_pos >= seg[1].count))
+	{
+		seg++;
+	}
+
+	// interpolate along the segment, rounding towards 0 (as map())
+	int32_t offset = (int32_t)(_pos - seg->count) * seg->slope;
+	offset = (offset >= 0) ? (offset >> GRIP_SLOPE_BITS) : -((-offset) >> GRIP_SLOPE_BITS);
+
+	return seg->pos + offset;
+}
+
+
 GRIP_CLASS Grip;
\ No newline at end of file
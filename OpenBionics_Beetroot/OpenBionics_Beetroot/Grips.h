@@ -24,20 +24,27 @@
 #define GRIP_CLOSE			GRIP_MAX_COUNT_VAL
 
 
-// a single step used to store the default grip
-typedef struct	_GripStep
-{
-	uint16_t count;			// the count value for each grip movement (0 - 100, open - close)
-	uint16_t *pos;			// pointer to the finger positions for each grip
-} GripStep;
+#define GRIP_SLOPE_BITS		16		// fractional bits of the slope of each grip segment
+
+#define GRIP_BLEND_MAX		256		// blend weight at which the finger positions are those of the blend grip
 
-// a struct to store a single grip's num, name and finger positions
+// the segment of a finger's movement between two neighbouring keyframes
+typedef struct _GripSegment
+{
+	uint16_t pos;			// finger position at the start of the segment
+	uint8_t count;			// count value at the start of the segment
+	int32_t slope;			// change in finger position per count value (GRIP_SLOPE_BITS), rounded away from 0
+} GripSegment;
+
+// a grip from the grip library (default_Grips), compiled into segments when it is selected (~165 bytes).
+// The segment of the grip position is found by searching the few segments of each finger, as a table of the segment
+// at every count value (404 bytes per grip) was no faster once the finger writes of run() are included
 typedef struct _GripType
 {
 	uint8_t num;
-	const char *name;
 
-	GripStep step[NUM_GRIP_STEPS];
+	uint8_t numSegs[NUM_FINGERS];							// number of segments of each finger
+	GripSegment fingerSeg[NUM_FINGERS][GRIP_MAX_KEYS - 1];	// segment of each finger, between each pair of neighbouring keyframes
 } GripType;
 
 
@@ -47,7 +54,7 @@ class GRIP_CLASS
 	public:
 		GRIP_CLASS();
 
-		void begin(void);					// store all the default grips (default_GripPos) in _allGrips
+		void begin(void);					// select the first grip of the grip library (default_Grips)
 		
 		void setGrip(int gNum);				// set the current grip to the grip number gNum
 		int getGrip(void);					// get the number of the current grip							
@@ -70,6 +77,11 @@ class GRIP_CLASS
 		void setSpeed(int speed);			// set the speed at which the fingers move
 		int getSpeed(void);					// get the target speed of the fingers
 
+		void setBlend(int gNum, int weight);	// blend the finger positions of the current grip towards grip gNum, by weight (0 - GRIP_BLEND_MAX)
+		int getBlendGrip(void);				// get the number of the grip that the current grip is blended towards
+		int getBlend(void);					// get the blend weight, 0 if the current grip is not blended
+
+		int getFingerPos(int fingerNum);	// get the target position of a finger at the grip position, including any blend
 		void run(void);						// calculate the target position for each finger depending on the target step number (_pos)
 
 
@@ -78,13 +90,17 @@ class GRIP_CLASS
 		uint16_t _pos;						// target grip position (in steps)
 		uint16_t _dir;						// target grip direction
 	private:
-		GripType _allGrips[NUM_GRIPS];		// all grip numbers, names and finger positions
-		GripType *_currGrip = NULL;			// pointer to the current grip
+		GripType _currGrip;					// the current grip, compiled from the grip library
+		GripType _blendGrip;				// the grip that the current grip is blended towards, compiled from the grip library
+		uint16_t _blend;					// blend weight (0 - GRIP_BLEND_MAX)
 
 		//uint16_t _pos;						// target grip position (in steps)
 		//uint16_t _dir;						// target grip direction
 		uint16_t _speed;					// target grip speed
 
+		void compile(GripType *grip, int gNum);	// compile the keyframes of grip gNum into segments
+		int calcFingerPos(const GripType *grip, int fingerNum);	// position of a finger of a compiled grip at the grip position (_pos)
+
 
 
 };
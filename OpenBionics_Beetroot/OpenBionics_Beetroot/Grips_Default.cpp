@@ -14,181 +14,184 @@
 */
 
 #include "Grips_Default.h"
+#include "Grips.h"				// GRIP_OPEN, GRIP_CLOSE
 
+// The grip library is constexpr, so that it is stored in flash and is checked when it is compiled.
+// Each finger lists only its own keyframes, { count, position }, which must start at GRIP_OPEN (0) and end at GRIP_CLOSE (100).
+// A finger that does not move between two keyframes only needs a keyframe at either end of the movement.
 
-#if (BRUNEL_VER == 1)
-
-// grip names + empty string
-const char* default_GripNames[NUM_GRIPS + 1] = {
-	"Fist", \
-	"Hook", \
-	"Point", \
-	"Pinch", \
-	"Tripod", \
-	"Finger Roll", \
-	"Thumb Roll", \
-	""		// EMPTY STR
-};  
 
+#if (BRUNEL_VER == 1)
 
 #define OPPOSE_PINCH	600 // 680
 #define OPPOSE_TRIPOD	680 // 770
 
 
-
-// array to hold the finger positions for each grip
-uint16_t default_GripPos[NUM_GRIPS][NUM_GRIP_STEPS][NUM_FINGERS + 1] = {
-	{	// FIST
-		//COUNT		F0				F1				F2				F3 & F4
-		{ 0,		OPPOSE_TRIPOD,	FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN },	//OPEN
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTA
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },	//MIDPOINTB
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTC
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTD
-		{ 100,		OPPOSE_TRIPOD,	FULLY_CLOSED,	FULLY_CLOSED,	850 },			//CLOSED
+// the grip library, in flash
+constexpr GripDef default_Grips[NUM_GRIPS] = {
+	{	"Fist",
+		{	// F0
+			{ { 0, OPPOSE_TRIPOD },	{ 100, OPPOSE_TRIPOD } },
+			// F1
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_CLOSED } },
+			// F2
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_CLOSED } },
+			// F3 & F4
+			{ { 0, FULLY_OPEN },	{ 100, 850 } },
+		}
 	},
-	{	// HOOK
-		//COUNT		F0				F1				F2				F3 & F4
-		{ 0,		FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN },	//OPEN
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTA
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTB
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTC
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTD
-		{ 100,		FULLY_OPEN,		FULLY_CLOSED,	FULLY_CLOSED,	850 },			//CLOSED
+	{	"Hook",
+		{	// F0
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_OPEN } },
+			// F1
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_CLOSED } },
+			// F2
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_CLOSED } },
+			// F3 & F4
+			{ { 0, FULLY_OPEN },	{ 100, 850 } },
+		}
 	},
-	{	// POINT
-		//COUNT		F0				F1				F2				F3 & F4
-		{ 0,		OPPOSE_PINCH,	FULLY_OPEN,		FULLY_CLOSED,	850 },			//OPEN
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTA
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTB
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTC
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTD
-		{ 100,		OPPOSE_PINCH,	FULLY_CLOSED,	FULLY_CLOSED,	850 },			//CLOSED
+	{	"Point",
+		{	// F0
+			{ { 0, OPPOSE_PINCH },	{ 100, OPPOSE_PINCH } },
+			// F1
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_CLOSED } },
+			// F2
+			{ { 0, FULLY_CLOSED },	{ 100, FULLY_CLOSED } },
+			// F3 & F4
+			{ { 0, 850 },			{ 100, 850 } },
+		}
 	},
-	{	// PINCH
-		//COUNT		F0				F1				F2				F3 & F4
-		{ 0,		OPPOSE_PINCH,	FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN },	//OPEN
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTA
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTB
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTC
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTD
-		{ 100,		OPPOSE_PINCH,	FULLY_CLOSED,	FULLY_OPEN,		FULLY_OPEN },	//CLOSED
+	{	"Pinch",
+		{	// F0
+			{ { 0, OPPOSE_PINCH },	{ 100, OPPOSE_PINCH } },
+			// F1
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_CLOSED } },
+			// F2
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_OPEN } },
+			// F3 & F4
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_OPEN } },
+		}
 	},
-
-	{	// TRIPOD
-		//COUNT		F0				F1				F2				F3 & F4
-		{ 0,		OPPOSE_TRIPOD,	FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN },	//OPEN
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTA
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTB
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTC
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTD
-		{ 100,		OPPOSE_TRIPOD,	FULLY_CLOSED,	FULLY_CLOSED,	FULLY_OPEN },	//CLOSED
+	{	"Tripod",
+		{	// F0
+			{ { 0, OPPOSE_TRIPOD },	{ 100, OPPOSE_TRIPOD } },
+			// F1
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_CLOSED } },
+			// F2
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_CLOSED } },
+			// F3 & F4
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_OPEN } },
+		}
 	},
-	{	// FINGER ROLL
-		//COUNT		F0				F1				F2				F3 & F4
-		{ 0,		FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN },	//OPEN
-		{ 20,		FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN,		BLANK },		//MIDPOINTA
-		{ 40,		FULLY_OPEN,		FULLY_OPEN,		BLANK,			850 },			//MIDPOINTB
-		{ 60,		FULLY_OPEN,		BLANK,			FULLY_CLOSED,	850 },			//MIDPOINTC
-		{ 80,		BLANK,			FULLY_CLOSED,	FULLY_CLOSED,	850 },			//MIDPOINTD
-		{ 100,		800,			FULLY_CLOSED,	FULLY_CLOSED,	850 },			//CLOSED
+	{	"Finger Roll",
+		{	// F0
+			{ { 0, FULLY_OPEN },	{ 60, FULLY_OPEN },		{ 100, 800 } },
+			// F1
+			{ { 0, FULLY_OPEN },	{ 40, FULLY_OPEN },		{ 80, FULLY_CLOSED },	{ 100, FULLY_CLOSED } },
+			// F2
+			{ { 0, FULLY_OPEN },	{ 20, FULLY_OPEN },		{ 60, FULLY_CLOSED },	{ 100, FULLY_CLOSED } },
+			// F3 & F4
+			{ { 0, FULLY_OPEN },	{ 40, 850 },			{ 100, 850 } },
+		}
 	},
-	{	// THUMB ROLL
-		//COUNT		F0				F1				F2				F3 & F4
-		{ 0,		FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN },	//OPEN
-		{ 20,		800,			FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN },	//MIDPOINTA
-		{ 40,		800,			FULLY_CLOSED,	FULLY_OPEN,		FULLY_OPEN },	//MIDPOINTB
-		{ 60,		800,			FULLY_CLOSED,	FULLY_CLOSED,	FULLY_OPEN },	//MIDPOINTC
-		{ 80,		800,			FULLY_CLOSED,	FULLY_CLOSED,	850 },			//MIDPOINTD
-		{ 100,		800,			FULLY_CLOSED,	FULLY_CLOSED,	850 },			//CLOSED
+	{	"Thumb Roll",
+		{	// F0
+			{ { 0, FULLY_OPEN },	{ 20, 800 },			{ 100, 800 } },
+			// F1
+			{ { 0, FULLY_OPEN },	{ 20, FULLY_OPEN },		{ 40, FULLY_CLOSED },	{ 100, FULLY_CLOSED } },
+			// F2
+			{ { 0, FULLY_OPEN },	{ 40, FULLY_OPEN },		{ 60, FULLY_CLOSED },	{ 100, FULLY_CLOSED } },
+			// F3 & F4
+			{ { 0, FULLY_OPEN },	{ 60, FULLY_OPEN },		{ 80, 850 },			{ 100, 850 } },
+		}
 	},
 };
 
 #elif (BRUNEL_VER == 2)
 
-// grip names + empty string
-const char* default_GripNames[NUM_GRIPS + 1] = {
-	"Fist", \
-	"Hook", \
-	"Point", \
-	"Pinch", \
-	"Tripod", \
-	"Finger Roll", \
-	"Thumb Roll"
-	""		// EMPTY STR
-};
+#define OPPOSE_PINCH	 620 // 565 // 730	// 620
+#define OPPOSE_TRIPOD	 700 // 685 // 890	// 720
 
 
-#define OPPOSE_PINCH	 620 // 565 // 730	// 620 
-#define OPPOSE_TRIPOD	 700 // 685 // 890	// 720 
-
-
-
-// array to hold the finger positions for each grip
-uint16_t default_GripPos[NUM_GRIPS][NUM_GRIP_STEPS][NUM_FINGERS + 1] = {
-	{	// FIST
-		//COUNT		F0				F1				F2				F3 & F4
-		{ 0,		OPPOSE_TRIPOD,	FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN },	//OPEN
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTA
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTB
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTC
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTD
-		{ 100,		OPPOSE_TRIPOD,	850,			850,			FULLY_CLOSED },	//CLOSED
+// the grip library, in flash
+constexpr GripDef default_Grips[NUM_GRIPS] = {
+	{	"Fist",
+		{	// F0
+			{ { 0, OPPOSE_TRIPOD },	{ 100, OPPOSE_TRIPOD } },
+			// F1
+			{ { 0, FULLY_OPEN },	{ 100, 850 } },
+			// F2
+			{ { 0, FULLY_OPEN },	{ 100, 850 } },
+			// F3 & F4
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_CLOSED } },
+		}
 	},
-	{	// HOOK
-		//COUNT		F0				F1				F2				F3 & F4
-		{ 0,		FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN },	//OPEN
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTA
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTB
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTC
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTD
-		{ 100,		FULLY_OPEN,		FULLY_CLOSED,	FULLY_CLOSED,	FULLY_CLOSED },			//CLOSED
+	{	"Hook",
+		{	// F0
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_OPEN } },
+			// F1
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_CLOSED } },
+			// F2
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_CLOSED } },
+			// F3 & F4
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_CLOSED } },
+		}
 	},
-	{	// POINT
-		//COUNT		F0				F1				F2				F3 & F4
-		{ 0,		OPPOSE_PINCH,	FULLY_OPEN,		FULLY_CLOSED,	FULLY_CLOSED },	//OPEN
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTA
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTB
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTC
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTD
-		{ 100,		OPPOSE_PINCH,	850,			FULLY_CLOSED,	FULLY_CLOSED },	//CLOSED
+	{	"Point",
+		{	// F0
+			{ { 0, OPPOSE_PINCH },	{ 100, OPPOSE_PINCH } },
+			// F1
+			{ { 0, FULLY_OPEN },	{ 100, 850 } },
+			// F2
+			{ { 0, FULLY_CLOSED },	{ 100, FULLY_CLOSED } },
+			// F3 & F4
+			{ { 0, FULLY_CLOSED },	{ 100, FULLY_CLOSED } },
+		}
 	},
-	{	// PINCH
-		//COUNT		F0				F1				F2				F3 & F4
-		{ 0,		OPPOSE_PINCH,	FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN },	//OPEN
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTA
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTB
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTC
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTD
-		{ 100,		OPPOSE_PINCH,	850,			FULLY_OPEN,		FULLY_OPEN },	//CLOSED
+	{	"Pinch",
+		{	// F0
+			{ { 0, OPPOSE_PINCH },	{ 100, OPPOSE_PINCH } },
+			// F1
+			{ { 0, FULLY_OPEN },	{ 100, 850 } },
+			// F2
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_OPEN } },
+			// F3 & F4
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_OPEN } },
+		}
 	},
-
-	{	// TRIPOD
-		//COUNT		F0				F1				F2				F3 & F4
-		{ 0,		OPPOSE_TRIPOD,	FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN },	//OPEN
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTA
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTB
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTC
-		{ BLANK,	BLANK,			BLANK,			BLANK,			BLANK },		//MIDPOINTD
-		{ 100,		OPPOSE_TRIPOD,	850,			850,			FULLY_OPEN },	//CLOSED
+	{	"Tripod",
+		{	// F0
+			{ { 0, OPPOSE_TRIPOD },	{ 100, OPPOSE_TRIPOD } },
+			// F1
+			{ { 0, FULLY_OPEN },	{ 100, 850 } },
+			// F2
+			{ { 0, FULLY_OPEN },	{ 100, 850 } },
+			// F3 & F4
+			{ { 0, FULLY_OPEN },	{ 100, FULLY_OPEN } },
+		}
 	},
-	{	// FINGER ROLL
-		//COUNT		F0				F1				F2				F3 & F4
-		{ 0,		FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN },	//OPEN
-		{ 20,		FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN,		BLANK },		//MIDPOINTA
-		{ 40,		FULLY_OPEN,		FULLY_OPEN,		BLANK,			FULLY_CLOSED },	//MIDPOINTB
-		{ 60,		FULLY_OPEN,		BLANK,			850,			FULLY_CLOSED },	//MIDPOINTC
-		{ 80,		BLANK,			850,			850,			FULLY_CLOSED },	//MIDPOINTD
-		{ 100,		FULLY_CLOSED,	850,			850,			FULLY_CLOSED },	//CLOSED
+	{	"Finger Roll",
+		{	// F0
+			{ { 0, FULLY_OPEN },	{ 60, FULLY_OPEN },		{ 100, FULLY_CLOSED } },
+			// F1
+			{ { 0, FULLY_OPEN },	{ 40, FULLY_OPEN },		{ 80, 850 },			{ 100, 850 } },
+			// F2
+			{ { 0, FULLY_OPEN },	{ 20, FULLY_OPEN },		{ 60, 850 },			{ 100, 850 } },
+			// F3 & F4
+			{ { 0, FULLY_OPEN },	{ 40, FULLY_CLOSED },	{ 100, FULLY_CLOSED } },
+		}
 	},
-	{	// THUMB ROLL
-		//COUNT		F0				F1				F2				F3 & F4
-		{ 0,		FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN },	//OPEN
-		{ 20,		FULLY_CLOSED,	FULLY_OPEN,		FULLY_OPEN,		FULLY_OPEN },	//MIDPOINTA
-		{ 40,		FULLY_CLOSED,	850,			FULLY_OPEN,		FULLY_OPEN },	//MIDPOINTB
-		{ 60,		FULLY_CLOSED,	850,			850,			FULLY_OPEN },	//MIDPOINTC
-		{ 80,		FULLY_CLOSED,	850,			850,			FULLY_CLOSED },	//MIDPOINTD
-		{ 100,		FULLY_CLOSED,	850,			850,			FULLY_CLOSED },	//CLOSED
+	{	"Thumb Roll",
+		{	// F0
+			{ { 0, FULLY_OPEN },	{ 20, FULLY_CLOSED },	{ 100, FULLY_CLOSED } },
+			// F1
+			{ { 0, FULLY_OPEN },	{ 20, FULLY_OPEN },		{ 40, 850 },			{ 100, 850 } },
+			// F2
+			{ { 0, FULLY_OPEN },	{ 40, FULLY_OPEN },		{ 60, 850 },			{ 100, 850 } },
+			// F3 & F4
+			{ { 0, FULLY_OPEN },	{ 60, FULLY_OPEN },		{ 80, FULLY_CLOSED },	{ 100, FULLY_CLOSED } },
+		}
 	},
 };
 
@@ -196,3 +199,58 @@ uint16_t default_GripPos[NUM_GRIPS][NUM_GRIP_STEPS][NUM_FINGERS + 1] = {
 #else
 #error No BRUNEL_VER version defined in Globals.h
 #endif
+
+
+////////////////////////////// Validation //////////////////////////////
+
+// number of keyframes of a finger, up to the first keyframe that is not used
+static constexpr int numKeys(const GripKey *key, int k = 0)
+{
+	return ((k < GRIP_MAX_KEYS) && (key[k].pos != 0)) ? numKeys(key, k + 1) : k;
+}
+
+// returns true if no keyframe is used from keyframe k onwards
+static constexpr bool keysUnused(const GripKey *key, int k)
+{
+	return (k >= GRIP_MAX_KEYS) || ((key[k].count == 0) && (key[k].pos == 0) && keysUnused(key, k + 1));
+}
+
+// returns true if the count values of a finger increase from keyframe k onwards, with no keyframe after one that is not used
+static constexpr bool keysInOrderFrom(const GripKey *key, int k)
+{
+	return (k >= numKeys(key)) ? keysUnused(key, numKeys(key)) : ((key[k].count > key[k - 1].count) && keysInOrderFrom(key, k + 1));
+}
+
+// returns true if the finger positions are within the range of the finger from keyframe k onwards
+static constexpr bool keysInRangeFrom(const GripKey *key, int k)
+{
+	return (k >= numKeys(key)) || ((key[k].pos >= MIN_FINGER_POS) && (key[k].pos <= MAX_FINGER_POS) && keysInRangeFrom(key, k + 1));
+}
+
+// returns true if the count values of a finger increase, with no keyframe after one that is not used
+static constexpr bool keysInOrder(const GripKey *key)
+{
+	return keysInOrderFrom(key, 1);
+}
+
+// returns true if the finger positions are within the range of the finger
+static constexpr bool keysInRange(const GripKey *key)
+{
+	return keysInRangeFrom(key, 0);
+}
+
+// returns true if a finger has a keyframe at GRIP_OPEN and at GRIP_CLOSE
+static constexpr bool keysComplete(const GripKey *key)
+{
+	return (numKeys(key) >= 2) && (key[0].count == GRIP_OPEN) && (key[numKeys(key) - 1].count == GRIP_CLOSE);
+}
+
+// returns true if every finger of every grip from grip g & finger f onwards passes the check
+static constexpr bool libraryCheck(bool (*check)(const GripKey *), int g = 0, int f = 0)
+{
+	return (g >= NUM_GRIPS) || ((f >= NUM_FINGERS) ? libraryCheck(check, g + 1, 0) : (check(default_Grips[g].key[f]) && libraryCheck(check, g, f + 1)));
+}
+
+static_assert(libraryCheck(keysComplete), "Every finger of every grip needs a keyframe at GRIP_OPEN and at GRIP_CLOSE (the grip may have too few entries)");
+static_assert(libraryCheck(keysInOrder), "The count values of the keyframes of each finger must increase, with no gaps");
+static_assert(libraryCheck(keysInRange), "Every keyframe position must be between MIN_FINGER_POS and MAX_FINGER_POS");
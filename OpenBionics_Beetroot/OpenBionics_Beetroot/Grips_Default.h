@@ -29,7 +29,7 @@
 #define G4	4
 #define G5	5
 #define G6	6
-#define NUM_GRIP_STEPS	6
+#define GRIP_MAX_KEYS	6		// max keyframes of each finger of a grip
 
 // FINGER POSITIONS
 #define FULLY_OPEN		MIN_FINGER_POS					// fully open position for the hand, from FingerLib.h
@@ -37,9 +37,22 @@
 #define BLANK			(-1)							// no position entered (ignored)
 #define MID_POS			((FULLY_CLOSED - FULLY_OPEN)/2)	// mid position between fully open and fully closed
 
+// a keyframe of a finger, the finger position at a count value of the grip
+typedef struct _GripKey
+{
+	uint8_t count;			// count value of the keyframe (0 - 100, open - close)
+	uint16_t pos;			// finger position at the count value, 0 if the keyframe is not used
+} GripKey;
+
+// a grip's name and the keyframes of each finger, in order of count value. The finger is interpolated between the keyframes
+typedef struct _GripDef
+{
+	const char *name;
+	GripKey key[NUM_FINGERS][GRIP_MAX_KEYS];
+} GripDef;
+
 // GRIP NAMES AND POSITIONS
-extern const char* default_GripNames[NUM_GRIPS + 1];								// grip names + empty string
-extern uint16_t default_GripPos[NUM_GRIPS][NUM_GRIP_STEPS][NUM_FINGERS + 1];		// array to hold the finger positions for each grip
+extern const GripDef default_Grips[NUM_GRIPS];		// the grip library, in flash
 
 
 
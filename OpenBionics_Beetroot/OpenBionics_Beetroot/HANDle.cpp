@@ -19,6 +19,8 @@
 
 #include "Grips.h"
 #include "Initialisation.h"
+#include "ResponseCurve.h"
+#include "Trace.h"
 
 HANDLE_CLASS HANDle;
 
@@ -154,6 +156,9 @@ uint8_t HANDLE_CLASS::poll(void)
 		delay(HANDLE_I2C_DEL);
 	}
 
+	// record the raw values, if trace recording is enabled
+	Trace.record(TRACE_HANDLE, values, count);
+
 	// decode and store received values
 	raw.joy.x = values[0];
 	raw.joy.y = values[1];
@@ -229,12 +234,38 @@ void HANDLE_CLASS::checkJoy(void)
 {
 	// add new grip position to current grip positions
 	_pos += calcPosChange();
-	_pos = constrain(_pos, 0, 100);
+	_pos = constrain(_pos, 0, ((int32_t)100 << CURVE_FRAC_BITS));
+	checkBlend();
 	Grip.setSpeed(MAX_FINGER_PWM);
-	Grip.setPos(_pos);
+	Grip.setPos(_pos >> CURVE_FRAC_BITS);
 	Grip.run();
 }
 
+// GRIP BLEND CONTROL
+// moving the joystick right/left blends the current grip towards the next/previous grip, fully at the end of travel
+void HANDLE_CLASS::checkBlend(void)
+{
+	int x = constrain(raw.joy.x, -HANDLE_JOY_MAX, HANDLE_JOY_MAX);
+	int gNum = Grip.getGrip();
+
+	if (abs(x) <= HANDLE_BLEND_DEADZONE)
+	{
+		Grip.setBlend(gNum, 0);
+		return;
+	}
+
+	if (x > 0)
+	{
+		gNum = (gNum + 1) % NUM_GRIPS;
+	}
+	else
+	{
+		gNum = (gNum + NUM_GRIPS - 1) % NUM_GRIPS;
+	}
+
+	Grip.setBlend(gNum, map(abs(x), HANDLE_BLEND_DEADZONE, HANDLE_JOY_MAX, 0, GRIP_BLEND_MAX));
+}
+
 
 void HANDLE_CLASS::checkButtons(void)
 {
@@ -301,25 +332,10 @@ void HANDLE_CLASS::checkButtons(void)
 
 
 
-double HANDLE_CLASS::calcPosChange(void)
+// calculate the change in position (Q16.16) from the joystick position, using the HANDle response curve
+int32_t HANDLE_CLASS::calcPosChange(void)
 {
-	bool invert = false;
-	//uint8_t  power = 3;
-	//static double k = pow(HANDLE_JOY_MAX / 3, power);			// normalise, then modify expo sensitivity
-
-	uint8_t  power = 2;
-	static double k = pow((HANDLE_JOY_MAX / 3), power);			// normalise, then modify expo sensitivity
-
-	if (isEven(power) && (raw.joy.y < 0))				// fix issue that -x^2 = x?^2 
-		invert = true;
-
-	// calculate position change as exponent (sensitivity is x^power proportional to _yPos)
-	_exp = pow(raw.joy.y, power) / k;
-
-	if (invert)						// fix issue that -x^2 = x?^2
-	{
-		_exp = -_exp;
-	}
+	_exp = Curve[CURVE_HANDLE].calc(raw.joy.y);
 
 	return _exp;
 }
@@ -329,11 +345,19 @@ double HANDLE_CLASS::calcPosChange(void)
 void HANDLE_CLASS::print(void)
 {
 	MYSERIAL_PRINT(Grip.getGripName());
+	if (Grip.getBlend())
+	{
+		MYSERIAL_PRINT_PGM(" -> ");
+		MYSERIAL_PRINT(Grip.getGripName(Grip.getBlendGrip()));
+		MYSERIAL_PRINT_PGM(" ");
+		MYSERIAL_PRINT((Grip.getBlend() * 100) / GRIP_BLEND_MAX);
+		MYSERIAL_PRINT_PGM("%");
+	}
 	MYSERIAL_PRINT_PGM("  \tPos ");
 	MYSERIAL_PRINT(raw.joy.y);
 
 	MYSERIAL_PRINT_PGM("  \texp ");
-	MYSERIAL_PRINT(_exp);
+	MYSERIAL_PRINT((float)_exp / (1UL << CURVE_FRAC_BITS));
 	MYSERIAL_PRINT_PGM("  \tHand pos ");
-	MYSERIAL_PRINTLN((int)_pos);
+	MYSERIAL_PRINTLN(_pos >> CURVE_FRAC_BITS);
 }
\ No newline at end of file
@@ -23,6 +23,8 @@
 
 #define HANDLE_CAL_JOY_MID	0
 
+#define HANDLE_BLEND_DEADZONE	10		// joystick X values within this of the middle do not blend the grip
+
 // uncomment the following line to print the raw values from the HANDle
 //#define PRINT_RAW_VALUES
 
@@ -70,17 +72,18 @@ private:
 	HANDleVals raw;
 	HANDleVals calib;
 
-	double _exp;
-	double _pos;
+	int32_t _exp;			// Q16.16, change in position from the response curve
+	int32_t _pos;			// Q16.16, grip position
 
 	uint8_t poll(void);
 	void calibrate(void);
 	void print(void);
 
 	void checkJoy(void);
+	void checkBlend(void);
 	void checkButtons(void);
 
-	double calcPosChange(void);
+	int32_t calcPosChange(void);
 };
 
 extern HANDLE_CLASS HANDle;
@@ -0,0 +1,109 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	I2C_ADC_MAX1161X.cpp
+*
+*/
+
+// MAX11612 - MAX11617 4/8/12 channel 12 bit I2C ADC
+
+#include <Wire.h>
+
+#include "I2C_ADC_MAX1161X.h"
+
+I2C_ADC_MAX1161X ADC2;
+
+////////////////////////////// Constructors/Destructors //////////////////////////////
+
+I2C_ADC_MAX1161X::I2C_ADC_MAX1161X()
+{
+	_addr = MAX1161X_ADDR;
+	_numChannels = 0;
+	_shift = 0;
+	_numErrors = 0;
+
+	for (int c = 0; c < MAX1161X_MAX_CHANNELS; c++)
+	{
+		_samples[c] = 0;
+	}
+}
+
+////////////////////////////// Public Methods //////////////////////////////
+
+// configure a scan of AIN0 - AIN(numChannels - 1), with 'res' bits, returns false if the ADC does not respond
+bool I2C_ADC_MAX1161X::begin(uint8_t numChannels, uint8_t res, uint8_t addr)
+{
+	if ((numChannels == 0) || (numChannels > MAX1161X_MAX_CHANNELS))
+		return false;
+
+	_addr = addr;
+	_numChannels = numChannels;
+	_shift = (res < MAX1161X_RES) ? (MAX1161X_RES - res) : 0;
+	_numErrors = 0;
+
+	// raise the clock of the shared bus (the EEPROM & IMU also support fast mode)
+	Wire.setClock(MAX1161X_I2C_CLOCK);
+
+	Wire.beginTransmission(_addr);
+	Wire.write(MAX1161X_SETUP | MAX1161X_SETUP_REF_VDD | MAX1161X_SETUP_INT_CLK | MAX1161X_SETUP_UNIPOLAR | MAX1161X_SETUP_NO_RESET);
+	Wire.write(MAX1161X_CONFIG | MAX1161X_CONFIG_SCAN_TO_CS | MAX1161X_CONFIG_CS(numChannels - 1) | MAX1161X_CONFIG_SINGLE);
+
+	return (Wire.endTransmission() == 0);
+}
+
+// check whether the ADC is responding
+bool I2C_ADC_MAX1161X::ping(void)
+{
+	Wire.beginTransmission(_addr);
+
+	return (Wire.endTransmission() == 0);
+}
+
+// convert and read every channel in a single transaction, returns false if the frame is incomplete
+bool I2C_ADC_MAX1161X::read(int *samples)
+{
+	uint8_t numBytes = _numChannels * 2;
+
+	if (!_numChannels || (Wire.requestFrom(_addr, numBytes) != numBytes))
+	{
+		_numErrors++;
+		return false;
+	}
+
+	for (uint8_t c = 0; c < _numChannels; c++)
+	{
+		uint8_t msb = Wire.read();
+		uint8_t lsb = Wire.read();
+
+		_samples[c] = (((msb & 0x0F) << 8) | lsb) >> _shift;
+		samples[c] = _samples[c];
+	}
+
+	return true;
+}
+
+// most recent sample of a channel
+int I2C_ADC_MAX1161X::read(uint8_t ch)
+{
+	return (ch < _numChannels) ? _samples[ch] : 0;
+}
+
+// number of channels within the scan
+uint8_t I2C_ADC_MAX1161X::getNumChannels(void)
+{
+	return _numChannels;
+}
+
+// number of incomplete frames
+uint32_t I2C_ADC_MAX1161X::getNumErrors(void)
+{
+	return _numErrors;
+}
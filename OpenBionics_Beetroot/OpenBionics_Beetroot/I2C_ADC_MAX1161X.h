@@ -0,0 +1,83 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	I2C_ADC_MAX1161X.h
+*
+*/
+
+// MAX11612 - MAX11617 4/8/12 channel 12 bit I2C ADC, used for multi-site EMG over the headphone jack.
+// The ADC is configured to scan from AIN0 to the last channel, using the internal clock. Each read of the device
+// then converts every channel of the scan (holding SCL low while converting), and returns the results as one
+// burst, so a frame of every channel takes a single I2C transaction.
+//
+// Each result is 2 bytes, the first byte is 1111 followed by the 4 MSBs, the second byte is the 8 LSBs.
+//
+// The ADC shares the I2C bus (Wire) with the EEPROM (24AA08) and the IMU (LSM9DS1). begin() raises the clock of the
+// whole bus to MAX1161X_I2C_CLOCK, which both are rated for at 3.3V, so their transfers also run at 400kHz from then on.
+// Wire.begin() resets the clock to 100kHz, so begin() must be called after it (deviceSetup()). Every user of the bus
+// runs from loop(), so a frame is never split by another transfer, but frames are skipped while loop() waits on
+// another device (e.g. the EEPROM write cycle).
+//
+// read() blocks for the whole frame, the address and 2 bytes per channel at 9 clocks per byte, plus the conversion of
+// each channel while SCL is held low (MAX1161X_FRAME_US()). At 400kHz a frame of 8 channels takes ~0.45ms, so at 1kHz
+// the EMG task spends ~45% of the CPU waiting on the bus (the EMG task time is shown by the loop profiler, L).
+// EMGControl.cpp checks that a frame takes no more than half of the sample period.
+
+#ifndef I2C_ADC_MAX1161X_H_
+#define I2C_ADC_MAX1161X_H_
+
+#include <Arduino.h>
+
+#define MAX1161X_ADDR				0x33	// MAX11614/MAX11615 (MAX11612/MAX11613 = 0x34, MAX11616/MAX11617 = 0x35)
+#define MAX1161X_MAX_CHANNELS		12		// MAX11616/MAX11617
+#define MAX1161X_RES				12		// bits
+#define MAX1161X_I2C_CLOCK			400000	// Hz, fast mode, so that a frame of 8 channels takes < 0.5ms
+#define MAX1161X_CONV_US			8		// us, approx conversion time of each channel using the internal clock
+#define MAX1161X_FRAME_US(n)		(((((1 + (2 * (n))) * 9UL) * 1000000UL) / MAX1161X_I2C_CLOCK) + ((n) * MAX1161X_CONV_US))	// us, approx time to read a frame of n channels
+
+// SETUP BYTE
+#define MAX1161X_SETUP				0x80	// REG = 1, setup byte
+#define MAX1161X_SETUP_REF_VDD		0x00	// SEL2:0 = 000, VDD reference
+#define MAX1161X_SETUP_INT_CLK		0x00	// CLK = 0, internal clock, conversions start when the device is read
+#define MAX1161X_SETUP_UNIPOLAR		0x00	// BIP/UNI = 0, unipolar
+#define MAX1161X_SETUP_NO_RESET		0x02	// RST = 1, keep the configuration register
+
+// CONFIGURATION BYTE
+#define MAX1161X_CONFIG				0x00	// REG = 0, configuration byte
+#define MAX1161X_CONFIG_SCAN_TO_CS	0x00	// SCAN1:0 = 00, scan from AIN0 to the input selected by CS3:0
+#define MAX1161X_CONFIG_CS(ch)		(((ch) & 0x0F) << 1)	// CS3:0, last input of the scan
+#define MAX1161X_CONFIG_SINGLE		0x01	// SGL/DIF = 1, single-ended
+
+class I2C_ADC_MAX1161X
+{
+	public:
+		I2C_ADC_MAX1161X();
+
+		bool begin(uint8_t numChannels, uint8_t res = MAX1161X_RES, uint8_t addr = MAX1161X_ADDR);	// configure a scan of AIN0 - AIN(numChannels - 1), with 'res' bits, returns false if the ADC does not respond
+		bool ping(void);							// check whether the ADC is responding, returns false if no response
+
+		bool read(int *samples);					// convert and read every channel in a single transaction, returns false if the frame is incomplete
+		int read(uint8_t ch);						// most recent sample of a channel
+
+		uint8_t getNumChannels(void);				// number of channels within the scan
+		uint32_t getNumErrors(void);				// number of incomplete frames
+
+	private:
+		uint8_t _addr;								// I2C address
+		uint8_t _numChannels;						// number of channels within the scan
+		uint8_t _shift;								// number of bits to remove from each result, to give the requested resolution
+		int _samples[MAX1161X_MAX_CHANNELS];		// most recent sample of each channel
+		uint32_t _numErrors;						// number of incomplete frames
+};
+
+extern I2C_ADC_MAX1161X ADC2;
+
+#endif // I2C_ADC_MAX1161X_H_
@@ -115,7 +115,7 @@ int I2C_EEPROM::readMany(int loc, uint8_t* val, int totalToRead)
 		}
 		Wire.endTransmission();
 
-	} while ((loc + valIndex) < totalToRead);
+	} while (valIndex < totalToRead);
 
 	return true;			// return success
 }
@@ -123,7 +123,7 @@ int I2C_EEPROM::readMany(int loc, uint8_t* val, int totalToRead)
 // read many pieces of data from the EEPROM (by reading as a page), with the value passed as an int pointer
 int I2C_EEPROM::readMany(int loc, int* val, int totalToRead)
 {
-	readMany(loc, (uint8_t*)val, totalToRead);
+	return readMany(loc, (uint8_t*)val, totalToRead);
 }
 
 // write a single value to EEPROM
@@ -190,7 +190,7 @@ int I2C_EEPROM::writeMany(int loc, uint8_t* val, int totalToWrite)
 		while (!ping());	// wait for the write cycle to be complete
 
 
-	} while ((loc + valIndex) < totalToWrite);
+	} while (valIndex < totalToWrite);
 
 
 	return true;		// return success
@@ -199,7 +199,7 @@ int I2C_EEPROM::writeMany(int loc, uint8_t* val, int totalToWrite)
 // write many pieces of data to EEPROM (by writing as a page), with the value passed as an int pointer
 int I2C_EEPROM::writeMany(int loc, int* val, int totalToWrite)
 {
-	writeMany(loc, (uint8_t*)val, totalToWrite);
+	return writeMany(loc, (uint8_t*)val, totalToWrite);
 }
 
 // only write the value if the value has been changed (return 0 = no update, 1 = update, -1 = error)
@@ -24,6 +24,7 @@
 #include <Wire.h>
 
 #include "I2C_IMU_LSM9DS1.h"
+#include "Trace.h"
 
 // SCALE VALS FOR RESOLUTION CALC
 float IMU_ACCEL_SENSITIVITY[4] = { 0.000061, 0.000732, 0.000122, 0.000244 };	// g/LSB
@@ -178,6 +179,8 @@ bool LSM9DS1::poll(void)
 
 	if (availTemp())
 		updateTemp();
+
+	return true;
 }
 
 // calculate roll, pitch & yaw
@@ -572,7 +575,9 @@ void LSM9DS1::read(uint8_t addr, uint8_t reg, uint8_t *val, uint8_t size)
 	{
 		val[i] = Wire.read();
 	}
-	
+
+	// record the register values, if trace recording is enabled
+	Trace.recordReg(TRACE_IMU, addr, reg, val, size);
 }
 
 
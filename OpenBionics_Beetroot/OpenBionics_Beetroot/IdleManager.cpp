@@ -0,0 +1,85 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	IdleManager.cpp
+*
+*/
+
+#include "Globals.h"
+#include "EventQueue.h"
+#include "IdleManager.h"
+#include "TaskScheduler.h"
+#include "TimerManagement.h"
+
+IDLE_MANAGER Idle;
+
+////////////////////////////// Constructors/Destructors //////////////////////////////
+
+IDLE_MANAGER::IDLE_MANAGER()
+{
+	_sleepTime = 0;
+	_numSleeps = 0;
+	_resetTime = 0;
+}
+
+////////////////////////////// Public Methods //////////////////////////////
+
+// sleep until the next interrupt, if there is no work to do
+void IDLE_MANAGER::run(void)
+{
+	uint32_t start = micros();
+	bool slept = false;
+
+	// interrupts are disabled while checking for work, so that an interrupt can not occur between the check and
+	// the WFI. A pending interrupt still wakes the CPU, and is serviced once interrupts are re-enabled
+	noInterrupts();
+	if (!Events.getDepth() && !Events.tickPending() && !Scheduler.anyDue())
+	{
+		__WFI();
+		slept = true;
+	}
+	interrupts();
+
+	if (slept)
+	{
+		_sleepTime += micros() - start;
+		_numSleeps++;
+	}
+}
+
+// clear the sleep time
+void IDLE_MANAGER::reset(void)
+{
+	_sleepTime = 0;
+	_numSleeps = 0;
+	_resetTime = customMillis();
+}
+
+// print the time spent asleep since reset
+void IDLE_MANAGER::printStatus(void)
+{
+	long elapsed = customMillis() - _resetTime;		// ms
+
+	if (elapsed <= 0)
+	{
+		MYSERIAL_PRINTLN_PGM("Sleep:\t-");
+		return;
+	}
+
+	// print the percentage of time spent asleep, and the total sleep time
+	MYSERIAL_PRINT_PGM("Sleep:\t");
+	MYSERIAL_PRINT((float)_sleepTime / (elapsed * 10.0));
+	MYSERIAL_PRINT_PGM("% (");
+	MYSERIAL_PRINT((uint32_t)(_sleepTime / 1000));
+	MYSERIAL_PRINT_PGM("ms, ");
+	MYSERIAL_PRINT(_numSleeps);
+	MYSERIAL_PRINTLN_PGM(" sleeps)");
+}
@@ -0,0 +1,44 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	IdleManager.h
+*
+*/
+
+// Low power idle.
+// At the end of each pass of loop(), if no task is due and no events or ticks are waiting, the CPU is put to sleep
+// (WFI) until the next interrupt (the 1ms timer, USB, etc.). The SAMD21 resets to IDLE0 sleep, which only stops the
+// CPU clock, so the timers, ADC and USB continue to run. The time spent asleep is printed with the loop profiler (L).
+
+#ifndef IDLE_MANAGER_H_
+#define IDLE_MANAGER_H_
+
+#include <Arduino.h>
+
+class IDLE_MANAGER
+{
+	public:
+		IDLE_MANAGER();
+
+		void run(void);						// sleep until the next interrupt, if there is no work to do
+
+		void reset(void);					// clear the sleep time
+		void printStatus(void);				// print the time spent asleep since reset
+
+	private:
+		uint64_t _sleepTime;				// us, time spent asleep since reset
+		uint32_t _numSleeps;				// number of times the CPU has been put to sleep since reset
+		long _resetTime;					// ms, customMillis() at reset
+};
+
+extern IDLE_MANAGER Idle;
+
+#endif // IDLE_MANAGER_H_
@@ -22,16 +22,22 @@
 
 #include "I2C_IMU_LSM9DS1.h"				// IMU
 #include "Demo.h"							// DEMO
+#include "EMGClassifier.h"					// Classifier
 #include "EMGControl.h"						// EMG
 #include "ErrorHandling.h"					// ERROR
 #include "Grips.h"							// Grip
 #include "HANDle.h"							// HANDle
 #include "I2C_EEPROM.h"						// EEPROM
 #include "LED.h"							// NeoPixel
+#include "ResponseCurve.h"					// Curve
 #include "SerialControl.h"					// init char codes
+#include "StatsWindow.h"					// STATS_WINDOW
+#include "Trajectory.h"						// Trajectory
 #include "Watchdog.h"						// Watchdog
 
-static CIRCLE_BUFFER <float> tempBuff;		// temperature circular buffer
+static_assert((EEPROM_LOC_BOARD_SETTINGS + sizeof(Settings)) <= EEPROM_LOC_STORED_ERROR, "the settings overlap the stored error in EEPROM");
+
+static STATS_WINDOW <float, 4, double> tempBuff;		// temperature window (16 values)
 
 Settings settings;		// board settings
 
@@ -66,12 +72,19 @@ void deviceSetup(void)
 
 	initSerialCharCodes();		// assign the char codes and functions to char codes
 
+	Trajectory.begin();			// initialise the finger trajectories
+
 	Grip.begin();				// initialise the grips
 	Grip.setGrip(G0);
 	Grip.setDir(OPEN);
 	Grip.run();
 
+	// initialise the response curves, with the input range of the EMG ADC & HANDle joystick
+	Curve[CURVE_EMG].begin((1 << EMG_SAMPLE_RES), &settings.curve[CURVE_EMG]);
+	Curve[CURVE_HANDLE].begin(HANDLE_JOY_MAX, &settings.curve[CURVE_HANDLE]);
+
 	EMG.begin();				// initialise EMG control
+	Classifier.begin();			// load the EMG grip classifier model from EEPROM
 
 	IMU.begin();				// initialise IMU
 
@@ -93,6 +106,7 @@ void detectSerialConnection(void)
 	{
 		while (!MYSERIAL)				// wait for serial connection
 		{
+			runEvents();				// keep the LED running
 #if defined(ARDUINO_ARCH_SAMD)
 			Watchdog.reset();
 #endif
@@ -148,11 +162,43 @@ void resetToDefaults(void)
 	settings.mode = MODE_NONE;				// normal mode (not demo or EMG)
 
 	settings.emg.holdTime = 300;			// 300ms
-	settings.emg.peakThresh = 600;			// 600/1023
+	settings.emg.calibrated = false;
+	settings.emg.onset = 0;					// every channel uses the PEAK threshold
+
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		settings.emg.channel[c].peakThresh = 600;			// 600/1023
+		settings.emg.channel[c].hysteresis = 0;				// end a PEAK below peakThresh
+		settings.emg.channel[c].gain = EMG_GAIN_UNITY;		// x1.00
+	}
+
+	for (int g = 0; g < NUM_GESTURES; g++)
+	{
+		settings.gesture.action[g] = GESTURE_ACTION_NONE;
+	}
+	settings.gesture.action[GESTURE_HOLD_OPEN] = GESTURE_ACTION_NEXT_GRIP;	// hold OPEN to cycle through the grips
+	settings.gesture.favouriteGrip = 0;
+
+	settings.curve[CURVE_EMG].shape = CURVE_EXPO;		// x^2
+	settings.curve[CURVE_EMG].power = 20;
+	settings.curve[CURVE_EMG].deadZone = 0;
+	settings.curve[CURVE_EMG].gain = 400;				// 4% position change per sample at full signal
+
+	settings.curve[CURVE_HANDLE].shape = CURVE_EXPO;	// x^2
+	settings.curve[CURVE_HANDLE].power = 20;
+	settings.curve[CURVE_HANDLE].deadZone = 0;
+	settings.curve[CURVE_HANDLE].gain = 918;			// 9.18% position change per poll at full joystick
+
+	for (int c = 0; c < NUM_CURVES; c++)
+	{
+		Curve[c].update();					// rebuild the response curves from the default settings
+	}
 
 	settings.waitForSerial = true;			// wait for serial connection to start
 	settings.motorEn = true;				// enable all motors
 	settings.printInstr = true;				// print serial instructions
+	settings.classifierEn = false;			// select grips by holding OPEN
+	settings.trajectoryEn = false;			// move the fingers straight to each target, until the trajectories are tuned for the hand (A8)
 
 	settings.init = EEPROM_INIT_CODE;		// store the unique initialisation code to indicate that EEPROM has been initialised with values
 
@@ -292,23 +338,16 @@ void printDeviceInfo(void)
 	MYSERIAL_PRINTLN(handTypeNames[settings.handType]);
 }
 
-// monitor system status
+// monitor system status (run every 1s by the scheduler)
 void systemMonitor(void)
 {
-	static MS_NB_DELAY timer_1s;
-
-	if (timer_1s.timeElapsed(1000))
-	{
-		// monitor board temperature
-		monitorTemperature();	// duration 12.5ms (21/02/18)
-
-	}
+	// monitor board temperature
+	monitorTemperature();	// duration 12.5ms (21/02/18)
 }
 
 // read the device temperature, in 'C
 float readTemperature(void)
 {
-	const uint8_t buffSize = 16;			// temperature buffer size
 	static bool init = false;				// initialisation flag
 
 	// on the first run, load the buffer with battery values
@@ -316,9 +355,9 @@ float readTemperature(void)
 	{
 		//Comms.println("Init temperature buff");
 
-		tempBuff.begin(buffSize);			// init the buffer
+		tempBuff.begin();					// init the buffer
 
-		for (int i = 0; i < buffSize; i++)
+		for (int i = 0; i < tempBuff.size(); i++)
 		{
 			IMU.poll();
 			tempBuff.write(IMU.getTemp());	// fill the buffer with temperature values
@@ -16,12 +16,16 @@
 #ifndef INITIALISATION_H_
 #define INITIALISATION_H_
 
+#include "EMGControl.h"			// NUM_EMG_CHANNELS
+#include "EMGGesture.h"			// GestureSettings
+#include "ResponseCurve.h"		// CurveSettings
+
 // WATCHDOG SETTINGS
 #define WATCHDOG_RESET_PER			16000		// ms. cause a device reset at 16s
 
 // EEPROM
-#define EEPROM_LOC_BOARD_SETTINGS	1010		// location within EEPROM of settings
-#define EEPROM_INIT_CODE			7			// EEPROM init verification code
+#define EEPROM_LOC_BOARD_SETTINGS	960			// location within EEPROM of settings
+#define EEPROM_INIT_CODE			14			// EEPROM init verification code
 
 /////////////////////////////////////// BOARD SETTINGS ///////////////////////////////////
 typedef enum _HandType
@@ -52,10 +56,19 @@ typedef enum _HeadphoneJackMode
 
 
 
-typedef struct _EMGSettings
+typedef struct _EMGChannelSettings
 {
 	uint16_t peakThresh;	// threshold above which the EMG signal is a PEAK
+	uint8_t hysteresis;		// %, of peakThresh, the signal must fall below (peakThresh - hysteresis) to end a PEAK
+	uint8_t gain;			// x32 (EMG_GAIN_UNITY), applied to the signal for proportional control
+} EMGChannelSettings;
+
+typedef struct _EMGSettings
+{
 	uint16_t holdTime;		// amount of time a PEAK needs to be held to be recognised as a HOLD
+	uint8_t calibrated;		// the channel settings have been set by the calibration (E1), rather than by hand (U#)
+	uint8_t onset;			// bit per channel, the channel uses the onset detector (K#) rather than the PEAK threshold
+	EMGChannelSettings channel[NUM_EMG_CHANNELS];	// settings of each EMG channel
 } EMGSettings;
 
 typedef struct _Settings
@@ -64,10 +77,15 @@ typedef struct _Settings
 	OperatingMode mode;		// NONE, DEMO, EMG SIMPLE, EMG PROPORTIONAL
 
 	EMGSettings emg;		// EMG settings
+	GestureSettings gesture;	// action of each EMG gesture
+
+	CurveSettings curve[NUM_CURVES];	// response curves (EMG proportional, HANDle)
 
 	uint8_t waitForSerial = true;	// wait for serial connection before the programme runs
 	uint8_t motorEn = true;			// motor enable
 	uint8_t printInstr = true;		// print serial instructions
+	uint8_t classifierEn = false;	// select grips with the EMG classifier, rather than by holding OPEN
+	uint8_t trajectoryEn = false;	// move the fingers along trajectories (A8), rather than straight to each target
 
 	uint8_t init = false;			// if the EEPROM has been initialised for the first time
 } Settings;
@@ -93,7 +111,7 @@ void detectSerialConnection(void);	// initialise SerialUSB and wait for serial c
 void setHeadphoneJack(HeadphoneJackMode mode);			// configure headphone jack to I2C, ADC, Digital or SerialJack
 void printDeviceInfo(void);			// print board & firmware version, hand type and motor enabled/disabled
 
-void systemMonitor(void);			// monitor system status
+void systemMonitor(void);			// monitor system status (run every 1s by the scheduler)
 
 float readTemperature(void);		// read the device temperature, in C
 float readMinTemp(void);			// read the minimum temperature reached since power-on
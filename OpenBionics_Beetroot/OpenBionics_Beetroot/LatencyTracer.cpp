@@ -0,0 +1,124 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	LatencyTracer.cpp
+*
+*/
+
+#include "Globals.h"
+#include "LatencyTracer.h"
+
+LATENCY_TRACER Latency;
+
+////////////////////////////// Constructors/Destructors //////////////////////////////
+
+LATENCY_TRACER::LATENCY_TRACER()
+{
+	reset();
+}
+
+////////////////////////////// Public Methods //////////////////////////////
+
+// a grip command has been issued, for an activation detected in the EMG sample read at sampleTime (us)
+void LATENCY_TRACER::start(uint32_t sampleTime)
+{
+	_sampleTime = sampleTime;
+	_pending = true;
+}
+
+// the grip command has been written to the fingers, store the latency
+void LATENCY_TRACER::stop(void)
+{
+	if (!_pending)
+		return;
+
+	_pending = false;
+
+	_buff[_head] = micros() - _sampleTime;		// unsigned difference survives micros() overflow
+	_head = (_head + 1) % LATENCY_BUFF_SIZE;
+
+	if (_count < LATENCY_BUFF_SIZE)
+		_count++;
+
+	_total++;
+}
+
+// the grip command does not move the fingers, discard it
+void LATENCY_TRACER::cancel(void)
+{
+	_pending = false;
+}
+
+// clear all latency measurements
+void LATENCY_TRACER::reset(void)
+{
+	_head = 0;
+	_count = 0;
+	_total = 0;
+	_pending = false;
+	_sampleTime = 0;
+}
+
+// print the number of measurements and the latency percentiles
+void LATENCY_TRACER::printStatus(void)
+{
+	uint32_t sorted[LATENCY_BUFF_SIZE];
+	uint16_t n = _count;
+
+	MYSERIAL_PRINT_PGM("EMG latency (us), last ");
+	MYSERIAL_PRINT(n);
+	MYSERIAL_PRINT_PGM(" of ");
+	MYSERIAL_PRINTLN(_total);
+
+	if (!n)
+	{
+		MYSERIAL_PRINTLN_PGM("No muscle activations");
+		return;
+	}
+
+	// insertion sort, the buffer is small and this is only run on request
+	for (uint16_t i = 0; i < n; i++)
+	{
+		uint32_t val = _buff[i];
+		int j = i - 1;
+
+		while ((j >= 0) && (sorted[j] > val))
+		{
+			sorted[j + 1] = sorted[j];
+			j--;
+		}
+		sorted[j + 1] = val;
+	}
+
+	MYSERIAL_PRINT_PGM("Min\tp50\tp90\tp99\tMax\n");
+	MYSERIAL_PRINT(sorted[0]);
+	MYSERIAL_PRINT_PGM("\t");
+	MYSERIAL_PRINT(getPercentile(sorted, n, 50));
+	MYSERIAL_PRINT_PGM("\t");
+	MYSERIAL_PRINT(getPercentile(sorted, n, 90));
+	MYSERIAL_PRINT_PGM("\t");
+	MYSERIAL_PRINT(getPercentile(sorted, n, 99));
+	MYSERIAL_PRINT_PGM("\t");
+	MYSERIAL_PRINTLN(sorted[n - 1]);
+}
+
+////////////////////////////// Private Methods //////////////////////////////
+
+// get percentile p of the sorted measurements (nearest rank)
+uint32_t LATENCY_TRACER::getPercentile(const uint32_t *sorted, uint16_t n, uint8_t p)
+{
+	uint16_t rank = (((uint32_t)p * n) + 99) / 100;		// round up
+
+	if (rank < 1)
+		rank = 1;
+
+	return sorted[rank - 1];
+}
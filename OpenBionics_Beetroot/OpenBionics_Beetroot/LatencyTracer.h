@@ -0,0 +1,56 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	LatencyTracer.h
+*
+*/
+
+// EMG to actuation latency.
+// Each EMG sample is timestamped when it is read. When a muscle activation results in a grip command, the
+// timestamp of the sample that triggered the activation is passed to start(), and the next new position that is
+// written to a finger (by FingerCache, so after the trajectories when they are enabled) calls stop(). If the command
+// does not move any finger, Grip.run() calls cancel(). The most recent latencies are stored in a ring buffer, and the
+// percentiles are printed with the loop profiler (L).
+
+#ifndef LATENCY_TRACER_H_
+#define LATENCY_TRACER_H_
+
+#include <Arduino.h>
+
+#define LATENCY_BUFF_SIZE		128		// number of latency measurements to store
+
+class LATENCY_TRACER
+{
+	public:
+		LATENCY_TRACER();
+
+		void start(uint32_t sampleTime);	// a grip command has been issued, for an activation detected in the EMG sample read at sampleTime (us)
+		void stop(void);					// the grip command has been written to the fingers, store the latency
+		void cancel(void);					// the grip command does not move the fingers, discard it
+
+		void reset(void);					// clear all latency measurements
+		void printStatus(void);				// print the number of measurements and the latency percentiles
+
+	private:
+		uint32_t _buff[LATENCY_BUFF_SIZE];	// us, most recent latency measurements
+		uint16_t _head;						// location of the next measurement within _buff
+		uint16_t _count;					// number of measurements within _buff
+		uint32_t _total;					// number of measurements since reset
+
+		bool _pending;						// a command has been issued, but not yet written to the fingers
+		uint32_t _sampleTime;				// us, time the EMG sample of the pending command was read
+
+		uint32_t getPercentile(const uint32_t *sorted, uint16_t n, uint8_t p);	// get percentile p of the sorted measurements
+};
+
+extern LATENCY_TRACER Latency;
+
+#endif // LATENCY_TRACER_H_
@@ -20,58 +20,110 @@
 
 #include "Demo.h"							// DEMO
 #include "EMGControl.h"						// EMG
+#include "EventQueue.h"						// Events
 #include "Grips.h"							// Grip
 #include "HANDle.h"							// HANDle
+#include "IdleManager.h"					// Idle
 #include "Initialisation.h"					// settings, deviceSetup, systemMonitor 
+#include "ROS.h"							// ros_run
+#include "Profiler.h"						// Profiler
 #include "SerialControl.h"					// pollSerial
+#include "TaskScheduler.h"					// Scheduler
+#include "Trajectory.h"						// Trajectory
 #include "Watchdog.h"						// Watchdog
 
+// TASK PERIODS
+#define EMG_TASK_PER			1			// ms (1kHz)
+#define TRAJECTORY_TASK_PER		1			// ms
+#define DEMO_TASK_PER			1			// ms
+#define HANDLE_TASK_PER			10			// ms
+#define SERIAL_TASK_PER			1			// ms
+#define ROS_TASK_PER			1			// ms
+#define MONITOR_TASK_PER		1000		// ms
 
-void setup() 
+
+// run EMG mode, which only samples the muscles if EMG mode is enabled (or the muscles are being calibrated, or EMG is being streamed)
+void task_EMG(void)
 {
-	deviceSetup();							// initialise the board
+	EMG.run();
+}
 
-	if (settings.printInstr)
+// if the finger trajectories are enabled, move the setpoint of each finger
+void task_Trajectory(void)
+{
+	if (Trajectory.enabled())
 	{
-		delay(100);							// allow time for serial to connect
-		serial_SerialInstructions();		// print serial instructions
-	}	
+		Trajectory.run();
+	}
 }
 
-
-void loop() 
+// if demo mode is enabled, run demo mode
+void task_DEMO(void)
 {
-#if defined(USE_ROS)
-	ros_run();
-#endif
-
-	// monitor system temp
-	systemMonitor();
-
-	// if demo mode is enabled, run demo mode
 	if (DEMO.enabled())
 	{
 		DEMO.run();
 	}
+}
 
-	// if EMG mode is enabled, run EMG mode
-	if (EMG.enabled())
-	{
-		EMG.run();
-	}
-
-	// if HANDle mode is enabled, run HANDle mode
+// if HANDle mode is enabled, run HANDle mode
+void task_HANDle(void)
+{
 	if (HANDle.enabled())
 	{
 		HANDle.run();
 	}
+}
 
-	// process any received serial characters
-	pollSerial();
+// add each subsystem to the scheduler, with its period and priority
+void initTasks(void)
+{
+	Scheduler.add("EMG", task_EMG, EMG_TASK_PER, TASK_HIGH);					// control path, guaranteed rate
+	Scheduler.add("Trajectory", task_Trajectory, TRAJECTORY_TASK_PER, TASK_HIGH);		// finger setpoints, guaranteed rate
+	Scheduler.add("Demo", task_DEMO, DEMO_TASK_PER, TASK_NORMAL);
+	Scheduler.add("HANDle", task_HANDle, HANDLE_TASK_PER, TASK_NORMAL);
+	Scheduler.add("Serial", pollSerial, SERIAL_TASK_PER, TASK_NORMAL);			// process any received serial characters
+#if defined(USE_ROS)
+	Scheduler.add("ROS", ros_run, ROS_TASK_PER, TASK_NORMAL);
+#endif
+	Scheduler.add("Monitor", systemMonitor, MONITOR_TASK_PER, TASK_LOW);		// monitor system temp
+}
+
+
+void setup() 
+{
+	deviceSetup();							// initialise the board
+
+	initTasks();							// add the subsystems to the scheduler
+
+	if (settings.printInstr)
+	{
+		delay(100);							// allow time for serial to connect
+		serial_SerialInstructions();		// print serial instructions
+	}	
+
+	runEvents();							// handle the events queued during start up
+	Events.reset();							// and ignore any dropped while the board was initialising
+}
+
+
+void loop() 
+{
+	// handle the events posted from the 1ms interrupt (ERROR, LED)
+	runEvents();
+
+	// run the tasks that are due
+	Scheduler.run();
+
+	// count the loop frequency
+	Profiler.countLoop();
 
 #if defined(ARDUINO_ARCH_SAMD)
 	Watchdog.reset();
 #endif
+
+	// if there is nothing to do, sleep until the next interrupt
+	Idle.run();
 }
 
 
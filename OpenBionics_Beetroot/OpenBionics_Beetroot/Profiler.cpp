@@ -0,0 +1,244 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	Profiler.cpp
+*
+*/
+
+#include "Globals.h"
+#include "Profiler.h"
+#include "TimerManagement.h"
+
+PROFILER Profiler;
+
+////////////////////////////// Constructors/Destructors //////////////////////////////
+
+PROFILER::PROFILER()
+{
+	_numProbes = 0;
+
+	_numLoops = 0;
+	_busyTime = 0;
+	_resetTime = 0;
+}
+
+////////////////////////////// Public Methods //////////////////////////////
+
+// add a probe, returns the probe ID (-1 if there is no space)
+int PROFILER::add(const char *name, ProbeType type)
+{
+	if (_numProbes >= MAX_NUM_PROBES)
+	{
+		return (-1);
+	}
+
+	Probe *probe = &_probes[_numProbes];
+
+	probe->name = name;
+	probe->type = type;
+	probe->startTime = 0;
+
+	clearProbe(probe);
+
+	return _numProbes++;
+}
+
+// start a measurement
+void PROFILER::start(int id)
+{
+	if ((id < 0) || (id >= _numProbes))
+		return;
+
+	_probes[id].startTime = micros();
+}
+
+// end a measurement and add it to the probe statistics
+void PROFILER::stop(int id)
+{
+	if ((id < 0) || (id >= _numProbes))
+		return;
+
+	Probe *probe = &_probes[id];
+	uint32_t t = micros() - probe->startTime;		// unsigned difference survives micros() overflow
+
+	probe->count++;
+	probe->total += t;
+
+	if (t < probe->min)
+		probe->min = t;
+	if (t > probe->max)
+		probe->max = t;
+
+	probe->hist[getBucket(t)]++;
+
+	if (probe->type == PROBE_TASK)
+	{
+		_busyTime += t;
+	}
+}
+
+// count a pass of loop(), used to calculate the loop frequency
+void PROFILER::countLoop(void)
+{
+	_numLoops++;
+}
+
+// clear all statistics and restart the measurement period
+void PROFILER::reset(void)
+{
+	noInterrupts();				// prevent the ISR probes from being updated while they are cleared
+
+	for (int i = 0; i < _numProbes; i++)
+	{
+		clearProbe(&_probes[i]);
+	}
+
+	_numLoops = 0;
+	_busyTime = 0;
+	_resetTime = customMillis();
+
+	interrupts();
+}
+
+// print the statistics and histogram of each probe, the loop frequency and CPU load
+void PROFILER::printStatus(void)
+{
+	long elapsed = customMillis() - _resetTime;		// ms
+	uint64_t isrTime = 0;							// us
+
+	MYSERIAL_PRINTLN_PGM("Probe\t\tCount\tMin\tMean\tMax (us)");
+
+	for (int i = 0; i < _numProbes; i++)
+	{
+		Probe copy;
+		Probe *probe = &copy;
+
+		noInterrupts();				// an ISR probe may be updated while it is printed
+		copy = _probes[i];
+		interrupts();
+
+		if (probe->type == PROBE_ISR)
+		{
+			isrTime += probe->total;
+		}
+
+		MYSERIAL_PRINT(probe->name);
+		MYSERIAL_PRINT_PGM("\t");
+		if (strlen(probe->name) < 8)			// align columns for short probe names
+		{
+			MYSERIAL_PRINT_PGM("\t");
+		}
+		MYSERIAL_PRINT(probe->count);
+		MYSERIAL_PRINT_PGM("\t");
+
+		if (!probe->count)
+		{
+			MYSERIAL_PRINTLN_PGM("-\t-\t-");
+			continue;
+		}
+
+		MYSERIAL_PRINT(probe->min);
+		MYSERIAL_PRINT_PGM("\t");
+		MYSERIAL_PRINT((uint32_t)(probe->total / probe->count));
+		MYSERIAL_PRINT_PGM("\t");
+		MYSERIAL_PRINTLN(probe->max);
+
+		// only print the buckets that contain measurements
+		MYSERIAL_PRINT_PGM("  ");
+		for (uint8_t b = 0; b < NUM_PROFILE_BUCKETS; b++)
+		{
+			if (probe->hist[b])
+			{
+				MYSERIAL_PRINT_PGM(" ");
+				printBucketRange(b);
+				MYSERIAL_PRINT_PGM(":");
+				MYSERIAL_PRINT(probe->hist[b]);
+			}
+		}
+		MYSERIAL_PRINT_PGM("\n");
+	}
+
+	MYSERIAL_PRINT_PGM("\n");
+
+	if (elapsed <= 0)
+	{
+		MYSERIAL_PRINTLN_PGM("Loop:\t-");
+		return;
+	}
+
+	// print the loop frequency
+	MYSERIAL_PRINT_PGM("Loop:\t");
+	MYSERIAL_PRINT((uint32_t)(((uint64_t)_numLoops * 1000) / elapsed));
+	MYSERIAL_PRINTLN_PGM("Hz");
+
+	// print the percentage of time spent running tasks, the remainder is spent polling the scheduler
+	MYSERIAL_PRINT_PGM("Load:\t");
+	MYSERIAL_PRINT((float)_busyTime / (elapsed * 10.0));
+	MYSERIAL_PRINT_PGM("% (ISR ");
+	MYSERIAL_PRINT((float)isrTime / (elapsed * 10.0));
+	MYSERIAL_PRINTLN_PGM("%)");
+
+	// print the measurement period
+	MYSERIAL_PRINT_PGM("Period:\t");
+	printTime_ms(elapsed);
+	MYSERIAL_PRINT_PGM("\n");
+}
+
+////////////////////////////// Private Methods //////////////////////////////
+
+// clear the statistics of a single probe
+void PROFILER::clearProbe(Probe *probe)
+{
+	probe->count = 0;
+	probe->min = UINT32_MAX;
+	probe->max = 0;
+	probe->total = 0;
+
+	for (int b = 0; b < NUM_PROFILE_BUCKETS; b++)
+	{
+		probe->hist[b] = 0;
+	}
+}
+
+// get the histogram bucket of a measurement
+uint8_t PROFILER::getBucket(uint32_t t)
+{
+	uint8_t b = 0;
+
+	// count the number of bits needed to represent t
+	while (t && (b < (NUM_PROFILE_BUCKETS - 1)))
+	{
+		t >>= 1;
+		b++;
+	}
+
+	return b;
+}
+
+// print the range of a histogram bucket, in us
+void PROFILER::printBucketRange(uint8_t b)
+{
+	if (b <= 1)			// 0us or 1us
+	{
+		MYSERIAL_PRINT(b);
+	}
+	else if (b == (NUM_PROFILE_BUCKETS - 1))
+	{
+		MYSERIAL_PRINT((uint32_t)1 << (b - 1));
+		MYSERIAL_PRINT_PGM("+");
+	}
+	else
+	{
+		MYSERIAL_PRINT((uint32_t)1 << (b - 1));
+		MYSERIAL_PRINT_PGM("-");
+		MYSERIAL_PRINT(((uint32_t)1 << b) - 1);
+	}
+}
@@ -0,0 +1,80 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	Profiler.h
+*
+*/
+
+// Execution time profiler, using micros().
+// A probe is added for each scheduler task, each function deferred from the 1ms timer interrupt (ERROR, LED) and the
+// EMG ADC scan made within the interrupt (PROBE_ISR, printed as the ISR load). Every measurement updates the
+// min/mean/max of the probe and a histogram with log2 sized buckets (bucket 0 is 0us, bucket n is 2^(n-1) to
+// 2^n - 1 us), so that occasional long runs are visible without storing every sample.
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <Arduino.h>
+
+#define MAX_NUM_PROBES			12		// maximum number of probes that can be added
+#define NUM_PROFILE_BUCKETS		16		// number of histogram buckets, the last bucket holds everything >= 16384us
+
+typedef enum _ProbeType
+{
+	PROBE_TASK = 0,		// run from loop(), counted towards the CPU load
+	PROBE_ISR			// run from an interrupt, may pre-empt a task
+} ProbeType;
+
+typedef struct _Probe
+{
+	const char *name;				// name of probe, used for diagnostics
+	ProbeType type;					// TASK, ISR
+
+	uint32_t startTime;				// us, time of the last call to start()
+
+	uint32_t count;					// number of measurements
+	uint32_t min;					// us
+	uint32_t max;					// us
+	uint64_t total;					// us, used to calculate the mean
+
+	uint32_t hist[NUM_PROFILE_BUCKETS];	// number of measurements within each log2 bucket
+} Probe;
+
+class PROFILER
+{
+	public:
+		PROFILER();
+
+		int add(const char *name, ProbeType type = PROBE_TASK);	// add a probe, returns the probe ID (-1 if there is no space)
+
+		void start(int id);					// start a measurement
+		void stop(int id);					// end a measurement and add it to the probe statistics
+		void countLoop(void);				// count a pass of loop(), used to calculate the loop frequency
+
+		void reset(void);					// clear all statistics and restart the measurement period
+		void printStatus(void);				// print the statistics and histogram of each probe, the loop frequency and CPU load
+
+	private:
+		Probe _probes[MAX_NUM_PROBES];		// list of probes
+		uint8_t _numProbes;					// number of probes added
+
+		uint32_t _numLoops;					// number of passes of loop() since reset
+		uint64_t _busyTime;					// us, time spent in PROBE_TASK probes since reset
+		long _resetTime;					// ms, time of the last reset (customMillis() is used as micros() overflows after ~70 mins)
+
+		void clearProbe(Probe *probe);		// clear the statistics of a single probe
+		uint8_t getBucket(uint32_t t);		// get the histogram bucket of a measurement
+		void printBucketRange(uint8_t b);	// print the range of a histogram bucket, in us
+};
+
+extern PROFILER Profiler;
+
+#endif // PROFILER_H_
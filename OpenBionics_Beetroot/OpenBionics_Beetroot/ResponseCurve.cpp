@@ -0,0 +1,152 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	ResponseCurve.cpp
+*
+*/
+
+#include <math.h>
+
+#include "Globals.h"
+#include "ResponseCurve.h"
+
+RESPONSE_CURVE Curve[NUM_CURVES];
+
+////////////////////////////// Constructors/Destructors //////////////////////////////
+
+RESPONSE_CURVE::RESPONSE_CURVE()
+{
+	_settings = NULL;
+	_inMax = 1;
+	_inScale = 0;
+	_gain = 0;
+
+	for (int i = 0; i <= CURVE_LUT_SIZE; i++)
+	{
+		_lut[i] = 0;
+	}
+}
+
+////////////////////////////// Public Methods //////////////////////////////
+
+// attach the curve settings, for inputs from -inMax to inMax
+void RESPONSE_CURVE::begin(uint16_t inMax, const CurveSettings *settings)
+{
+	_inMax = inMax ? inMax : 1;
+	_inScale = ((uint32_t)CURVE_ONE << 16) / _inMax;
+	_settings = settings;
+
+	update();
+}
+
+// rebuild the table from the curve settings
+void RESPONSE_CURVE::update(void)
+{
+	if (!_settings)
+		return;
+
+	for (int i = 0; i <= CURVE_LUT_SIZE; i++)
+	{
+		float y = shapeAt((float)i / CURVE_LUT_SIZE);
+
+		_lut[i] = (uint16_t)((constrain(y, 0, 1) * CURVE_ONE) + 0.5f);
+	}
+
+	_gain = ((uint32_t)_settings->gain << CURVE_FRAC_BITS) / 100;
+}
+
+// Q16.16, output of the curve for 'input'
+int32_t RESPONSE_CURVE::calc(int input)
+{
+	bool neg = (input < 0);
+	uint32_t x = neg ? -input : input;
+
+	if (x > _inMax)
+		x = _inMax;
+
+	// normalise the input to Q15, then split into a table segment and the position within the segment
+	uint32_t u = (x * _inScale) >> 16;
+	uint32_t i = u >> CURVE_SEG_BITS;
+	uint32_t frac = u & ((1 << CURVE_SEG_BITS) - 1);
+	int32_t y;
+
+	if (i >= CURVE_LUT_SIZE)
+	{
+		y = _lut[CURVE_LUT_SIZE];
+	}
+	else
+	{
+		y = _lut[i] + ((((int32_t)_lut[i + 1] - _lut[i]) * (int32_t)frac) >> CURVE_SEG_BITS);
+	}
+
+	int32_t out = (int32_t)(((uint64_t)y * _gain) >> 15);
+
+	return (neg ? -out : out);
+}
+
+// print the curve settings and a few points of the curve
+void RESPONSE_CURVE::print(void)
+{
+	if (!_settings)
+		return;
+
+	MYSERIAL_PRINT(getShapeName(_settings->shape));
+	MYSERIAL_PRINT_PGM("  \tpower ");
+	MYSERIAL_PRINT(_settings->power / 10.0f);
+	MYSERIAL_PRINT_PGM("  \tdead zone ");
+	MYSERIAL_PRINT(_settings->deadZone);
+	MYSERIAL_PRINT_PGM("%  \tgain ");
+	MYSERIAL_PRINTLN(_settings->gain / 100.0f);
+
+	// output at 0%, 25%, 50%, 75% & 100% of the input range
+	MYSERIAL_PRINT_PGM("Output:");
+	for (int p = 0; p <= 4; p++)
+	{
+		MYSERIAL_PRINT_PGM("  ");
+		MYSERIAL_PRINT((float)calc(((uint32_t)_inMax * p) / 4) / (1UL << CURVE_FRAC_BITS));
+	}
+	MYSERIAL_PRINT_PGM("\n");
+}
+
+// get the name of a curve shape
+const char *RESPONSE_CURVE::getShapeName(uint8_t shape)
+{
+	const char *shapeNames[NUM_CURVE_SHAPES] = { "Linear","Expo","S-curve","Dead zone" };
+
+	return ((shape < NUM_CURVE_SHAPES) ? shapeNames[shape] : "Unknown");
+}
+
+////////////////////////////// Private Methods //////////////////////////////
+
+// evaluate the shape of the curve at x (0 - 1)
+float RESPONSE_CURVE::shapeAt(float x)
+{
+	float power = (_settings->power ? _settings->power : 10) / 10.0f;
+	float dz = constrain(_settings->deadZone, 0, CURVE_DEAD_ZONE_MAX) / 100.0f;
+
+	switch (_settings->shape)
+	{
+	case CURVE_EXPO:
+		return pow(x, power);
+	case CURVE_S:
+	{
+		float a = pow(x, power);
+		float b = pow(1 - x, power);
+
+		return ((a + b) > 0) ? (a / (a + b)) : 0;
+	}
+	case CURVE_DEAD_ZONE:
+		return (x <= dz) ? 0 : ((x - dz) / (1 - dz));
+	case CURVE_LINEAR:
+	default:
+		return x;
+	}
+}
@@ -0,0 +1,89 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	ResponseCurve.h
+*
+*/
+
+// Fixed-point response curves, used to map an input (EMG signal, joystick) to a change in grip position.
+// The shape of the curve is sampled into a table of (CURVE_LUT_SIZE + 1) Q15 values when the curve settings are
+// changed, which is the only time any floating point maths is used. calc() then only needs a multiply and a shift
+// to normalise the input, a linear interpolation between two table entries, and a multiply to scale the output,
+// as the Cortex-M0+ has no FPU (each pow() took several thousand cycles).
+//
+// Curves are odd symmetric, a negative input gives a negative output of the same magnitude.
+
+#ifndef RESPONSE_CURVE_H_
+#define RESPONSE_CURVE_H_
+
+#include <Arduino.h>
+
+#define CURVE_LUT_BITS		5							// log2 of the number of table segments
+#define CURVE_LUT_SIZE		(1 << CURVE_LUT_BITS)		// number of table segments
+#define CURVE_ONE			(1 << 15)					// 1.0 in Q15
+#define CURVE_SEG_BITS		(15 - CURVE_LUT_BITS)		// number of interpolation bits within a segment
+#define CURVE_FRAC_BITS		16							// output is Q16.16
+
+#define CURVE_POWER_MAX		100							// max exponent, x10
+#define CURVE_DEAD_ZONE_MAX	90							// max dead zone, %
+#define CURVE_GAIN_MAX		10000						// max gain, x100
+
+typedef enum _CurveShape
+{
+	CURVE_LINEAR = 0,		// y = x
+	CURVE_EXPO,				// y = x^power
+	CURVE_S,				// y = x^power / (x^power + (1 - x)^power)
+	CURVE_DEAD_ZONE,		// y = 0 within the dead zone, then linear
+	NUM_CURVE_SHAPES
+} CurveShape;
+
+typedef enum _CurveID
+{
+	CURVE_EMG = 0,			// EMG proportional control
+	CURVE_HANDLE,			// HANDle joystick
+	NUM_CURVES
+} CurveID;
+
+typedef struct _CurveSettings
+{
+	uint8_t shape;			// CurveShape
+	uint8_t power;			// x10, exponent of the EXPO and S shapes (20 = x^2)
+	uint8_t deadZone;		// %, proportion of the input range with no output (DEAD_ZONE shape)
+	uint16_t gain;			// x100, output at full input (400 = 4.00)
+} CurveSettings;
+
+class RESPONSE_CURVE
+{
+	public:
+		RESPONSE_CURVE();
+
+		void begin(uint16_t inMax, const CurveSettings *settings);	// attach the curve settings, for inputs from -inMax to inMax
+		void update(void);						// rebuild the table from the curve settings
+
+		int32_t calc(int input);				// Q16.16, output of the curve for 'input'
+
+		void print(void);						// print the curve settings and a few points of the curve
+
+		static const char *getShapeName(uint8_t shape);		// get the name of a curve shape
+
+	private:
+		const CurveSettings *_settings;			// curve settings
+		uint16_t _inMax;						// max input
+		uint32_t _inScale;						// Q16, scales an input from 0 - _inMax to 0 - CURVE_ONE
+		uint32_t _gain;							// Q16.16, output at full input
+		uint16_t _lut[CURVE_LUT_SIZE + 1];		// Q15, curve sampled at each segment boundary
+
+		float shapeAt(float x);					// evaluate the shape of the curve at x (0 - 1)
+};
+
+extern RESPONSE_CURVE Curve[NUM_CURVES];
+
+#endif // RESPONSE_CURVE_H_
@@ -17,12 +17,26 @@
 #include "SerialControl.h"
 
 #include "Demo.h"					// DEMO
+#include "EMGADC.h"					// EMGADC
+#include "EMGCalibration.h"			// EMGCal
+#include "EMGClassifier.h"			// Classifier
 #include "EMGControl.h"				// EMG
+#include "EMGGesture.h"				// EMGGesture
+#include "EMGStream.h"				// EMGStream
+#include "EventQueue.h"				// Events
 #include "ErrorHandling.h"			// ERROR
+#include "FingerCache.h"			// FingerCache
 #include "Grips.h"					// NUM_GRIPS
 #include "HANDle.h"					// HANDle
 #include "I2C_IMU_LSM9DS1.h"		// IMU
+#include "IdleManager.h"			// Idle
 #include "Initialisation.h"			// settings
+#include "LatencyTracer.h"			// Latency
+#include "Profiler.h"				// Profiler
+#include "ResponseCurve.h"			// Curve
+#include "TaskScheduler.h"			// Scheduler
+#include "Trace.h"					// Trace
+#include "Trajectory.h"				// Trajectory
 
 SerialCode serialCodes[NUM_SERIAL_CODES];
 
@@ -45,6 +59,10 @@ void initSerialCharCodes(void)
 	serialCodes[SERIAL_CODE_A].limit = NUM_ADV_SETTINGS;
 	serialCodes[SERIAL_CODE_A].func = serial_AdvancedSettings;
 
+	serialCodes[SERIAL_CODE_B].code = 'B';		// EMG grip classifier
+	serialCodes[SERIAL_CODE_B].limit = 3;		// off, on, view, upload
+	serialCodes[SERIAL_CODE_B].func = serial_Classifier;
+
 	serialCodes[SERIAL_CODE_C].code = 'C';		// Close
 	serialCodes[SERIAL_CODE_C].limit = LIMIT_FOR_BOOLEAN;
 	// no attached func as C is a modifier
@@ -53,6 +71,10 @@ void initSerialCharCodes(void)
 	serialCodes[SERIAL_CODE_D].limit = LIMIT_FOR_BOOLEAN;
 	serialCodes[SERIAL_CODE_D].func = serial_ToggleDemoMode;
 
+	serialCodes[SERIAL_CODE_E].code = 'E';		// EMG calibration
+	serialCodes[SERIAL_CODE_E].limit = 2;		// cancel, start, view
+	serialCodes[SERIAL_CODE_E].func = serial_Calibration;
+
 	serialCodes[SERIAL_CODE_F].code = 'F';		// Finger number
 	serialCodes[SERIAL_CODE_F].limit = NUM_FINGERS;
 	serialCodes[SERIAL_CODE_F].func = serial_FingerControl;
@@ -65,10 +87,26 @@ void initSerialCharCodes(void)
 	serialCodes[SERIAL_CODE_H].limit = NUM_HAND_TYPES;
 	serialCodes[SERIAL_CODE_H].func = serial_SetHandType;
 
+	serialCodes[SERIAL_CODE_J].code = 'J';		// EMG gesture
+	serialCodes[SERIAL_CODE_J].limit = NUM_GESTURES - 1;
+	serialCodes[SERIAL_CODE_J].func = serial_Gesture;
+
+	serialCodes[SERIAL_CODE_K].code = 'K';		// EMG onset detector
+	serialCodes[SERIAL_CODE_K].limit = NUM_EMG_CHANNELS - 1;
+	serialCodes[SERIAL_CODE_K].func = serial_OnsetDetector;
+
+	serialCodes[SERIAL_CODE_L].code = 'L';		// Loop profiler
+	serialCodes[SERIAL_CODE_L].limit = LIMIT_FOR_BOOLEAN;
+	serialCodes[SERIAL_CODE_L].func = serial_LoopProfiler;
+
 	serialCodes[SERIAL_CODE_M].code = 'M';		// EMG mode
 	serialCodes[SERIAL_CODE_M].limit = NUM_EMG_MODES;
 	serialCodes[SERIAL_CODE_M].func = serial_MuscleControlMode;
 
+	serialCodes[SERIAL_CODE_N].code = 'N';		// EMG gesture action
+	serialCodes[SERIAL_CODE_N].limit = NUM_GESTURE_ACTIONS - 1;
+	// no attached func as N is a modifier
+
 	serialCodes[SERIAL_CODE_O].code = 'O';		// Open
 	serialCodes[SERIAL_CODE_O].limit = LIMIT_FOR_BOOLEAN;
 	// no attached func as O is a modifier
@@ -77,6 +115,10 @@ void initSerialCharCodes(void)
 	serialCodes[SERIAL_CODE_P].limit = 100;		// 0 - 100
 	// no attached func as P is a modifier
 
+	serialCodes[SERIAL_CODE_Q].code = 'Q';		// Response curve
+	serialCodes[SERIAL_CODE_Q].limit = NUM_CURVES - 1;
+	serialCodes[SERIAL_CODE_Q].func = serial_ResponseCurve;
+
 	serialCodes[SERIAL_CODE_R].code = 'R';		// Reset to defaults
 	serialCodes[SERIAL_CODE_R].limit = LIMIT_FOR_BOOLEAN;
 	serialCodes[SERIAL_CODE_R].func = serial_ResetToDefaults;
@@ -93,10 +135,26 @@ void initSerialCharCodes(void)
 	serialCodes[SERIAL_CODE_U].limit = 1024;	// max 10-bit value
 	serialCodes[SERIAL_CODE_U].func = serial_PeakThresh;
 
+	serialCodes[SERIAL_CODE_V].code = 'V';		// Response curve gain
+	serialCodes[SERIAL_CODE_V].limit = CURVE_GAIN_MAX;
+	// no attached func as V is a modifier
+
+	serialCodes[SERIAL_CODE_W].code = 'W';		// Response curve shape
+	serialCodes[SERIAL_CODE_W].limit = NUM_CURVE_SHAPES - 1;
+	// no attached func as W is a modifier
+
 	serialCodes[SERIAL_CODE_X].code = 'X';		// Exit mode
 	serialCodes[SERIAL_CODE_X].limit = LIMIT_FOR_BOOLEAN;
 	serialCodes[SERIAL_CODE_X].func = serial_ExitMode;
 
+	serialCodes[SERIAL_CODE_Y].code = 'Y';		// Response curve exponent
+	serialCodes[SERIAL_CODE_Y].limit = CURVE_POWER_MAX;
+	// no attached func as Y is a modifier
+
+	serialCodes[SERIAL_CODE_Z].code = 'Z';		// Response curve dead zone
+	serialCodes[SERIAL_CODE_Z].limit = CURVE_DEAD_ZONE_MAX;
+	// no attached func as Z is a modifier
+
 	serialCodes[SERIAL_CODE_HASH].code = '#';	// Print system diagnostics
 	serialCodes[SERIAL_CODE_HASH].limit = LIMIT_FOR_BOOLEAN;
 	serialCodes[SERIAL_CODE_HASH].func = serial_systemDiagnostics;
@@ -110,20 +168,24 @@ void initSerialCharCodes(void)
 // check and read serial, then perform appropriate actions
 void pollSerial(void)
 {
-	// read and store serial chars, return true if end of line char is received
-	if (checkSerial())
+	// drain all received chars, so that the serial rate does not depend on how often pollSerial() is called
+	while (MYSERIAL_AVAILABLE())
 	{
-		// if the current mode is not CSV mode
-		if (settings.mode != MODE_CSV)
+		// read and store serial chars, return true if end of line char is received
+		if (checkSerial())
 		{
-			// print received serial string
-			MYSERIAL_PRINT_PGM("\n");
-			MYSERIAL_PRINTLN(serialBuff);
-		}
+			// if the current mode is not CSV mode
+			if (settings.mode != MODE_CSV)
+			{
+				// print received serial string
+				MYSERIAL_PRINT_PGM("\n");
+				MYSERIAL_PRINTLN(serialBuff);
+			}
 
-		extractCodesFromSerial();		// extract char codes from serialBuff and store values in serialCodes[]
+			extractCodesFromSerial();		// extract char codes from serialBuff and store values in serialCodes[]
 
-		processCodes();					// use the extracted codes & values to control the hand
+			processCodes();					// use the extracted codes & values to control the hand
+		}
 	}
 }
 
@@ -137,6 +199,8 @@ bool checkSerial(void)
 	{
 		char rxChar = MYSERIAL.read();		// store char in temporary variable
 
+		Trace.record(TRACE_SERIAL, (uint8_t*)&rxChar, 1);		// record the char, if trace recording is enabled
+
 		// if the received char is an end of line character, reset buffer index and return true to indicate the message is ready to read
 		if ((rxChar == SERIAL_EOL_CHAR_NL) || (rxChar == SERIAL_EOL_CHAR_CR))
 		{
@@ -190,6 +254,7 @@ bool isValidChar(char rxChar)
 	if ((rxChar == ASCII_SPACE) || 
 		(rxChar == ASCII_HASH)	||
 		(rxChar == ASCII_COMMA) ||
+		(rxChar == ASCII_MINUS) ||
 		(rxChar == ASCII_QMARK) ||
 		IS_BETWEEN(rxChar, ASCII_0, ASCII_9) || 
 		IS_BETWEEN(rxChar, ASCII_A, ASCII_z))
@@ -225,6 +290,11 @@ void extractCodesFromSerial(void)
 	{
 		receiveCSV(serialBuff);		// check whether buffer contains CSV string
 	}
+	// if no char code was detected and a classifier model is being uploaded
+	else if (!detected && Classifier.uploading())
+	{
+		Classifier.receive(serialBuff);		// receive the model values
+	}
 
 	serialBuff[0] = NULL;			// clear serial buff once all codes have been looked for
 }
@@ -324,6 +394,7 @@ void serial_AdvancedSettings(int setting)
 		}
 		else
 		{
+			EMG.off();						// EMG does not control the hand in other modes
 			settings.mode = MODE_DEMO;
 			DEMO.constant();
 		}
@@ -373,6 +444,7 @@ void serial_AdvancedSettings(int setting)
 		}
 		else 
 		{
+			EMG.off();
 			settings.mode = MODE_CSV;
 			MYSERIAL_PRINTLN(disabled_enabled[1]);
 		}
@@ -389,6 +461,7 @@ void serial_AdvancedSettings(int setting)
 		}
 		else
 		{
+			EMG.off();
 			settings.mode = MODE_HANDLE;
 			HANDle.enable();
 			MYSERIAL_PRINTLN(off_on[ON]);
@@ -401,6 +474,35 @@ void serial_AdvancedSettings(int setting)
 		sendCSV();
 		break;
 
+	case 7:			// start/stop binary trace recording
+		MYSERIAL_PRINT_PGM("Trace recording ");
+		if (Trace.recording())
+		{
+			Trace.stop();
+			MYSERIAL_PRINTLN(off_on[OFF]);
+			MYSERIAL_PRINT(Trace.getNumRecords());
+			MYSERIAL_PRINTLN_PGM(" records");
+		}
+		else
+		{
+			MYSERIAL_PRINTLN(off_on[ON]);
+			Trace.start();
+		}
+		break;
+
+	case 8:			// enable/disable finger trajectories
+		settings.trajectoryEn = !settings.trajectoryEn;
+		storeSettings();
+
+		if (settings.trajectoryEn)
+			Trajectory.enable();
+		else
+			Trajectory.disable();
+
+		MYSERIAL_PRINT_PGM("Finger trajectories ");
+		MYSERIAL_PRINTLN(disabled_enabled[settings.trajectoryEn]);
+		break;
+
 	default:
 		MYSERIAL_PRINTLN_PGM("Advanced Setting Not Valid");
 		break;
@@ -614,6 +716,23 @@ void serial_MuscleControlMode(int mMode)
 		MYSERIAL_PRINT_PGM("Print ADC vals ");
 		MYSERIAL_PRINTLN(disabled_enabled[EMG.toggleADCVals()]);
 		break;
+	case 4:			// start/stop binary streaming of every EMG sample
+		MYSERIAL_PRINT_PGM("Binary stream ");
+		if (EMGStream.streaming())
+		{
+			EMGStream.stop();
+			MYSERIAL_PRINTLN(disabled_enabled[false]);
+			MYSERIAL_PRINT(EMGStream.getNumFrames());
+			MYSERIAL_PRINT_PGM(" frames, ");
+			MYSERIAL_PRINT(EMGStream.getNumDropped());
+			MYSERIAL_PRINTLN_PGM(" dropped");
+		}
+		else
+		{
+			MYSERIAL_PRINTLN(disabled_enabled[true]);
+			EMGStream.start();
+		}
+		break;
 	default:
 		MYSERIAL_PRINTLN_PGM("Not Valid");
 		break;
@@ -634,17 +753,218 @@ void serial_HoldTime(int hTime)
 	MYSERIAL_PRINTLN_PGM("ms");
 }
 
-// muscle peak threshold
+// muscle peak threshold, of every channel
 void serial_PeakThresh(int pThresh)
 {
 	if (pThresh != BLANK)
 	{
-		settings.emg.peakThresh = (uint16_t)pThresh;
+		for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+		{
+			settings.emg.channel[c].peakThresh = (uint16_t)pThresh;
+		}
+		settings.emg.calibrated = false;		// set by hand
 		storeSettings();
+
+		EMG.updateThresholds();
 	}
 	
 	MYSERIAL_PRINT_PGM("Peak threshold - ");
-	MYSERIAL_PRINTLN(settings.emg.peakThresh);
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		if (c > 0)
+		{
+			MYSERIAL_PRINT_PGM(", ");
+		}
+		MYSERIAL_PRINT(settings.emg.channel[c].peakThresh);
+	}
+	MYSERIAL_PRINT_PGM("\n");
+}
+
+// view/toggle the onset detector of each channel
+void serial_OnsetDetector(int ch)
+{
+	const char *detectorNames[2] = { "Threshold","Onset" };
+
+	// toggle the channel between the PEAK threshold and the onset detector
+	if (ch != BLANK)
+	{
+		EMGDetector detector = (EMG.getDetector(ch) == EMG_DETECT_ONSET) ? EMG_DETECT_THRESHOLD : EMG_DETECT_ONSET;
+
+		if (detector == EMG_DETECT_ONSET)
+			settings.emg.onset |= (1 << ch);
+		else
+			settings.emg.onset &= ~(1 << ch);
+		storeSettings();
+
+		EMG.setDetector(ch, detector);
+	}
+
+	MYSERIAL_PRINT_PGM("Detector - ");
+	for (int c = 0; c < NUM_EMG_CHANNELS; c++)
+	{
+		if (c > 0)
+		{
+			MYSERIAL_PRINT_PGM(", ");
+		}
+		MYSERIAL_PRINT(detectorNames[EMG.getDetector(c)]);
+	}
+	MYSERIAL_PRINT_PGM("\n");
+}
+
+// view/map the action of each EMG gesture
+void serial_Gesture(int gNum)
+{
+	// if no gesture is specified, print all gestures
+	if (gNum == BLANK)
+	{
+		for (int g = 0; g < NUM_GESTURES; g++)
+		{
+			serial_Gesture(g);
+		}
+		return;
+	}
+
+	// the modifier is constrained here, as it is processed after J
+	if (serialCodes[SERIAL_CODE_N].newVal)
+	{
+		if (serialCodes[SERIAL_CODE_N].val != BLANK)
+		{
+			settings.gesture.action[gNum] = constrain(serialCodes[SERIAL_CODE_N].val, 0, NUM_GESTURE_ACTIONS - 1);
+
+			// the favourite is the grip selected when the gesture is mapped
+			if (settings.gesture.action[gNum] == GESTURE_ACTION_FAVOURITE)
+				settings.gesture.favouriteGrip = Grip.getGrip();
+
+			storeSettings();
+		}
+		serialCodes[SERIAL_CODE_N].newVal = false;
+	}
+
+	MYSERIAL_PRINT_PGM("Gesture ");
+	MYSERIAL_PRINT(gNum);
+	MYSERIAL_PRINT_PGM(" ");
+	MYSERIAL_PRINT(EMGGesture.getName((Gesture)gNum));
+	MYSERIAL_PRINT_PGM(" - ");
+	MYSERIAL_PRINT(EMGGesture.getActionName((GestureAction)settings.gesture.action[gNum]));
+	if (settings.gesture.action[gNum] == GESTURE_ACTION_FAVOURITE)
+	{
+		MYSERIAL_PRINT_PGM(" (");
+		MYSERIAL_PRINT(Grip.getGripName(settings.gesture.favouriteGrip));
+		MYSERIAL_PRINT_PGM(")");
+	}
+	MYSERIAL_PRINT_PGM("\n");
+}
+
+// view/configure a response curve
+void serial_ResponseCurve(int cNum)
+{
+	const char *curveNames[NUM_CURVES] = { "EMG","HANDle" };
+
+	// if no curve is specified, print all curves
+	if (cNum == BLANK)
+	{
+		for (int c = 0; c < NUM_CURVES; c++)
+		{
+			serial_ResponseCurve(c);
+		}
+		return;
+	}
+
+	CurveSettings *curve = &settings.curve[cNum];
+	bool changed = false;
+
+	// the modifiers are constrained here, as they are processed after Q
+	if (serialCodes[SERIAL_CODE_W].newVal)
+	{
+		if (serialCodes[SERIAL_CODE_W].val != BLANK)
+		{
+			curve->shape = constrain(serialCodes[SERIAL_CODE_W].val, 0, NUM_CURVE_SHAPES - 1);
+			changed = true;
+		}
+		serialCodes[SERIAL_CODE_W].newVal = false;
+	}
+	if (serialCodes[SERIAL_CODE_Y].newVal)
+	{
+		if (serialCodes[SERIAL_CODE_Y].val != BLANK)
+		{
+			curve->power = constrain(serialCodes[SERIAL_CODE_Y].val, 1, CURVE_POWER_MAX);
+			changed = true;
+		}
+		serialCodes[SERIAL_CODE_Y].newVal = false;
+	}
+	if (serialCodes[SERIAL_CODE_Z].newVal)
+	{
+		if (serialCodes[SERIAL_CODE_Z].val != BLANK)
+		{
+			curve->deadZone = constrain(serialCodes[SERIAL_CODE_Z].val, 0, CURVE_DEAD_ZONE_MAX);
+			changed = true;
+		}
+		serialCodes[SERIAL_CODE_Z].newVal = false;
+	}
+	if (serialCodes[SERIAL_CODE_V].newVal)
+	{
+		if (serialCodes[SERIAL_CODE_V].val != BLANK)
+		{
+			curve->gain = constrain(serialCodes[SERIAL_CODE_V].val, 0, CURVE_GAIN_MAX);
+			changed = true;
+		}
+		serialCodes[SERIAL_CODE_V].newVal = false;
+	}
+
+	if (changed)
+	{
+		Curve[cNum].update();		// rebuild the table
+		storeSettings();
+	}
+
+	MYSERIAL_PRINT(curveNames[cNum]);
+	MYSERIAL_PRINT_PGM(" response curve - ");
+	Curve[cNum].print();
+}
+
+// view/enable/upload the EMG grip classifier
+void serial_Classifier(int val)
+{
+	const char *disabled_enabled[2] = { "DISABLED","ENABLED" };
+
+	switch (val)
+	{
+	case 0:			// select grips by holding OPEN
+	case 1:			// select grips with the classifier
+		settings.classifierEn = val;
+		storeSettings();
+
+		MYSERIAL_PRINT_PGM("Classifier grip selection ");
+		MYSERIAL_PRINTLN(disabled_enabled[settings.classifierEn]);
+		break;
+	case 3:			// receive a new model
+		Classifier.startUpload();
+		break;
+	case 2:
+	default:		// view the model
+		MYSERIAL_PRINT_PGM("Classifier grip selection ");
+		MYSERIAL_PRINTLN(disabled_enabled[settings.classifierEn]);
+		Classifier.printStatus();
+		break;
+	}
+}
+
+// start/cancel/view the EMG calibration
+void serial_Calibration(int val)
+{
+	switch (val)
+	{
+	case 0:			// cancel, and keep the previous settings
+		EMGCal.cancel();
+		break;
+	case 1:			// start a guided calibration
+		EMGCal.start();
+		break;
+	case 2:
+	default:		// view the threshold, hysteresis & gain of each channel
+		EMGCal.printSettings();
+		break;
+	}
 }
 
 // reset to defaults
@@ -709,9 +1029,49 @@ void serial_systemDiagnostics(int val)
 	// print whether motors are enabled/disabled
 	MYSERIAL_PRINT_PGM("Motors:\t");
 	MYSERIAL_PRINTLN(disabled_enabled[settings.motorEn]);
+
+	// print the scheduler task rates and overruns
+	MYSERIAL_PRINT_PGM("\n");
+	Scheduler.printStatus();
+
+	// print the deferred event queue depth and dropped events
+	Events.printStatus();
 }
 
 
+// print/reset the loop profiler and EMG latency
+void serial_LoopProfiler(int val)
+{
+	if (val == 1)
+	{
+		Profiler.reset();
+		Latency.reset();
+		Events.reset();
+		Idle.reset();
+		FingerCache.reset();
+		EMGADC.reset();
+		MYSERIAL_PRINTLN_PGM("Loop profiler reset");
+		return;
+	}
+
+	MYSERIAL_PRINTLN_PGM("     Loop Profiler");
+	for (uint8_t i = 0; i < 28; i++)
+	{
+		MYSERIAL_PRINT_PGM("_");
+	}
+	MYSERIAL_PRINT_PGM("\n\n");
+
+	Profiler.printStatus();
+	Idle.printStatus();
+	Events.printStatus();
+	FingerCache.printStatus();
+	EMGADC.printStatus();
+
+	// print the EMG to actuation latency percentiles
+	MYSERIAL_PRINT_PGM("\n");
+	Latency.printStatus();
+}
+
 // serial instructions
 void serial_SerialInstructions(int val)
 {
@@ -759,11 +1119,53 @@ void serial_SerialInstructions(int val)
 	MYSERIAL_PRINTLN_PGM("M1          Standard muscle control ON");
 	MYSERIAL_PRINTLN_PGM("M2          Muscle position control ON");
 	MYSERIAL_PRINTLN_PGM("M3          Toggle whether to display SIMPLE muscle readings");
-	MYSERIAL_PRINTLN_PGM("M4          Toggle whether to display DETAILED muscle readings");
+	MYSERIAL_PRINTLN_PGM("M4          Start/Stop binary streaming of every muscle sample (full rate)");
+	MYSERIAL_PRINT_PGM("\n");
+
+	// EMG CALIBRATION
+	MYSERIAL_PRINTLN_PGM("EMG Calibration (E#, U#, T#, K#)");
+	MYSERIAL_PRINTLN_PGM("Command     Description");
+	MYSERIAL_PRINTLN_PGM("E           View the threshold, hysteresis & gain of each channel");
+	MYSERIAL_PRINTLN_PGM("E1          Start a guided calibration of each muscle (~32s)");
+	MYSERIAL_PRINTLN_PGM("E0          Cancel the calibration, and keep the previous settings");
+	MYSERIAL_PRINTLN_PGM("U600        Set the peak threshold of every channel by hand (U0 - U1024)");
+	MYSERIAL_PRINTLN_PGM("T300        Set the hold time to 300ms (T0 - T5000)");
+	MYSERIAL_PRINTLN_PGM("K           View the detector of each channel (threshold or adaptive onset)");
+	MYSERIAL_PRINTLN_PGM("K#          Toggle channel # between the peak threshold and the adaptive onset detector");
+	MYSERIAL_PRINT_PGM("\n");
+
+	// EMG GESTURES
+	MYSERIAL_PRINTLN_PGM("EMG Gestures (J#, N#)");
+	MYSERIAL_PRINTLN_PGM("Command     Description");
+	MYSERIAL_PRINTLN_PGM("J           View the action of each gesture");
+	MYSERIAL_PRINTLN_PGM("J# N1       Map gesture # to an action (N0 None, N1 Next grip, N2 Previous grip, N3 Favourite grip, N4 Toggle mode)");
+	MYSERIAL_PRINTLN_PGM("            Gestures J0 Hold open, J1 Hold close, J2 Double open, J3 Double close, J4 Co-contraction");
+	MYSERIAL_PRINTLN_PGM("G2 J2 N3    Double pulse of the open muscle to jump to grip 2 (the favourite is the current grip)");
+	MYSERIAL_PRINT_PGM("\n");
+
+	// RESPONSE CURVES
+	MYSERIAL_PRINTLN_PGM("Response Curves (Q#, W#, Y#, Z#, V#)");
+	MYSERIAL_PRINTLN_PGM("Command     Description");
+	MYSERIAL_PRINTLN_PGM("Q           View all response curves");
+	MYSERIAL_PRINTLN_PGM("Q0          View the EMG proportional control curve (M2)");
+	MYSERIAL_PRINTLN_PGM("Q1          View the HANDle joystick curve (A5)");
+	MYSERIAL_PRINTLN_PGM("Q# W1       Set curve shape (W0 Linear, W1 Expo, W2 S-curve, W3 Dead zone)");
+	MYSERIAL_PRINTLN_PGM("Q# Y20      Set curve exponent x10 (Y20 = x^2)");
+	MYSERIAL_PRINTLN_PGM("Q# Z10      Set dead zone to 10% of the input range (W3)");
+	MYSERIAL_PRINTLN_PGM("Q# V400     Set output at full input x100 (V400 = 4% per sample)");
+	MYSERIAL_PRINT_PGM("\n");
+
+	// GRIP CLASSIFIER
+	MYSERIAL_PRINTLN_PGM("Grip Classifier (B#)");
+	MYSERIAL_PRINTLN_PGM("Command     Description");
+	MYSERIAL_PRINTLN_PGM("B           View the classifier model");
+	MYSERIAL_PRINTLN_PGM("B0          Select grips by holding OPEN (M1, M2)");
+	MYSERIAL_PRINTLN_PGM("B1          Select grips with the classifier (M1, M2)");
+	MYSERIAL_PRINTLN_PGM("B3          Upload a classifier model (from LDATrainer)");
 	MYSERIAL_PRINT_PGM("\n");
 
 	// ADVANCED SETTINGS
-	MYSERIAL_PRINTLN_PGM("Advanced Settings (H#, A#, ?)");
+	MYSERIAL_PRINTLN_PGM("Advanced Settings (H#, A#, L#, ?)");
 	MYSERIAL_PRINTLN_PGM("Command     Description");
 	MYSERIAL_PRINTLN_PGM("H           View hand configuration (LEFT or RIGHT)");
 	MYSERIAL_PRINTLN_PGM("H1          Set hand to be RIGHT");
@@ -775,7 +1177,11 @@ void serial_SerialInstructions(int val)
 	MYSERIAL_PRINTLN_PGM("A4          Enable/Disable CSV mode (fast control)");
 	MYSERIAL_PRINTLN_PGM("A5          Enable/Disable HANDle mode (Wii Nunchuck)");
 	MYSERIAL_PRINTLN_PGM("A6          Get the position of all fingers as a CSV string");
+	MYSERIAL_PRINTLN_PGM("A7          Start/Stop binary trace recording of all inputs");
+	MYSERIAL_PRINTLN_PGM("A8          Enable/Disable smooth finger trajectories (limited acceleration)");
 	MYSERIAL_PRINTLN_PGM("#           Display system diagnostics");
+	MYSERIAL_PRINTLN_PGM("L           Display loop profiler (execution times, CPU load, finger writes, EMG ADC overruns & EMG latency)");
+	MYSERIAL_PRINTLN_PGM("L1          Reset loop profiler");
 	MYSERIAL_PRINTLN_PGM("?           Display serial commands list");
 	MYSERIAL_PRINT_PGM("\n");
 
@@ -28,6 +28,7 @@
 #define ASCII_SPACE			0x20	// space character
 #define ASCII_HASH			0x23	// # character
 #define ASCII_COMMA			0x2C	// , character
+#define ASCII_MINUS			0x2D	// - character
 #define ASCII_QMARK			0x3F	// ? character
 #define ASCII_0				0x30	// 0 digit
 #define ASCII_9				0x39	// 9 digit
@@ -35,27 +36,38 @@
 #define ASCII_z				0x7A	// z character
 
 // CHAR CODES
-#define NUM_SERIAL_CODES	16		// Number of different char codes (e.g. A, C, D, F, G ...)
+#define NUM_SERIAL_CODES	27		// Number of different char codes (e.g. A, C, D, F, G ...)
 #define SERIAL_CODE_A		0		// Advanced settings
-#define SERIAL_CODE_C		1		// Close
-#define SERIAL_CODE_D		2		// Demo mode
-#define SERIAL_CODE_F		3		// Finger number
-#define SERIAL_CODE_G		4		// Grip number
-#define SERIAL_CODE_H		5		// Set hand to left/right
-#define SERIAL_CODE_M		6		// EMG mode
-#define SERIAL_CODE_O		7		// Open
-#define SERIAL_CODE_P		8		// Finger position
-#define SERIAL_CODE_R		9		// Reset to defaults
-#define SERIAL_CODE_S		10		// Finger speed
-#define SERIAL_CODE_T		11		// Muscle hold time
-#define SERIAL_CODE_U		12		// Muscle peak threshold
-#define SERIAL_CODE_X		13		// Exit mode
-#define	SERIAL_CODE_HASH	14		// Print system diagnostics
-#define SERIAL_CODE_QMARK	15		// Print serial instructions
+#define SERIAL_CODE_B		1		// EMG grip classifier
+#define SERIAL_CODE_C		2		// Close
+#define SERIAL_CODE_D		3		// Demo mode
+#define SERIAL_CODE_E		4		// EMG calibration
+#define SERIAL_CODE_F		5		// Finger number
+#define SERIAL_CODE_G		6		// Grip number
+#define SERIAL_CODE_H		7		// Set hand to left/right
+#define SERIAL_CODE_J		8		// EMG gesture
+#define SERIAL_CODE_K		9		// EMG onset detector
+#define SERIAL_CODE_L		10		// Loop profiler
+#define SERIAL_CODE_M		11		// EMG mode
+#define SERIAL_CODE_N		12		// EMG gesture action
+#define SERIAL_CODE_O		13		// Open
+#define SERIAL_CODE_P		14		// Finger position
+#define SERIAL_CODE_Q		15		// Response curve
+#define SERIAL_CODE_R		16		// Reset to defaults
+#define SERIAL_CODE_S		17		// Finger speed
+#define SERIAL_CODE_T		18		// Muscle hold time
+#define SERIAL_CODE_U		19		// Muscle peak threshold
+#define SERIAL_CODE_V		20		// Response curve gain
+#define SERIAL_CODE_W		21		// Response curve shape
+#define SERIAL_CODE_X		22		// Exit mode
+#define SERIAL_CODE_Y		23		// Response curve exponent
+#define SERIAL_CODE_Z		24		// Response curve dead zone
+#define	SERIAL_CODE_HASH	25		// Print system diagnostics
+#define SERIAL_CODE_QMARK	26		// Print serial instructions
 
 // CODE VAL CONTRAINTS
-#define NUM_ADV_SETTINGS	6		// number of advanced settings
-#define NUM_EMG_MODES		3		// number of EMG modes
+#define NUM_ADV_SETTINGS	8		// number of advanced settings
+#define NUM_EMG_MODES		4		// number of EMG modes
 #define NUM_HAND_TYPES		3		// None, Left, Right
 #define LIMIT_FOR_BOOLEAN	1		// either 0 or 1
 
@@ -94,16 +106,22 @@ void receiveCSV(char *buff);			// if string contains CSV data, write received po
 
 // CHAR CODE FUNCTIONS (the following functions are attached to the char codes)
 void serial_AdvancedSettings(int setting);		// configure the advanced settings
+void serial_Classifier(int val);				// view/enable/upload the EMG grip classifier
 void serial_ToggleDemoMode(int val);			// toggle demo mode
+void serial_Calibration(int val);				// start/cancel/view the EMG calibration
 void serial_FingerControl(int fNum);			// finger control
 void serial_GripControl(int gNum);				// grip control
 void serial_SetHandType(int hType);				// set hand type (NONE, LEFT, RIGHT)
 void serial_MuscleControlMode(int mMode);		// muscle control mode
 void serial_HoldTime(int hTime);				// muscle hold time
-void serial_PeakThresh(int pThresh);			// muscle peak threshold
+void serial_PeakThresh(int pThresh);			// muscle peak threshold, of every channel
+void serial_OnsetDetector(int ch);				// view/toggle the onset detector of each channel
+void serial_Gesture(int gNum);					// view/map the action of each EMG gesture
+void serial_ResponseCurve(int cNum);			// view/configure a response curve
 void serial_ResetToDefaults(int val);			// reset to defaults
 void serial_ExitMode(int val);					// exit modes
 void serial_systemDiagnostics(int val);			// system diagnostics
+void serial_LoopProfiler(int val);				// print/reset the loop profiler and EMG latency
 void serial_SerialInstructions(int val = NULL);	// serial instructions
 
 void printCurrentMode(void);					// print the current mode and the exit command
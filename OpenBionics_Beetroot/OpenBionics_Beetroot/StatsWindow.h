@@ -0,0 +1,176 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	StatsWindow.h
+*
+*/
+
+// Sliding window statistics, with O(1) mean, mean square, variance, min and max.
+// The window is (1 << SIZE_BITS) values long. A running sum and sum of squares are updated as each value is
+// written, so the mean and variance of a full window only need a shift (the Cortex-M0+ has no divider). The
+// min and max are kept at the front of two monotonic deques of the sequence numbers of the values within the
+// window, each value is added to and removed from each deque once, so write() is amortised O(1).
+//
+// SUM_T must be able to hold (window size x max value^2), e.g. int32_t for 12 bit ADC values in a 128 window,
+// or double for floats.
+
+#ifndef STATS_WINDOW_H_
+#define STATS_WINDOW_H_
+
+#include <Arduino.h>
+#include <math.h>
+
+// divide by (1 << bits)
+inline int32_t statsDivPow2(int32_t x, uint8_t bits) { return (x >> bits); }
+inline int64_t statsDivPow2(int64_t x, uint8_t bits) { return (x >> bits); }
+inline double statsDivPow2(double x, uint8_t bits) { return ldexp(x, -bits); }
+
+// widen a sum, so that it can be squared without overflow
+inline int64_t statsWide(int32_t x) { return x; }
+inline int64_t statsWide(int64_t x) { return x; }
+inline double statsWide(double x) { return x; }
+
+template <class T, uint8_t SIZE_BITS, class SUM_T = int32_t>
+class STATS_WINDOW
+{
+	public:
+		STATS_WINDOW() { begin(); }
+
+		// clear the window
+		void begin(void)
+		{
+			_seq = 0;
+			_count = 0;
+			_sum = 0;
+			_sumSq = 0;
+			_minHead = _minCount = 0;
+			_maxHead = _maxCount = 0;
+		}
+
+		// add a value to the window, removing the oldest value if the window is full
+		void write(T val)
+		{
+			// remove the oldest value from the sums
+			if (_count == SIZE)
+			{
+				T old = _buff[_seq & MASK];
+
+				_sum -= old;
+				_sumSq -= (SUM_T)old * old;
+			}
+			else
+			{
+				_count++;
+			}
+
+			_buff[_seq & MASK] = val;
+			_sum += val;
+			_sumSq += (SUM_T)val * val;
+
+			// remove the sequence numbers that have left the window from the front of each deque
+			uint16_t oldest = _seq - (_count - 1);
+
+			if (_minCount && (_minDeque[_minHead] == (uint16_t)(oldest - 1)))
+			{
+				_minHead = (_minHead + 1) & MASK;
+				_minCount--;
+			}
+			if (_maxCount && (_maxDeque[_maxHead] == (uint16_t)(oldest - 1)))
+			{
+				_maxHead = (_maxHead + 1) & MASK;
+				_maxCount--;
+			}
+
+			// remove any values that can no longer be the min/max from the back of each deque
+			while (_minCount && (_buff[_minDeque[(_minHead + _minCount - 1) & MASK] & MASK] >= val))
+			{
+				_minCount--;
+			}
+			while (_maxCount && (_buff[_maxDeque[(_maxHead + _maxCount - 1) & MASK] & MASK] <= val))
+			{
+				_maxCount--;
+			}
+
+			_minDeque[(_minHead + _minCount++) & MASK] = _seq;
+			_maxDeque[(_maxHead + _maxCount++) & MASK] = _seq;
+
+			_seq++;
+		}
+
+		// read the oldest value
+		T read(void)
+		{
+			return (_count ? _buff[(uint16_t)(_seq - _count) & MASK] : T());
+		}
+
+		// read the mean of the window
+		T readMean(void)
+		{
+			if (_count == SIZE)
+				return (T)statsDivPow2(_sum, SIZE_BITS);
+
+			return (_count ? (T)(_sum / (SUM_T)_count) : T());
+		}
+
+		// read the (population) variance of the window
+		SUM_T readVariance(void)
+		{
+			if (_count == SIZE)
+				return (SUM_T)statsDivPow2(statsWide(_sumSq) - statsDivPow2(statsWide(_sum) * _sum, SIZE_BITS), SIZE_BITS);
+
+			return (_count ? (SUM_T)((statsWide(_sumSq) - ((statsWide(_sum) * _sum) / _count)) / _count) : SUM_T());
+		}
+
+		// read the mean of the squares of the window (e.g. for an RMS)
+		SUM_T readMeanSquare(void)
+		{
+			if (_count == SIZE)
+				return (SUM_T)statsDivPow2(_sumSq, SIZE_BITS);
+
+			return (_count ? (SUM_T)(_sumSq / (SUM_T)_count) : SUM_T());
+		}
+
+		// read the minimum value within the window
+		T readMin(void)
+		{
+			return (_minCount ? _buff[_minDeque[_minHead] & MASK] : T());
+		}
+
+		// read the maximum value within the window
+		T readMax(void)
+		{
+			return (_maxCount ? _buff[_maxDeque[_maxHead] & MASK] : T());
+		}
+
+		// number of values within the window
+		uint16_t count(void) { return _count; }
+
+		// maximum number of values within the window
+		uint16_t size(void) { return SIZE; }
+
+	private:
+		enum { SIZE = (1 << SIZE_BITS), MASK = (SIZE - 1) };
+
+		T _buff[SIZE];					// values, indexed by sequence number
+		uint16_t _seq;					// sequence number of the next value
+		uint16_t _count;				// number of values within the window
+		SUM_T _sum;						// sum of the values within the window
+		SUM_T _sumSq;					// sum of the squares of the values within the window
+
+		uint16_t _minDeque[SIZE];		// sequence numbers of the values that may become the min, in order of increasing value
+		uint16_t _minHead;
+		uint16_t _minCount;
+		uint16_t _maxDeque[SIZE];		// sequence numbers of the values that may become the max, in order of decreasing value
+		uint16_t _maxHead;
+		uint16_t _maxCount;
+};
+
+#endif // STATS_WINDOW_H_
@@ -0,0 +1,167 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	TaskScheduler.cpp
+*
+*/
+
+#include "Globals.h"
+#include "Profiler.h"
+#include "TaskScheduler.h"
+
+TASK_SCHEDULER Scheduler;
+
+////////////////////////////// Constructors/Destructors //////////////////////////////
+
+TASK_SCHEDULER::TASK_SCHEDULER()
+{
+	_numTasks = 0;
+}
+
+////////////////////////////// Public Methods //////////////////////////////
+
+// add a task to the scheduler, returns the task ID (-1 if there is no space)
+int TASK_SCHEDULER::add(const char *name, taskFuncPtr func, uint16_t period, TaskPriority priority)
+{
+	if ((_numTasks >= MAX_NUM_TASKS) || (func == NULL))
+	{
+		return (-1);
+	}
+
+	Task *task = &_tasks[_numTasks];
+
+	task->name = name;
+	task->func = func;
+	task->period = (period > 0) ? period : 1;
+	task->priority = priority;
+	task->probe = Profiler.add(name, PROBE_TASK);		// measure the execution time of the task
+
+	task->nextRun = customMillis();			// run on the first pass
+
+	task->numRuns = 0;
+	task->numOverruns = 0;
+	task->maxLate = 0;
+
+	return _numTasks++;
+}
+
+// run all due HIGH priority tasks and the most urgent due background task
+void TASK_SCHEDULER::run(void)
+{
+	Task *next = NULL;				// most urgent background task
+	long now = customMillis();
+
+	for (int i = 0; i < _numTasks; i++)
+	{
+		Task *task = &_tasks[i];
+
+		if (!isDue(task, now))
+			continue;
+
+		// run the control path whenever it is due
+		if (task->priority == TASK_HIGH)
+		{
+			runTask(task, now);
+			now = customMillis();
+		}
+		// otherwise find the task with the earliest deadline, using the priority to break a tie
+		else if ((next == NULL) ||
+			((task->nextRun - next->nextRun) < 0) ||
+			((task->nextRun == next->nextRun) && (task->priority > next->priority)))
+		{
+			next = task;
+		}
+	}
+
+	if (next)
+	{
+		runTask(next, customMillis());
+	}
+}
+
+// returns true if any task is due
+bool TASK_SCHEDULER::anyDue(void)
+{
+	long now = customMillis();
+
+	for (int i = 0; i < _numTasks; i++)
+	{
+		if (isDue(&_tasks[i], now))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// print the period, number of runs and overruns of each task
+void TASK_SCHEDULER::printStatus(void)
+{
+	const char *priorityNames[3] = { "LOW", "NORM", "HIGH" };
+
+	MYSERIAL_PRINTLN_PGM("Task\t\tPer(ms)\tPri\tRuns\tOverruns\tMaxLate(ms)");
+
+	for (int i = 0; i < _numTasks; i++)
+	{
+		MYSERIAL_PRINT(_tasks[i].name);
+		MYSERIAL_PRINT_PGM("\t");
+		if (strlen(_tasks[i].name) < 8)			// align columns for short task names
+		{
+			MYSERIAL_PRINT_PGM("\t");
+		}
+		MYSERIAL_PRINT(_tasks[i].period);
+		MYSERIAL_PRINT_PGM("\t");
+		MYSERIAL_PRINT(priorityNames[_tasks[i].priority]);
+		MYSERIAL_PRINT_PGM("\t");
+		MYSERIAL_PRINT(_tasks[i].numRuns);
+		MYSERIAL_PRINT_PGM("\t");
+		MYSERIAL_PRINT(_tasks[i].numOverruns);
+		MYSERIAL_PRINT_PGM("\t\t");
+		MYSERIAL_PRINTLN(_tasks[i].maxLate);
+	}
+}
+
+////////////////////////////// Private Methods //////////////////////////////
+
+// returns true if the task deadline has been reached
+bool TASK_SCHEDULER::isDue(Task *task, long now)
+{
+	return ((now - task->nextRun) >= 0);		// difference is used so that the comparison survives customMillis() overflow
+}
+
+// run the task and schedule the next deadline
+void TASK_SCHEDULER::runTask(Task *task, long now)
+{
+	long late = now - task->nextRun;		// time since the task became due
+
+	if (late > task->maxLate)
+	{
+		task->maxLate = (late > UINT16_MAX) ? UINT16_MAX : late;
+	}
+
+	// if a whole period has been missed, count an overrun and re-synchronise, rather than running the task repeatedly to catch up
+	if (late >= task->period)
+	{
+		task->numOverruns++;
+		task->nextRun = now + task->period;
+	}
+	else
+	{
+		task->nextRun += task->period;		// keep the original phase, so that the average rate is exact
+	}
+
+	Profiler.start(task->probe);
+	task->func();
+	Profiler.stop(task->probe);
+
+	task->numRuns++;
+}
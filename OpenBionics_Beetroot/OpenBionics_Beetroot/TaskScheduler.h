@@ -0,0 +1,73 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	TaskScheduler.h
+*
+*/
+
+// Cooperative task scheduler, using the customMillis() timebase.
+// Each task has a period and a priority. Every pass of run(), all HIGH priority tasks that are due are run,
+// followed by at most one NORMAL/LOW priority task (the one with the earliest deadline). This bounds the
+// time between runs of the control tasks to the duration of the longest single background task.
+
+#ifndef TASK_SCHEDULER_H_
+#define TASK_SCHEDULER_H_
+
+#include "TimerManagement.h"		// customMillis()
+
+#define MAX_NUM_TASKS		10		// maximum number of tasks that can be added to the scheduler
+
+typedef enum _TaskPriority
+{
+	TASK_LOW = 0,		// diagnostics, monitoring
+	TASK_NORMAL,		// user interface, comms
+	TASK_HIGH			// control path, run every pass when due
+} TaskPriority;
+
+typedef void(*taskFuncPtr)(void);
+
+typedef struct _Task
+{
+	const char *name;			// name of task, used for diagnostics
+	taskFuncPtr func;			// function to run
+	uint16_t period;			// ms
+	TaskPriority priority;		// LOW, NORMAL, HIGH
+	int8_t probe;				// profiler probe ID
+
+	long nextRun;				// time the task is next due (ms)
+
+	uint32_t numRuns;			// number of times the task has run
+	uint32_t numOverruns;		// number of times the task has missed a whole period
+	uint16_t maxLate;			// maximum time the task has been run after its deadline (ms)
+} Task;
+
+class TASK_SCHEDULER
+{
+	public:
+		TASK_SCHEDULER();
+
+		int add(const char *name, taskFuncPtr func, uint16_t period, TaskPriority priority);	// add a task to the scheduler, returns the task ID (-1 if there is no space)
+		void run(void);						// run all due HIGH priority tasks and the most urgent due background task
+		bool anyDue(void);					// returns true if any task is due
+
+		void printStatus(void);				// print the period, number of runs and overruns of each task
+
+	private:
+		Task _tasks[MAX_NUM_TASKS];			// list of tasks
+		uint8_t _numTasks;					// number of tasks added
+
+		bool isDue(Task *task, long now);	// returns true if the task deadline has been reached
+		void runTask(Task *task, long now);	// run the task and schedule the next deadline
+};
+
+extern TASK_SCHEDULER Scheduler;
+
+#endif // TASK_SCHEDULER_H_
@@ -18,19 +18,34 @@
 
 
 
+#include "EMGADC.h"
 #include "ErrorHandling.h"
+#include "EventQueue.h"
 #include "LED.h"
+#include "Profiler.h"
 
 static long _milliSeconds = 0;			// number of milliSeconds since power on
 static long _seconds = 0;				// number of seconds since power on
 
+static int _errorProbe = -1;			// profiler probe IDs of the functions deferred from the interrupt
+static int _LEDProbe = -1;
+static int _EMGADCProbe = -1;			// profiler probe ID of the EMG ADC scan, made within the interrupt
+
 // attach millisecond function to millisecond interrupt from FingerLib
 void timerSetup(void)
 {
+	// add profiler probes for the deferred functions and the EMG ADC scan (timerSetup() is called again if the settings are reset)
+	if (_errorProbe < 0)
+	{
+		_errorProbe = Profiler.add("ERROR");
+		_LEDProbe = Profiler.add("LED");
+		_EMGADCProbe = Profiler.add("EMG ADC", PROBE_ISR);
+	}
+
 	_attachFuncToTimer(milliSecInterrupt);		// attach function to 1ms FingerLib timer interrupt
 }
 
-// called every 1ms, increments milliseconds and second counters
+// called every 1ms, increments milliseconds and second counters, scans the EMG ADC and counts a tick to be handled by runEvents()
 void milliSecInterrupt(void)
 {
 	_milliSeconds++;
@@ -41,12 +56,43 @@ void milliSecInterrupt(void)
 		_seconds++;
 	}
 
+	// the EMG ADC shares the ADC with the fingers, so it is scanned from the same interrupt (the ISR load of the profiler)
+	Profiler.start(_EMGADCProbe);
+	EMGADC.tick();
+	Profiler.stop(_EMGADCProbe);
+
+	Events.tick();
+}
+
+// handle the events posted from the interrupt, called from loop() and any blocking wait
+void runEvents(void)
+{
+	EventType e;
+
+	while (Events.get(&e))
+	{
+		switch (e)
+		{
+			default:
+				break;
+		}
+	}
+
+	// ERROR and LED use timers, so any number of ticks since the last run only need a single run
+	if (!Events.getTicks())
+	{
+		return;
+	}
 
 	// clear any warnings after a set period
+	Profiler.start(_errorProbe);
 	ERROR.run();
+	Profiler.stop(_errorProbe);
 
 	// run LED class to manage blinking and fading
+	Profiler.start(_LEDProbe);
 	LED.run();
+	Profiler.stop(_LEDProbe);
 }
 
 // return number of milliseconds since power on
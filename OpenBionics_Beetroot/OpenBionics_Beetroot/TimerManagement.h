@@ -21,6 +21,7 @@
 
 void timerSetup(void);				// attach millisecond function to millisecond interrupt from FingerLib
 void milliSecInterrupt(void);		// called every 1ms, increments milliseconds and second counters			
+void runEvents(void);				// handle the events posted and the ticks counted by the interrupt, called from loop() and any blocking wait
 long customMillis(void);			// return number of milliseconds since power on
 long customSeconds(void);			// return number of seconds since power on
 
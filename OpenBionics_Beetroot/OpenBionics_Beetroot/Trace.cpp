@@ -0,0 +1,197 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	Trace.cpp
+*
+*/
+
+#include "Globals.h"
+#include "TimerManagement.h"
+#include "Trace.h"
+
+TRACE_CLASS Trace;
+
+////////////////////////////// Constructors/Destructors //////////////////////////////
+
+TRACE_CLASS::TRACE_CLASS()
+{
+	_en = false;
+	_prevTime = 0;
+	_numRecords = 0;
+	_len = 0;
+}
+
+////////////////////////////// Public Methods //////////////////////////////
+
+// start recording, send a TRACE_START record
+void TRACE_CLASS::start(void)
+{
+	_en = true;
+	_numRecords = 0;
+	_prevTime = micros();
+
+	beginRecord(TRACE_START);
+	addByte(TRACE_VERSION);
+	addVarint(customMillis());
+	send();
+}
+
+// stop recording
+void TRACE_CLASS::stop(void)
+{
+	_en = false;
+}
+
+// returns true if recording
+bool TRACE_CLASS::recording(void)
+{
+	return _en;
+}
+
+// record raw bytes
+void TRACE_CLASS::record(TraceType type, const uint8_t *data, uint8_t len)
+{
+	if (!_en)
+		return;
+
+	beginRecord(type);
+	for (uint8_t i = 0; i < len; i++)
+	{
+		addByte(data[i]);
+	}
+	send();
+}
+
+// record a number of values, as varints
+void TRACE_CLASS::recordSamples(TraceType type, const int *vals, uint8_t n)
+{
+	if (!_en)
+		return;
+
+	recordSamples(type, vals, n, micros());
+}
+
+// record a number of values, as varints, that were sampled at 'time' (us)
+void TRACE_CLASS::recordSamples(TraceType type, const int *vals, uint8_t n, uint32_t time)
+{
+	if (!_en)
+		return;
+
+	beginRecord(type, time);
+	addByte(n);
+	for (uint8_t i = 0; i < n; i++)
+	{
+		addVarint((uint32_t)vals[i]);
+	}
+	send();
+}
+
+// record a number of register values read from an I2C device
+void TRACE_CLASS::recordReg(TraceType type, uint8_t addr, uint8_t reg, const uint8_t *data, uint8_t len)
+{
+	if (!_en)
+		return;
+
+	beginRecord(type);
+	addByte(addr);
+	addByte(reg);
+	for (uint8_t i = 0; i < len; i++)
+	{
+		addByte(data[i]);
+	}
+	send();
+}
+
+// number of records sent since recording started
+uint32_t TRACE_CLASS::getNumRecords(void)
+{
+	return _numRecords;
+}
+
+////////////////////////////// Private Methods //////////////////////////////
+
+// start a new record body, with the type and the time since the previous record
+void TRACE_CLASS::beginRecord(TraceType type)
+{
+	beginRecord(type, micros());
+}
+
+// start a new record body, for an input sampled at 'time' (us)
+void TRACE_CLASS::beginRecord(TraceType type, uint32_t time)
+{
+	// an input sampled before the previous record was sent is recorded at the time of the previous record,
+	// so that the records stay in order
+	if ((int32_t)(time - _prevTime) < 0)
+		time = _prevTime;
+
+	_len = 0;
+	addByte(type);
+	addVarint(time - _prevTime);		// unsigned difference survives micros() overflow
+
+	_prevTime = time;
+}
+
+// add a byte to the record body
+void TRACE_CLASS::addByte(uint8_t b)
+{
+	if (_len < TRACE_MAX_BODY_SIZE)
+	{
+		_body[_len++] = b;
+	}
+}
+
+// add a value to the record body, as a varint
+void TRACE_CLASS::addVarint(uint32_t val)
+{
+	while (val >= 0x80)
+	{
+		addByte((val & 0x7F) | 0x80);
+		val >>= 7;
+	}
+	addByte(val);
+}
+
+// send the record body as a SLIP frame
+void TRACE_CLASS::send(void)
+{
+	uint8_t frame[(TRACE_MAX_BODY_SIZE * 2) + 2];		// worst case, every byte is escaped
+	uint8_t n = 0;
+
+	frame[n++] = TRACE_END;
+
+	for (uint8_t i = 0; i < _len; i++)
+	{
+		if (_body[i] == TRACE_END)
+		{
+			frame[n++] = TRACE_ESC;
+			frame[n++] = TRACE_ESC_END;
+		}
+		else if (_body[i] == TRACE_ESC)
+		{
+			frame[n++] = TRACE_ESC;
+			frame[n++] = TRACE_ESC_ESC;
+		}
+		else
+		{
+			frame[n++] = _body[i];
+		}
+	}
+
+	frame[n++] = TRACE_END;
+
+	// send the whole frame at once, so that it is not split by any text
+	if (SERIALNONBLOCKCHECK)
+	{
+		MYSERIAL.write(frame, n);
+	}
+
+	_numRecords++;
+}
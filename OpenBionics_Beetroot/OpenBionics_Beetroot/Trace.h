@@ -0,0 +1,92 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	Trace.h
+*
+*/
+
+// Binary trace of every input consumed by the firmware (EMG samples, Nunchuck bytes, IMU registers and serial
+// chars), sent over serial while recording is enabled (A7). The trace can be replayed by the host build so that
+// a field recording can be used as a repeatable benchmark.
+//
+// Each record is sent as a SLIP frame (TRACE_END, body, TRACE_END), with any TRACE_END or TRACE_ESC bytes
+// within the body escaped. As the serial text is plain ASCII, records can be separated from the text in a raw
+// serial capture. The body of each record is:
+//
+//		type (1 byte), time since previous record (varint, us), payload
+//
+//		TRACE_START		version (1 byte), customMillis() (varint)
+//		TRACE_EMG		number of channels (1 byte), sample of each channel (varint)
+//		TRACE_HANDLE	raw Nunchuck bytes
+//		TRACE_IMU		I2C address (1 byte), first register (1 byte), register values
+//		TRACE_SERIAL	received chars
+//
+// Varints are little endian base 128 (7 bits per byte, MSB set if more bytes follow).
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <Arduino.h>
+
+#define TRACE_VERSION			1
+
+// SLIP FRAMING
+#define TRACE_END				0xC0	// start/end of record
+#define TRACE_ESC				0xDB	// escape char
+#define TRACE_ESC_END			0xDC	// escaped TRACE_END
+#define TRACE_ESC_ESC			0xDD	// escaped TRACE_ESC
+
+#define TRACE_MAX_BODY_SIZE		32		// maximum size of a record, before escaping
+
+typedef enum _TraceType
+{
+	TRACE_START = 0,		// start of recording
+	TRACE_EMG,				// raw EMG ADC samples
+	TRACE_HANDLE,			// raw Nunchuck bytes
+	TRACE_IMU,				// IMU register values
+	TRACE_SERIAL,			// received serial chars
+	NUM_TRACE_TYPES
+} TraceType;
+
+class TRACE_CLASS
+{
+	public:
+		TRACE_CLASS();
+
+		void start(void);					// start recording, send a TRACE_START record
+		void stop(void);					// stop recording
+		bool recording(void);				// returns true if recording
+
+		void record(TraceType type, const uint8_t *data, uint8_t len);				// record raw bytes
+		void recordSamples(TraceType type, const int *vals, uint8_t n);			// record a number of values, as varints
+		void recordSamples(TraceType type, const int *vals, uint8_t n, uint32_t time);	// record a number of values, as varints, that were sampled at 'time' (us)
+		void recordReg(TraceType type, uint8_t addr, uint8_t reg, const uint8_t *data, uint8_t len);	// record a number of register values read from an I2C device
+
+		uint32_t getNumRecords(void);		// number of records sent since recording started
+
+	private:
+		bool _en;							// recording enabled
+		uint32_t _prevTime;					// us, time of the previous record
+		uint32_t _numRecords;				// number of records sent since recording started
+
+		uint8_t _body[TRACE_MAX_BODY_SIZE];	// body of the current record
+		uint8_t _len;						// size of the current record body
+
+		void beginRecord(TraceType type);	// start a new record body, with the type and the time since the previous record
+		void beginRecord(TraceType type, uint32_t time);	// start a new record body, for an input sampled at 'time' (us)
+		void addByte(uint8_t b);			// add a byte to the record body
+		void addVarint(uint32_t val);		// add a value to the record body, as a varint
+		void send(void);					// send the record body as a SLIP frame
+};
+
+extern TRACE_CLASS Trace;
+
+#endif // TRACE_H_
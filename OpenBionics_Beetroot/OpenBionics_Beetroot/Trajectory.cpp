@@ -0,0 +1,230 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	Trajectory.cpp
+*
+*/
+
+#include <FingerLib.h>
+
+#include "Globals.h"
+#include "Trajectory.h"
+
+#include "FingerCache.h"			// FingerCache
+#include "Initialisation.h"		// settings
+
+FINGER_TRAJECTORY Trajectory;
+
+////////////////////////////// Constructors/Destructors //////////////////////////////
+
+FINGER_TRAJECTORY::FINGER_TRAJECTORY()
+{
+	_en = false;
+	_lastTime = 0;
+}
+
+////////////////////////////// Public Methods //////////////////////////////
+
+// stop each finger at its current target, with the default limits, and enable if set in the settings
+void FINGER_TRAJECTORY::begin(void)
+{
+	for (int f = 0; f < NUM_FINGERS; f++)
+	{
+		_finger[f].target = finger[f].readTargetPos();
+		_finger[f].pos = (int32_t)_finger[f].target << TRAJ_FRAC_BITS;
+		_finger[f].vel = 0;
+		_finger[f].speed = MAX_FINGER_PWM;
+		_finger[f].moving = false;
+
+		setLimits(f, TRAJ_MAX_VEL, TRAJ_ACCEL);
+	}
+
+	_en = settings.trajectoryEn;
+	_lastTime = millis();
+}
+
+// start following trajectories, from the current target of each finger
+void FINGER_TRAJECTORY::enable(void)
+{
+	if (_en)
+		return;
+
+	for (int f = 0; f < NUM_FINGERS; f++)
+	{
+		_finger[f].moving = false;
+	}
+
+	_en = true;
+	_lastTime = millis();
+}
+
+// write the target of each finger straight to the finger
+void FINGER_TRAJECTORY::disable(void)
+{
+	if (!_en)
+		return;
+
+	_en = false;
+
+	for (int f = 0; f < NUM_FINGERS; f++)
+	{
+		if (_finger[f].moving)
+		{
+			FingerCache.writePos(f, _finger[f].target);
+			_finger[f].moving = false;
+		}
+	}
+}
+
+// returns true if enabled
+bool FINGER_TRAJECTORY::enabled(void)
+{
+	return _en;
+}
+
+// set the max velocity (counts/s) & acceleration (counts/s^2) of finger f
+void FINGER_TRAJECTORY::setLimits(int f, uint16_t maxVel, uint16_t accel)
+{
+	if (!IS_BETWEEN(f, 0, NUM_FINGERS - 1))
+		return;
+
+	// convert in uint32_t, as a limit above 32767 shifted by TRAJ_FRAC_BITS does not fit in an int32_t
+	_finger[f].maxVel = (int32_t)(((uint32_t)maxVel << TRAJ_FRAC_BITS) / 1000);
+	_finger[f].accel = (int32_t)(((uint32_t)accel << TRAJ_FRAC_BITS) / 1000000);
+
+	// the setpoint must always be able to move
+	if (_finger[f].maxVel < 1)
+		_finger[f].maxVel = 1;
+	if (_finger[f].accel < 1)
+		_finger[f].accel = 1;
+}
+
+// set the target position of finger f
+void FINGER_TRAJECTORY::writePos(int f, int pos)
+{
+	if (!IS_BETWEEN(f, 0, NUM_FINGERS - 1))
+		return;
+
+	FingerTrajectory *t = &_finger[f];
+
+	uint16_t target = constrain(pos, MIN_FINGER_POS, MAX_FINGER_POS);
+
+	if (!_en)
+	{
+		t->target = target;
+		FingerCache.writePos(f, target);
+		return;
+	}
+
+	if (!t->moving)
+	{
+		// the finger is already stationary at the target
+		if ((target == t->target) && (finger[f].readTargetPos() == target))
+			return;
+
+		// a stationary finger starts from its current target, as it may have been moved by something else (e.g. F#)
+		t->pos = (int32_t)finger[f].readTargetPos() << TRAJ_FRAC_BITS;
+		t->vel = 0;
+	}
+
+	t->target = target;
+	t->moving = true;
+}
+
+// set the PWM of finger f
+void FINGER_TRAJECTORY::writeSpeed(int f, int speed)
+{
+	if (!IS_BETWEEN(f, 0, NUM_FINGERS - 1))
+		return;
+
+	_finger[f].speed = constrain(speed, OFF_FINGER_PWM, MAX_FINGER_PWM);
+
+	if (!_en || !_finger[f].moving)
+		FingerCache.writeSpeed(f, _finger[f].speed);
+}
+
+// returns true if the setpoint of finger f has not yet reached the target
+bool FINGER_TRAJECTORY::moving(int f)
+{
+	return IS_BETWEEN(f, 0, NUM_FINGERS - 1) ? _finger[f].moving : false;
+}
+
+// advance the setpoint of each moving finger, called every 1ms
+void FINGER_TRAJECTORY::run(void)
+{
+	uint32_t now = millis();
+	uint32_t steps = now - _lastTime;
+
+	_lastTime = now;
+
+	if (!_en)
+		return;
+
+	// if run() has been delayed, the setpoints are advanced by up to TRAJ_MAX_STEPS
+	if (steps > TRAJ_MAX_STEPS)
+		steps = TRAJ_MAX_STEPS;
+
+	for (int f = 0; f < NUM_FINGERS; f++)
+	{
+		FingerTrajectory *t = &_finger[f];
+
+		if (!t->moving)
+			continue;
+
+		for (uint32_t s = 0; (s < steps) && t->moving; s++)
+		{
+			step(t);
+		}
+
+		FingerCache.writePos(f, (t->pos + (1 << (TRAJ_FRAC_BITS - 1))) >> TRAJ_FRAC_BITS);
+		FingerCache.writeSpeed(f, t->speed);
+	}
+}
+
+////////////////////////////// Private Methods //////////////////////////////
+
+// advance a setpoint by 1ms
+void FINGER_TRAJECTORY::step(FingerTrajectory *t)
+{
+	int32_t err = ((int32_t)t->target << TRAJ_FRAC_BITS) - t->pos;
+	int32_t dist = abs(err);
+	int32_t vel = (err >= 0) ? t->vel : -t->vel;		// velocity towards the target
+
+	// the target is reached within this step, slowly enough to stop
+	if ((dist <= abs(vel)) && (abs(vel) <= (2 * t->accel)))
+	{
+		t->pos = (int32_t)t->target << TRAJ_FRAC_BITS;
+		t->vel = 0;
+		t->moving = false;
+		return;
+	}
+
+	// decelerate if the distance to stop (v + (v - a) + ... ~= v(v + a) / 2a) has been reached
+	if ((vel > 0) && (((int64_t)vel * (vel + t->accel)) >= ((int64_t)2 * t->accel * dist)))
+	{
+		vel -= t->accel;
+	}
+	else if (vel < t->maxVel)
+	{
+		vel += t->accel;
+		if (vel > t->maxVel)
+			vel = t->maxVel;
+	}
+	else
+	{
+		vel -= t->accel;			// the max velocity has been reduced
+		if (vel < t->maxVel)
+			vel = t->maxVel;
+	}
+
+	t->vel = (err >= 0) ? vel : -vel;
+	t->pos += t->vel;
+}
@@ -0,0 +1,82 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	Trajectory.h
+*
+*/
+
+// Finger trajectories, between the grips (GRIP_CLASS::run()) and the fingers (A8).
+// Rather than writing a new target straight to a finger, which drives the motor towards it at the full PWM, the
+// setpoint written to the finger follows a trapezoidal velocity profile: it accelerates at 'accel' up to 'maxVel',
+// then decelerates at 'accel' so that it stops at the target. Each finger has its own limits (setLimits()).
+//
+// run() advances the setpoint of each moving finger by the time since it was last run (every 1ms, by the scheduler).
+// A new target while a finger is moving continues from the current setpoint & velocity, so the motion is blended
+// rather than restarted (a target behind the stopping distance is overshot, then returned to).
+//
+// The default limits only limit the acceleration, as the max velocity is above the speed of a finger at full PWM.
+// Trajectories are disabled by default (A8) until the limits have been tuned on a hand.
+//
+// While disabled, the targets are written straight to the fingers. Either way, the fingers are written through FingerCache,
+// so a position or speed that has not changed is not rewritten.
+
+#ifndef TRAJECTORY_H_
+#define TRAJECTORY_H_
+
+#include <Arduino.h>
+
+#include "Globals.h"			// NUM_FINGERS
+
+#define TRAJ_FRAC_BITS		16		// fractional bits of the setpoint, velocity & acceleration
+#define TRAJ_MAX_VEL		1500	// counts/s, default max velocity of each finger (above the ~1150 counts/s of a finger at full PWM)
+#define TRAJ_ACCEL			30000	// counts/s^2, default acceleration of each finger (full velocity in 50ms)
+#define TRAJ_MAX_STEPS		20		// ms, max time the setpoints are advanced by a single run()
+
+typedef struct _FingerTrajectory
+{
+	int32_t pos;			// setpoint (TRAJ_FRAC_BITS)
+	int32_t vel;			// counts/ms (TRAJ_FRAC_BITS), velocity of the setpoint
+	int32_t maxVel;			// counts/ms (TRAJ_FRAC_BITS)
+	int32_t accel;			// counts/ms^2 (TRAJ_FRAC_BITS)
+	uint16_t target;		// position that the setpoint is moving to
+	uint16_t speed;			// PWM written to the finger
+	bool moving;			// the setpoint has not yet reached the target
+} FingerTrajectory;
+
+class FINGER_TRAJECTORY
+{
+	public:
+		FINGER_TRAJECTORY();
+
+		void begin(void);						// stop each finger at its current target, with the default limits, and enable if set in the settings
+		void enable(void);						// start following trajectories, from the current target of each finger
+		void disable(void);						// write the target of each finger straight to the finger
+		bool enabled(void);						// returns true if enabled
+
+		void setLimits(int f, uint16_t maxVel, uint16_t accel);	// set the max velocity (counts/s) & acceleration (counts/s^2) of finger f
+
+		void writePos(int f, int pos);			// set the target position of finger f
+		void writeSpeed(int f, int speed);		// set the PWM of finger f
+		bool moving(int f);						// returns true if the setpoint of finger f has not yet reached the target
+
+		void run(void);							// advance the setpoint of each moving finger, called every 1ms
+
+	private:
+		FingerTrajectory _finger[NUM_FINGERS];	// trajectory of each finger
+		bool _en;								// follow trajectories, rather than writing the targets straight to the fingers
+		uint32_t _lastTime;						// ms, time of the previous run()
+
+		void step(FingerTrajectory *t);			// advance a setpoint by 1ms
+};
+
+extern FINGER_TRAJECTORY Trajectory;
+
+#endif // TRAJECTORY_H_
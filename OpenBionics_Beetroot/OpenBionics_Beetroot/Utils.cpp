@@ -30,6 +30,32 @@ unsigned int getNumberOfDigits(unsigned int i)
 	return i > 0 ? (int)log10((double)i) + 1 : 1;
 }
 
+// integer square root, rounded down (bit by bit, only shifts and adds as the Cortex-M0+ has no divider)
+uint16_t isqrt32(uint32_t n)
+{
+	uint32_t root = 0;
+	uint32_t bit = 1UL << 30;
+
+	while (bit > n)
+		bit >>= 2;
+
+	while (bit)
+	{
+		if (n >= root + bit)
+		{
+			n -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else
+		{
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return (uint16_t)root;
+}
+
 
 // converts a number (len) of integer variables from valArray to a CSV string (outString)
 void convertToCSV(int *valArray, int len, char* outString)
@@ -68,7 +68,7 @@ template <class T> int EEPROM_readStruct(int ee, const T& value)
 #define SERIALNONBLOCKCHECK			(MYSERIAL.dtr())
 #endif
 #else
-#error "Board not supported. Serial not able to be configured
+#error "Board not supported. Serial not able to be configured"
 #endif
 
 #define	FORCE_INLINE __attribute__((always_inline)) inline
@@ -109,11 +109,14 @@ FORCE_INLINE void serialprintPGM(const char *str)
 #define MYSERIAL_AVAILABLE() MYSERIAL.available()
 #define MYSERIAL_READ() MYSERIAL.read()
 
+bool serialTxReady(int len);	// returns true if 'len' bytes (up to a USB packet) can be written without waiting for the PC (Utils_SAMD.cpp)
+
 
 
 ///////////////////////////////////// NUMBER & DIGITS ///////////////////////////////////////
 bool isEven(int n);								// returns true if n is even
 unsigned int getNumberOfDigits(unsigned int i);	// get the number of digits in an unsigned int
+uint16_t isqrt32(uint32_t n);					// integer square root, rounded down
 				
 
 ///////////////////////////////////// CSV ///////////////////////////////////////
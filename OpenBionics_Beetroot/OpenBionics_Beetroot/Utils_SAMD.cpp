@@ -0,0 +1,47 @@
+/*	Open Bionics - Beetroot
+*	Author - Olly McBride
+*	Date - October 2026
+*
+*	This work is licensed under the Creative Commons Attribution-ShareAlike 4.0 International License.
+*	To view a copy of this license, visit http://creativecommons.org/licenses/by-sa/4.0/.
+*
+*	Website - http://www.openbionics.com/
+*	GitHub - https://github.com/Open-Bionics
+*	Email - ollymcbride@openbionics.com
+*
+*	Utils_SAMD.cpp
+*
+*/
+
+// SAMD21 USB set up for the serial utils.
+
+#include <Arduino.h>
+
+#if defined(ARDUINO_ARCH_SAMD)
+
+#include "Utils.h"
+
+#if !defined(CDC_ENDPOINT_IN)
+#define CDC_ENDPOINT_IN		3		// CDC data IN endpoint of the SAMD core (USBDesc.h)
+#endif
+
+#define USB_PACKET_SIZE		63		// bytes, largest write that fits a single USB packet (EPX_SIZE - 1)
+
+// returns true if 'len' bytes (up to a USB packet) can be written without waiting for the PC
+bool serialTxReady(int len)
+{
+#if defined(SERIAL_PINS_CONTROL) || defined(SERIAL_JACK_CONTROL)
+	return (MYSERIAL.availableForWrite() >= len);
+#else
+	if (!SERIALNONBLOCKCHECK || (len > USB_PACKET_SIZE))
+	{
+		return false;
+	}
+
+	// SerialUSB.availableForWrite() is always a full packet, so check whether the PC has collected the previous
+	// packet. If it has not (bank 1 of the IN endpoint is still ready), write() waits for it, for up to the core timeout
+	return !USB->DEVICE.DeviceEndpoint[CDC_ENDPOINT_IN].EPSTATUS.bit.BK1RDY;
+#endif
+}
+
+#endif // ARDUINO_ARCH_SAMD